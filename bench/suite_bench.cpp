@@ -0,0 +1,242 @@
+//List benchmark suite
+// - Runs every List operation over the five implementations (SSLL, PSLL, SDAL, CDAL and CBL) with int, a 64-byte POD and std::string elements,
+//   at sizes from 10 up to 10M (as long as the elements fit in the memory budget below), under four access patterns: FIFO, LIFO,
+//   random positional and scan. The remaining queries (peeks, length...) and the teardown (clear) are measured too.
+// - Prints a JSON array with one record per list, element, size, pattern and operation: ns/op, allocations/op (calls to the global operator new,
+//   which the lists reach through std::allocator) and the peak RSS in KiB since the list of that size was built.
+// - Every measurement stops after a time budget, so the O(n) operations on large lists stop after a few calls; "ops" says how many were timed.
+// - Usage: suite_bench [largest size] [milliseconds per measurement]
+//
+// by Iago Patiño López
+// Build from the repository root with: cmake -S . -B build && cmake --build build --target suite_bench
+// The target puts the five list directories on the include path.
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <streambuf>
+#include <string>
+#include <sys/resource.h>
+
+//List ADTs included below:
+#include "SSLL.h"
+#include "PSLL.h"
+#include "SDAL.h"
+#include "CDAL.h"
+#include "CBL.h"
+
+using namespace cop3530;
+
+//==============================================================================
+// allocation counting
+
+static std::size_t allocations = 0;
+
+void *operator new(std::size_t bytes) {
+    allocations++;
+    if (void *p = std::malloc(bytes == 0 ? 1 : bytes)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept {
+    std::free(p);
+}
+
+//==============================================================================
+// peak RSS
+
+void reset_peak_rss() { //Linux resets the high-water mark when 5 is written to clear_refs. Elsewhere the peak just keeps growing.
+    std::ofstream clear_refs("/proc/self/clear_refs");
+    if (clear_refs) clear_refs << "5";
+}
+
+long peak_rss_kb() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+        if (line.compare(0, 6, "VmHWM:") == 0) return std::atol(line.c_str() + 6);
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+//==============================================================================
+// elements
+
+struct pod64 {
+    long long value[8];
+};
+
+bool operator==(const pod64& a, const pod64& b) {
+    return std::memcmp(a.value, b.value, sizeof a.value) == 0;
+}
+
+std::ostream& operator<<(std::ostream& o, const pod64& p) {
+    return o << p.value[0];
+}
+
+template <typename E>
+E make_element(long i) {
+    return E(i);
+}
+
+template <>
+pod64 make_element<pod64>(long i) {
+    pod64 p;
+    for (int k = 0; k < 8; k++)
+        p.value[k] = i + k;
+    return p;
+}
+
+template <>
+std::string make_element<std::string>(long i) {
+    return std::string(32, char('a' + i % 26)); //Long enough to live on the heap
+}
+
+template <typename E>
+unsigned char touch(const E& e) { //Reads a byte of the element, so a returned copy has to be made (sizeof would not even call the function)
+    return *reinterpret_cast<const unsigned char *>(&e);
+}
+
+template <typename E>
+bool equals_function(const E& a, const E& b) {
+    return a == b;
+}
+
+struct null_buffer : std::streambuf { //print() writes here, so the suite times the traversal and formatting, not a terminal
+    int overflow(int c) override {
+        return c;
+    }
+};
+
+//==============================================================================
+// measurement
+
+long const element_budget = 256L << 20; //Sizes whose elements alone would take more bytes than this are skipped
+long largest_size = 10000000;
+double budget_ns = 50e6;
+bool first_record = true;
+
+std::size_t random_position(std::size_t length) { //xorshift: cheap and the same sequence on every run
+    static unsigned state = 2463534242u;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state % length;
+}
+
+struct measurement {
+    long ops;
+    double ns;
+    std::size_t allocations;
+};
+
+//Runs op (which performs calls_per_op List calls) until max_ops calls or, if bounded, the time budget, whichever comes first.
+
+template <typename Op>
+measurement measure(long max_ops, int calls_per_op, Op op, bool bounded = true) {
+    std::size_t const before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    long done = 0;
+    double elapsed = 0;
+    do {
+        op();
+        done += calls_per_op;
+        if (done < 64 || done % 64 < calls_per_op) //Past the first calls, reading the clock every time would cost as much as the cheapest operations
+            elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    } while (done < max_ops && (elapsed < budget_ns || !bounded));
+    measurement m;
+    m.ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    m.ops = done;
+    m.allocations = allocations - before;
+    return m;
+}
+
+void report(const char *list, const char *element, long size, const char *pattern, const char *operation, const measurement& m) {
+    std::printf("%s  {\"list\": \"%s\", \"element\": \"%s\", \"size\": %ld, \"pattern\": \"%s\", \"op\": \"%s\", \"ops\": %ld, \"ns_per_op\": %.2f, \"allocations_per_op\": %.4f, \"peak_rss_kb\": %ld}",
+            first_record ? "" : ",\n", list, element, size, pattern, operation, m.ops, m.ns / m.ops, double(m.allocations) / m.ops, peak_rss_kb());
+    std::fflush(stdout);
+    first_record = false;
+}
+
+//==============================================================================
+// workloads
+
+template <typename List, typename E>
+void run(const char *name, const char *element, long size) {
+    volatile std::size_t sink = 0; //Keeps the compiler from discarding the measured calls
+    long const repeat = size < 100000 ? 100000 : size; //Enough calls for the cheap operations to average out
+    reset_peak_rss();
+    List *list = new List;
+    long built = 0;
+    report(name, element, size, "build", "push_back", measure(size, 1, [&]() { list->push_back(make_element<E>(built++)); }, false)); //The list must reach its size
+    E const fresh = make_element<E>(7);
+    E const absent = make_element<E>(-1);
+
+    report(name, element, size, "fifo", "push_back+pop_front", measure(repeat, 2, [&]() {
+        list->push_back(fresh);
+        list->pop_front();
+    }));
+    report(name, element, size, "lifo", "push_back+pop_back", measure(repeat, 2, [&]() {
+        list->push_back(fresh);
+        list->pop_back();
+    }));
+    report(name, element, size, "lifo", "push_front+pop_front", measure(repeat, 2, [&]() {
+        list->push_front(fresh);
+        list->pop_front();
+    }));
+
+    report(name, element, size, "random", "item_at", measure(repeat, 1, [&]() { sink = sink + touch(list->item_at(int(random_position(size)))); }));
+    report(name, element, size, "random", "replace", measure(repeat, 1, [&]() { list->replace(fresh, int(random_position(size))); }));
+    report(name, element, size, "random", "insert+remove", measure(repeat, 2, [&]() {
+        list->insert(fresh, int(random_position(size + 1)));
+        list->remove(int(random_position(size + 1)));
+    }));
+
+    report(name, element, size, "scan", "contains", measure(repeat, 1, [&]() { sink = sink + list->contains(absent, equals_function<E>); }));
+    report(name, element, size, "scan", "contents", measure(repeat, 1, [&]() {
+        E *copy = list->contents();
+        sink = sink + touch(copy[0]);
+        delete[] copy;
+    }));
+    null_buffer discard;
+    std::ostream out(&discard);
+    report(name, element, size, "scan", "print", measure(repeat, 1, [&]() { list->print(out); }));
+
+    report(name, element, size, "query", "peek_front+peek_back", measure(repeat, 2, [&]() { sink = sink + touch(list->peek_front()) + touch(list->peek_back()); }));
+    report(name, element, size, "query", "length+is_empty+is_full", measure(repeat, 3, [&]() { sink = sink + list->length() + list->is_empty() + list->is_full(); }));
+
+    report(name, element, size, "teardown", "clear", measure(1, 1, [&]() { list->clear(); }));
+    delete list;
+}
+
+template <typename E>
+void run_all(const char *element) {
+    for (long size = 10; size <= largest_size; size *= 10) {
+        if (size * long(sizeof (E)) > element_budget) break;
+        run<SSLL<E>, E>("ssll", element, size);
+        run<PSLL<E>, E>("psll", element, size);
+        run<SDAL<E>, E>("sdal", element, size);
+        run<CDAL<E>, E>("cdal", element, size);
+        run<CBL<E>, E>("cbl", element, size);
+    }
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) largest_size = std::atol(argv[1]);
+    if (argc > 2) budget_ns = std::atof(argv[2]) * 1e6;
+    std::printf("[\n");
+    run_all<int>("int");
+    run_all<pod64>("pod64");
+    run_all<std::string>("string");
+    std::printf("\n]\n");
+    return 0;
+}
@@ -0,0 +1,158 @@
+//Trace replayer
+// - Replays a trace recorded with recording_list (see Trace.h) against SSLL, PSLL, SDAL, CDAL and CBL of ints, or just the one named,
+//   and prints, as a JSON array, a latency histogram summary per list and operation: calls, calls that threw, mean, p50, p90, p99, p99.9 and max in ns.
+//   Every latency includes reading the clock once, a few tens of ns.
+//   The trace is streamed, so its length is only limited by the disk. Each list is first filled to the length it had when recording started.
+//   Elements are not in the trace: the list holds 0, 1, 2... and contains() looks for an absent element, so every call scans the whole list.
+// - Usage: trace_replay <trace> [ssll|psll|sdal|cdal|cbl]
+//          trace_replay --generate <trace> <calls>    records a synthetic mix (mostly FIFO, some positional calls and scans) to try the replayer on
+//
+// by Iago Patiño López
+// Build from the repository root with: cmake -S . -B build && cmake --build build --target trace_replay
+// The target puts the five list directories on the include path.
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <streambuf>
+
+//List ADTs included below:
+#include "SSLL.h"
+#include "PSLL.h"
+#include "SDAL.h"
+#include "CDAL.h"
+#include "CBL.h"
+#include "Trace.h"
+
+using namespace cop3530;
+
+bool equals_function(const int& a, const int& b) {
+    return a == b;
+}
+
+struct null_buffer : std::streambuf { //print() writes here
+    int overflow(int c) override {
+        return c;
+    }
+};
+
+bool first_record = true;
+
+//Makes the recorded call on the list. Returns something derived from the result so the compiler cannot drop the call.
+
+template <typename L>
+long call(L& list, const trace_record& record, int& next_element, std::ostream& out) {
+    switch (record.op) {
+        case trace_op::insert: list.insert(next_element++, record.position);
+            return 0;
+        case trace_op::push_back: list.push_back(next_element++);
+            return 0;
+        case trace_op::push_front: list.push_front(next_element++);
+            return 0;
+        case trace_op::replace: return list.replace(next_element++, record.position);
+        case trace_op::remove: return list.remove(record.position);
+        case trace_op::pop_back: return list.pop_back();
+        case trace_op::pop_front: return list.pop_front();
+        case trace_op::item_at: return list.item_at(record.position);
+        case trace_op::peek_back: return list.peek_back();
+        case trace_op::peek_front: return list.peek_front();
+        case trace_op::is_empty: return list.is_empty();
+        case trace_op::is_full: return list.is_full();
+        case trace_op::length: return long(list.length());
+        case trace_op::clear: list.clear();
+            return 0;
+        case trace_op::contains: return list.contains(-1, equals_function);
+        case trace_op::print: list.print(out);
+            return 0;
+        case trace_op::contents:
+        {
+            int *copy = list.contents();
+            long first = list.is_empty() ? 0 : copy[0];
+            delete[] copy;
+            return first;
+        }
+    }
+    return 0;
+}
+
+template <typename L>
+void replay(const char *name, const char *path) {
+    volatile long sink = 0; //Keeps the compiler from discarding the replayed calls
+    latency_histogram latencies[trace_op_count];
+    unsigned long errors[trace_op_count] = {};
+    trace_reader trace(path);
+    L list;
+    int next_element = 0;
+    for (std::size_t i = 0; i < trace.initial_length(); i++)
+        list.push_back(next_element++);
+    null_buffer discard;
+    std::ostream out(&discard);
+
+    trace_record record;
+    while (trace.next(record)) {
+        auto start = std::chrono::steady_clock::now();
+        try {
+            sink = sink + call(list, record, next_element, out);
+        } catch (std::runtime_error&) { //The call threw when it was recorded too (an empty list, a position out of range)
+            errors[std::size_t(record.op)]++;
+        }
+        latencies[std::size_t(record.op)].record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    for (std::size_t op = 0; op < trace_op_count; op++) {
+        const latency_histogram& h = latencies[op];
+        if (h.count() == 0) continue;
+        std::printf("%s  {\"list\": \"%s\", \"op\": \"%s\", \"calls\": %llu, \"errors\": %lu, \"mean_ns\": %.1f, \"p50_ns\": %llu, \"p90_ns\": %llu, \"p99_ns\": %llu, \"p999_ns\": %llu, \"max_ns\": %llu}",
+                first_record ? "" : ",\n", name, trace_op_name(trace_op(op)), (unsigned long long) h.count(), errors[op], h.mean(),
+                (unsigned long long) h.percentile(50), (unsigned long long) h.percentile(90), (unsigned long long) h.percentile(99),
+                (unsigned long long) h.percentile(99.9), (unsigned long long) h.max());
+        first_record = false;
+    }
+}
+
+void generate(const char *path, long calls) {
+    virtual_list<SSLL<int> > list;
+    for (int i = 0; i < 1000; i++)
+        list.push_back(i);
+    trace_writer trace(path, list.length());
+    recording_list<int> recorded(list, trace);
+    unsigned state = 2463534242u; //xorshift
+    for (long i = 0; i < calls; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        unsigned const dice = state % 100;
+        int const position = int(state / 100 % (list.length() + 1)); //Asking list, not recorded, keeps these calls out of the trace
+        if (dice < 45) recorded.push_back(int(i));
+        else if (dice < 90) list.is_empty() ? recorded.push_back(int(i)) : (void) recorded.pop_front();
+        else if (dice < 95) recorded.item_at(position < int(list.length()) ? position : 0);
+        else if (dice < 97) recorded.insert(int(i), position);
+        else if (dice < 99) recorded.peek_front();
+        else recorded.contains(-1, equals_function);
+    }
+    trace.flush();
+    std::cerr << trace.records() << " calls recorded" << std::endl;
+}
+
+int main(int argc, char **argv) {
+    if (argc == 4 && std::strcmp(argv[1], "--generate") == 0) {
+        generate(argv[2], std::atol(argv[3]));
+        return 0;
+    }
+    if (argc < 2) {
+        std::cerr << "usage: trace_replay <trace> [ssll|psll|sdal|cdal|cbl]" << std::endl;
+        std::cerr << "       trace_replay --generate <trace> <calls>" << std::endl;
+        return 1;
+    }
+    const char *only = argc > 2 ? argv[2] : nullptr;
+    std::printf("[\n");
+    if (!only || std::strcmp(only, "ssll") == 0) replay<SSLL<int> >("ssll", argv[1]);
+    if (!only || std::strcmp(only, "psll") == 0) replay<PSLL<int> >("psll", argv[1]);
+    if (!only || std::strcmp(only, "sdal") == 0) replay<SDAL<int> >("sdal", argv[1]);
+    if (!only || std::strcmp(only, "cdal") == 0) replay<CDAL<int> >("cdal", argv[1]);
+    if (!only || std::strcmp(only, "cbl") == 0) replay<CBL<int> >("cbl", argv[1]);
+    std::printf("\n]\n");
+    return 0;
+}
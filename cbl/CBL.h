@@ -6,19 +6,100 @@
 // and deallocate the original one.
 // Because we don't want the list to waste too much memory, whenever the array's size is ≥ twice the starting capacity and fewer than half the slots are used, 
 // allocate a new array 75% the size of the current array, copy the items over to the new array, deallocate the current array, and use the new array as the backing store.
+// The sizes, and how an index is wrapped around the end of the array, come from the capacity policy (the second template parameter):
+// half_growth_policy is the behaviour described above, while power_of_two_policy keeps the array at a power of two so that wrapping an index is a single bitwise AND.
+// The backing array, and the elements in every one of its slots, go through the Allocator template parameter following std::allocator_traits.
+// Iterators wrap around the end of the array, view() hands out the elements in place as (at most) two contiguous spans, and copy_to() copies them out without allocating.
+// find(), count(), min(), max() and sum() run the SIMD kernels of Kernels.h over each of the (at most two) contiguous segments that hold the elements.
+// With incremental_growth as the fourth template parameter, a full array is not replaced in one go: push_back allocates the larger array and that push and
+// the following ones (and pop_front) move a few elements each, so push_back and pop_front, the queue operations, are O(1) in the worst case.
+// item_at(), replace() and the peeks look in whichever array holds the position; every other operation that touches the elements first moves what is left.
+// That includes the const begin(), end() and view(), so, while the list is growing, concurrent const readers need a lock like any writer would.
+// on_resize() reports every grow and shrink of the array, with its wall time, to a callback.
+// Built with COP3530_INSTRUMENT, stats() reports the elements written and shifted, the calls to the allocator and every resize with the bytes it moved.
 // by Iago Patiño López
 // with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
 
 #ifndef CBAL_H
 #define CBAL_H
+#include <algorithm>
+#include <cstddef>
+#include <memory>
 #include <stdexcept>
 #include <iostream>
+#include <iterator>
+#include <type_traits>
+#include <utility>
 #include "List.h"
+#include "Kernels.h"
 
 namespace cop3530 {
 
-    template <typename E>
-    class CBL : public List<E> { //We need to create the list class
+    //==============================================================================
+    // capacity policies
+
+    //Grows the array by 50% and shrinks it to 75%, as described above. Indices are wrapped with a compare and subtract.
+
+    struct half_growth_policy {
+        static std::size_t initial_size(std::size_t requested) {
+            return requested < 2 ? 2 : requested; //One slot always stays free, so we need at least two
+        }
+
+        static std::size_t grown_size(std::size_t size) {
+            return size + (size + 1) / 2;
+        }
+
+        static std::size_t shrunk_size(std::size_t size) {
+            return size * 0.75;
+        }
+
+        static std::size_t wrap(std::size_t index, std::size_t size) { //index must be smaller than 2 * size
+            return index >= size ? index - size : index;
+        }
+    };
+
+    //Keeps the array at a power of two: it doubles and halves, and indices are wrapped with index & (size - 1), without branching.
+
+    struct power_of_two_policy {
+        static std::size_t initial_size(std::size_t requested) {
+            std::size_t size = 2;
+            while (size < requested)
+                size *= 2;
+            return size;
+        }
+
+        static std::size_t grown_size(std::size_t size) {
+            return size * 2;
+        }
+
+        static std::size_t shrunk_size(std::size_t size) {
+            return size / 2;
+        }
+
+        static std::size_t wrap(std::size_t index, std::size_t size) {
+            return index & (size - 1);
+        }
+    };
+
+    //The live contents of a CBL without copying them: first runs from the head towards the end of the array and second, which is empty unless the
+    //contents wrap, from the start of the array up to the tail. Together they hold the elements in order, ready for writev() or memcpy().
+
+    template <typename T>
+    struct ring_view {
+        span<T> first;
+        span<T> second;
+
+        std::size_t size() const {
+            return first.size() + second.size();
+        }
+
+        bool empty() const {
+            return first.empty();
+        }
+    };
+
+    template <typename E, typename Policy = half_growth_policy, typename Allocator = std::allocator<E>, typename Growth = all_at_once_growth>
+    class CBL : public static_list<CBL<E, Policy, Allocator, Growth>, E> { //We need to create the list class
 
     public:
 
@@ -26,64 +107,132 @@ namespace cop3530 {
         class CBAL_Iter {
         public:
             // type aliases required for C++ iterator compatibility
-            using value_type = T;
+            using value_type = typename std::remove_const<T>::type;
             using reference = T&;
             using pointer = T*;
             using difference_type = std::ptrdiff_t;
-            using iterator_category = std::forward_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
 
             // type aliases for prettier code
             using self_type = CBAL_Iter;
             using self_reference = CBAL_Iter&;
 
         private:
-            E* here; //This is the pointer the the list member the iterator is pointing at
+            //The iterator remembers where the list starts and how far from the head it is, and wraps that around the end of the array
+            //with the capacity policy on every access, so walking past the last slot of the array continues at slot 0.
+            T* array; //This is the backing array of the list the iterator walks
+            size_t slots; //The size of that array
+            size_t head; //The index of the list's head in that array
+            difference_type position; //How many elements past the head the iterator is
+
+            template <typename U>
+            friend class CBAL_Iter;
 
         public:
 
-            explicit CBAL_Iter(E *start = nullptr) : here(start) { //This is the explicit constructor for the iterator class. It does not allow implicit conversions or copy-initialization.
+            CBAL_Iter() : array(nullptr), slots(0), head(0), position(0) {
+            }
+
+            CBAL_Iter(T *array, size_t slots, size_t head, difference_type position) : array(array), slots(slots), head(head), position(position) {
             }
 
-            CBAL_Iter(const CBAL_Iter& src) : here(src.here) { //This is the regular constructor for the iterator class
+            CBAL_Iter(const CBAL_Iter& src) : array(src.array), slots(src.slots), head(src.head), position(src.position) { //This is the regular constructor for the iterator class
+            }
+
+            template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+            CBAL_Iter(const CBAL_Iter<U>& src) : array(src.array), slots(src.slots), head(src.head), position(src.position) { //An iterator converts to a const_iterator
             }
 
             reference operator*() const {
-                return *here; //temporary line
+                return array[Policy::wrap(head + position, slots)];
             }
 
             pointer operator->() const {
-                T *temp = here;
-                return temp;
+                return &array[Policy::wrap(head + position, slots)];
+            }
+
+            reference operator[](difference_type n) const {
+                return array[Policy::wrap(head + position + n, slots)];
             }
 
             self_reference operator=(CBAL_Iter<T> const& src) {
-                here = CBAL_Iter(src).here;
+                array = src.array;
+                slots = src.slots;
+                head = src.head;
+                position = src.position;
                 return *this;
             }
 
             self_reference operator++() { //Returns the modified iterator
-                here++;
+                position++;
                 return *this;
             } // preincrement
 
             self_type operator++(int) {
                 CBAL_Iter temp(*this);
-                here++;
+                position++;
                 return temp;
             } // postincrement
 
-            bool operator==(CBAL_Iter<T> const& rhs) const {
-                if (here == rhs.here)
-                    return true;
-                else
-                    return false;
+            self_reference operator--() {
+                position--;
+                return *this;
+            } // predecrement
+
+            self_type operator--(int) {
+                CBAL_Iter temp(*this);
+                position--;
+                return temp;
+            } // postdecrement
+
+            self_reference operator+=(difference_type n) {
+                position += n;
+                return *this;
+            }
+
+            self_reference operator-=(difference_type n) {
+                position -= n;
+                return *this;
+            }
+
+            self_type operator+(difference_type n) const {
+                return CBAL_Iter(array, slots, head, position + n);
+            }
+
+            friend self_type operator+(difference_type n, CBAL_Iter const& it) {
+                return CBAL_Iter(it.array, it.slots, it.head, it.position + n);
+            }
+
+            self_type operator-(difference_type n) const {
+                return CBAL_Iter(array, slots, head, position - n);
+            }
+
+            difference_type operator-(CBAL_Iter<T> const& rhs) const {
+                return position - rhs.position;
+            }
+
+            bool operator==(CBAL_Iter<T> const& rhs) const { //Iterators of the same list are compared by how far from the head they are
+                return position == rhs.position;
             }
 
             bool operator!=(CBAL_Iter<T> const& rhs) const {
-                if (here != rhs.here)
-                    return true;
-                else
-                    return false;
+                return position != rhs.position;
+            }
+
+            bool operator<(CBAL_Iter<T> const& rhs) const {
+                return position < rhs.position;
+            }
+
+            bool operator>(CBAL_Iter<T> const& rhs) const {
+                return position > rhs.position;
+            }
+
+            bool operator<=(CBAL_Iter<T> const& rhs) const {
+                return position <= rhs.position;
+            }
+
+            bool operator>=(CBAL_Iter<T> const& rhs) const {
+                return position >= rhs.position;
             }
 
         }; // end CBAL_Iter        
@@ -93,31 +242,38 @@ namespace cop3530 {
         using iterator = CBAL_Iter<E>; //When we use the word iterator, we mean the iterator class
         using const_iterator = CBAL_Iter<E const>;
 
+        using allocator_type = Allocator;
+
         //operations
-        CBL(int); //This is the constructor method with input 
+        CBL(int, const Allocator& allocator = Allocator()); //This is the constructor method with input 
         CBL(); //This is the constructor method without input
+        explicit CBL(const Allocator& allocator); //Constructs an empty list with the default 50 slots, taken from the given allocator
         CBL(const CBL& other); //copy constructor
         CBL(CBL&& other); //move constructor
         ~CBL(); //This is the destructor method of the singly linked list
 
         iterator begin() {
             if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
-            return CBAL_Iter<E>(&array[head]);
+            finish_migration();
+            return iterator(array, size, head, 0);
         }
 
         iterator end() {
             if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
-            return CBAL_Iter<E>(&array[tail]);
+            finish_migration();
+            return iterator(array, size, head, used());
         }
 
         const_iterator begin() const {
-            if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
-            return CBAL_Iter<E>(&array[head]);
+            if (head == tail) throw std::runtime_error("Sorry, but the list is empty");
+            finish_migration(); //Moving elements between the arrays leaves the list itself unchanged
+            return const_iterator(array, size, head, 0);
         }
 
         const_iterator end() const {
-            if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
-            return CBAL_Iter<E>(&array[tail]);
+            if (head == tail) throw std::runtime_error("Sorry, but the list is empty");
+            finish_migration();
+            return const_iterator(array, size, head, used());
         }
         CBL & operator=(const CBL & other);
         CBL & operator=(CBL&& other);
@@ -136,374 +292,484 @@ namespace cop3530 {
         size_t length(void); //Returns the number of elements in the list as a size_t
         void clear(void); //removes all elements from the list
         bool contains(E element, bool (*equals_function)(const E&, const E&)); //returns true IFF at least one of the elements of the list matches the specified element
+        template <typename Predicate>
+        int find_if(Predicate predicate); //Returns the position of the first element for which predicate(element) is true, or -1 if there is none
+        bool contains(const E& element); //returns true IFF at least one of the elements of the list is == to the specified element
+        template <typename Equals>
+        bool contains(const E& element, Equals equals); //returns true IFF equals(list element, element) holds for at least one of the elements. Any callable works, and the compiler can inline it.
+        int find(const E& element); //Returns the position of the first element == to the specified element, or -1. These five use the SIMD kernels of Kernels.h.
+        size_t count(const E& element); //Returns how many elements are == to the specified element
+        E min(void); //Returns the smallest element
+        E max(void); //Returns the largest element
+        typename sum_type<E>::type sum(void); //Returns the sum of the elements, added up in a wider type
         void print(std::ostream& o); //If the list is empty, inserts "<empty list>" into the ostream; otherwise, inserts, enclosed in square brackets, the list's elements, separated by commas, in sequential order 
 
         E * const contents(); //Allocates, initializes, and returns an array containing a copy of the list's elements in sequential order
+        template <typename OutputIt>
+        OutputIt copy_to(OutputIt out); //Writes the elements, in sequential order, through out (a caller's buffer, a back_inserter...) and returns it past the last one. Allocates nothing.
+        ring_view<E> view(); //Returns the elements as at most two contiguous spans, without copying them. Adding or removing elements invalidates the view.
+        ring_view<const E> view() const;
+
+        void swap(CBL& other); //Exchanges the contents of the two lists. The allocators are exchanged too if they propagate on swap; otherwise they must compare equal.
+        allocator_type get_allocator() const; //Returns a copy of the allocator
+        list_stats stats() const; //What the list's operations have done so far. All zeros unless built with COP3530_INSTRUMENT.
+        void on_resize(resize_listener listener, void *context = nullptr); //Calls listener(event, context) after every resize, see resize_event. nullptr stops it.
 
     private:
+        using traits = std::allocator_traits<Allocator>;
+        static constexpr bool incremental = std::is_same<Growth, incremental_growth>::value;
+        static constexpr size_t migration_step = 4; //Slots filled per operation while growing incrementally: enough to empty the old array before the new one fills
+
         void upsize(void);
         void adjust_size(void);
+        void resize(size_t new_size); //Copies the elements, in order, to the start of a new backing array of the given size
+        void copy_from(const CBL& other); //Allocates a backing array like other's and copies its elements into it
+        size_t wrap(size_t index) const; //Wraps an index that went past the end of the array back to its start
+        E& slot(size_t position); //Returns the slot that holds the given list position
+        E& at_index(size_t index); //Returns the slot at the given index of array or, while migrating, wherever its element still is
+        const E& at_index(size_t index) const;
+        bool no_free_slot(void) const; //Returns true IFF the next push would overwrite the head
+        std::ptrdiff_t used(void) const { //The number of elements, for the iterators
+            return std::ptrdiff_t(head <= tail ? tail - head : size - head + tail);
+        }
+        E *allocate_array(size_t slots); //Allocates a backing array and default-constructs every slot
+        void deallocate_array(E *slots, size_t count); //Destroys every slot and deallocates the array
+        void take_array(CBL& other); //Takes over the other list's array, which must have come from an equal allocator, and gives it a new empty one
+        void start_migration(void); //Incremental growth: allocates a larger array, uninitialized, and leaves the elements in the old one for migrate() to move
+        void migrate(size_t steps) const; //Moves up to steps elements out of the old array, then constructs the rest of the new slots, and deallocates the old array at the end
+        void finish_migration(void) const; //Completes the migration, so that every element and every slot is in array
         //variables
+        mutable Allocator allocator; //mutable, like the migration state below, so that the const begin(), end() and view() can finish a migration
         size_t size; //This is size of the backing array of the Circular Buffer List
         size_t original_size;
         E *array; //This is the backing array of the Circular Buffer List
-        int head; //The head data member gives you the index at which the head of the list it.
-        int tail; //The tail data member gives you the index after which the last element of the list is.
+        size_t head; //The head data member gives you the index at which the head of the list it.
+        size_t tail; //The tail data member gives you the index after which the last element of the list is.
+        mutable E *old_array; //Incremental growth: the array the elements are being moved out of, or nullptr
+        size_t old_size;
+        size_t old_head; //The element at index j of array (j in [migrated, old_end)) is still at old_array[wrap(old_head + j)]
+        mutable size_t migrated;
+        size_t old_end;
+        mutable size_t constructed_end; //Slots [old_end, constructed_end) of array hold an element; the ones after it have not been constructed yet
+        resize_notifier notifier; //See on_resize()
+#ifdef COP3530_INSTRUMENT
+        mutable list_stats instrumentation;
+#endif
     };
 
     //==============================================================================
     // ------- constructor  --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
-    CBL<E>::CBL(int input) {
-        size = input;
-        original_size = input;
-        array = new E[size];
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    CBL<E, Policy, Allocator, Growth>::CBL(int input, const Allocator& allocator) : allocator(allocator) {
+        size = Policy::initial_size(input);
+        original_size = size;
+        array = allocate_array(size);
         head = 0; //We start with an empty list, which be define as head==tail.  
         tail = 0;
+        old_array = nullptr;
     }
 
     //==============================================================================
     // ------- constructor 2 --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
-    CBL<E>::CBL() {
-        size = 50;
-        original_size = size;
-        array = new E[size];
-        head = 0;
-        tail = 0;
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    CBL<E, Policy, Allocator, Growth>::CBL() : CBL(50) {
+    }
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    CBL<E, Policy, Allocator, Growth>::CBL(const Allocator& allocator) : CBL(50, allocator) {
     }
 
     //==============================================================================
     // ------- copy constructor  --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
-    CBL<E>::CBL(const CBL& other) {
-        size = other.size;
-        original_size = other.original_size;
-        array = new E[size];
-        head = 0;
-
-        if (other.head > other.tail) {
-            int index_array = other.head; //Read old array starting at head
-            int index_new_array = 0; //Write new array starting at 0
-            while (index_array < other.size)//Copy from head to the end of the old array
-                array[index_new_array++] = other.array[index_array++];
-            if (other.tail > 0) index_array = 0;
-            while (index_array < other.tail) {//Copy from the beginning of the old array to the tail 
-                array[index_new_array++] = other.array[index_array++];
-            }
-            tail = index_new_array;
-
-        } else { //If our list does not circle the array
-            int index_array = other.head; //Read old array starting at head
-            int index_new_array = 0; //Write new array starting at 0
-            while (index_array < other.tail)
-                array[index_new_array++] = other.array[index_array++];
-            tail = index_new_array;
-        }
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    CBL<E, Policy, Allocator, Growth>::CBL(const CBL& other) : allocator(traits::select_on_container_copy_construction(other.allocator)) {
+        copy_from(other);
     }
 
     //==============================================================================
     // ------- copy-assignment operator 
 
-    template <typename E>
-    CBL<E> &
-    CBL<E>::operator=(const CBL & other) {
-        size = other.size;
-        original_size = other.original_size;
-        array = new E[size];
-        head = 0;
-
-        if (other.head > other.tail) {
-            int index_array = other.head; //Read old array starting at head
-            int index_new_array = 0; //Write new array starting at 0
-            while (index_array < other.size)//Copy from head to the end of the old array
-                array[index_new_array++] = other.array[index_array++];
-            if (other.tail > 0) index_array = 0;
-            while (index_array < other.tail) {//Copy from the beginning of the old array to the tail 
-                array[index_new_array++] = other.array[index_array++];
-            }
-            tail = index_new_array;
-
-        } else { //If our list does not circle the array
-            int index_array = other.head; //Read old array starting at head
-            int index_new_array = 0; //Write new array starting at 0
-            while (index_array < other.tail)
-                array[index_new_array++] = other.array[index_array++];
-            tail = index_new_array;
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    CBL<E, Policy, Allocator, Growth> &
+    CBL<E, Policy, Allocator, Growth>::operator=(const CBL & other) {
+        if (this != &other) {
+            finish_migration();
+            deallocate_array(array, size); //With the allocator it came from, before that may be replaced
+            assign_allocator(allocator, other.allocator, typename traits::propagate_on_container_copy_assignment());
+            copy_from(other);
         }
-
         return *this;
     }
 
     // ------  move constructor
 
-    template <typename E>
-    CBL<E>::CBL(CBL&& other) {
-        array = other.array;
-        size = other.size;
-        original_size = other.original_size;
-        head = other.head;
-        tail = other.tail;
-
-        other.size = 50;
-        other.original_size = other.size;
-        other.array = new E[size];
-        other.head = 0;
-        other.tail = 0;
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    CBL<E, Policy, Allocator, Growth>::CBL(CBL&& other) : allocator(other.allocator) {
+        other.finish_migration();
+        take_array(other);
     }
     // ------- move assignment operator 
 
-    template <typename E>
-    CBL<E> &
-    CBL<E>::operator=(CBL&& other) {
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    CBL<E, Policy, Allocator, Growth> &
+    CBL<E, Policy, Allocator, Growth>::operator=(CBL&& other) {
         if (this != &other) {
+            finish_migration();
+            other.finish_migration();
+            if (traits::propagate_on_container_move_assignment::value || allocator == other.allocator) {
+                deallocate_array(array, size);
+                move_allocator(allocator, other.allocator, typename traits::propagate_on_container_move_assignment());
+                take_array(other);
+            } else { //Our allocator cannot free the other list's array, so the elements are moved into an array of our own
+                clear();
+                for (size_t index = other.head; index != other.tail; index = other.wrap(index + 1))
+                    push_back(std::move(other.array[index]));
+                other.clear();
+            }
+        }
+        return *this;
+    }
+    // ------  destructor --------------------------------------------------------------------------------- IT WORKS
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    CBL<E, Policy, Allocator, Growth>::~CBL() {
+        finish_migration();
+        deallocate_array(array, size);
+    }
+
+    //==============================================================================
+    // --------- allocate_array()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    E *
+    CBL<E, Policy, Allocator, Growth>::allocate_array(size_t slots) {
+        E *result = traits::allocate(allocator, slots);
+        size_t constructed = 0;
+        try {
+            for (; constructed < slots; constructed++) //Like new E[slots], every slot holds an element, used or not
+                traits::construct(allocator, &result[constructed]);
+        } catch (...) {
+            while (constructed > 0)
+                traits::destroy(allocator, &result[--constructed]);
+            traits::deallocate(allocator, result, slots);
+            throw;
+        }
+        COP3530_COUNT(allocations, 1);
+        return result;
+    }
+
+    //==============================================================================
+    // --------- deallocate_array()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    void
+    CBL<E, Policy, Allocator, Growth>::deallocate_array(E *slots, size_t count) {
+        for (size_t i = 0; i < count; i++)
+            traits::destroy(allocator, &slots[i]);
+        traits::deallocate(allocator, slots, count);
+        COP3530_COUNT(frees, 1);
+    }
+
+    //==============================================================================
+    // --------- take_array()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    void
+    CBL<E, Policy, Allocator, Growth>::take_array(CBL& other) { //other must not be in the middle of a migration
         array = other.array;
+        old_array = nullptr;
         size = other.size;
         original_size = other.original_size;
         head = other.head;
         tail = other.tail;
 
-        other.size = 50;
+        other.size = Policy::initial_size(50);
         other.original_size = other.size;
-        other.array = new E[size];
+        other.array = other.allocate_array(other.size);
         other.head = 0;
         other.tail = 0;
-        }
-        return *this;
     }
-    // ------  destructor --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
-    CBL<E>::~CBL() {
-        delete [] array;
+    //==============================================================================
+    // operations
+
+    //==============================================================================
+    // --------- wrap()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    size_t
+    CBL<E, Policy, Allocator, Growth>::wrap(size_t index) const {
+        return Policy::wrap(index, size);
     }
 
     //==============================================================================
-    // operations
+    // --------- slot()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    E&
+    CBL<E, Policy, Allocator, Growth>::slot(size_t position) {
+        return at_index(wrap(head + position));
+    }
 
     //==============================================================================
-    // --------- upsize() --------------------------------------------------------------------------------- IT WORKS
+    // --------- at_index()
 
-    template <typename E>
-    void
-    CBL<E>::upsize() { //We use this to increase our backing array size by 50&
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    E&
+    CBL<E, Policy, Allocator, Growth>::at_index(size_t index) {
+        if (incremental && old_array != nullptr && index >= migrated && index < old_end) return old_array[Policy::wrap(old_head + index, old_size)];
+        return array[index];
+    }
 
-        size_t new_array_size = size * 1.5; //The new array has to be 150% of the previous array
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    const E&
+    CBL<E, Policy, Allocator, Growth>::at_index(size_t index) const {
+        if (incremental && old_array != nullptr && index >= migrated && index < old_end) return old_array[Policy::wrap(old_head + index, old_size)];
+        return array[index];
+    }
 
-        E *new_array = new E[new_array_size]; //Create new bigger array
-        //If our list circles the array
-        if (head > tail) {
+    //==============================================================================
+    // --------- no_free_slot()
 
-            int index_array = head; //Read old array starting at head
-            int index_new_array = 0; //Write new array starting at 0
-            while (index_array < size)//Copy from head to the end of the old array
-                new_array[index_new_array++] = array[index_array++];
-            if (tail > 0) index_array = 0;
-            while (index_array < tail) {//Copy from the beginning of the old array to the tail 
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    bool
+    CBL<E, Policy, Allocator, Growth>::no_free_slot() const {
+        return wrap(tail + 1) == head; //One slot always stays free so that a full list can be told apart from an empty one
+    }
 
-                new_array[index_new_array++] = array[index_array++];
-            }
-            this->tail = index_new_array;
-            this->head = 0;
-            delete array;
-            array = new_array;
-            size = new_array_size;
-            return;
-        }
+    //==============================================================================
+    // --------- copy_from()
 
-        //If our list does not circle the array
-        int index_array = head;
-        int index_new_array = 0;
-        while (index_array < tail)
-            new_array[index_new_array++] = array[index_array++];
-        tail = index_array;
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    void
+    CBL<E, Policy, Allocator, Growth>::copy_from(const CBL& other) {
+        size = other.size;
+        original_size = other.original_size;
+        array = allocate_array(size);
+        old_array = nullptr;
         head = 0;
-        delete array;
+        tail = 0;
+        for (size_t index = other.head; index != other.tail; index = other.wrap(index + 1)) //Read old array starting at head, write new array starting at 0
+            array[tail++] = other.at_index(index); //other may still be moving elements out of its old array
+    }
+
+    //==============================================================================
+    // --------- resize()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    void
+    CBL<E, Policy, Allocator, Growth>::resize(size_t new_array_size) {
+        resize_notifier::clock::time_point const started = notifier.start();
+        size_t const old_size = size;
+        E *new_array = allocate_array(new_array_size);
+        size_t index_new_array = 0;
+        for (size_t index_array = head; index_array != tail; index_array = wrap(index_array + 1)) //Copy from head to tail, following the circle
+            new_array[index_new_array++] = array[index_array];
+        deallocate_array(array, size);
         array = new_array;
         size = new_array_size;
+        head = 0;
+        tail = index_new_array;
+        notifier.finish(started, old_size, new_array_size, index_new_array, index_new_array * sizeof (E));
+        COP3530_COUNT(resizes, 1);
+        COP3530_COUNT(moves, index_new_array);
+        COP3530_COUNT(resize_bytes, index_new_array * sizeof (E));
+    }
+
+    //==============================================================================
+    // --------- upsize() --------------------------------------------------------------------------------- IT WORKS
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    void
+    CBL<E, Policy, Allocator, Growth>::upsize() { //We use this to increase our backing array size by 50&
+        resize(Policy::grown_size(size));
+    }
+
+    //==============================================================================
+    // --------- start_migration()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    void
+    CBL<E, Policy, Allocator, Growth>::start_migration() {
+        finish_migration(); //Only if the new array filled up before the old one was emptied, which migration_step is chosen to prevent
+        resize_notifier::clock::time_point const started = notifier.start();
+        size_t const count = length();
+        size_t const new_size = Policy::grown_size(size);
+        old_array = array;
+        old_size = size;
+        old_head = head;
+        migrated = 0;
+        old_end = count;
+        constructed_end = count;
+        array = traits::allocate(allocator, new_size); //Unlike allocate_array(), this constructs nothing, so it takes about as long whatever the length
+        COP3530_COUNT(allocations, 1);
+        size = new_size;
+        head = 0; //The elements keep their order and start at index 0, as resize() leaves them
+        tail = count;
+        COP3530_COUNT(resizes, 1);
+        notifier.finish(started, old_size, new_size, count, 0); //Nothing has moved yet: migrate() moves the elements a few at a time
+    }
+
+    //==============================================================================
+    // --------- migrate()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    void
+    CBL<E, Policy, Allocator, Growth>::migrate(size_t steps) const {
+        for (; steps > 0 && migrated < old_end; steps--, migrated++) {
+            E& from = old_array[Policy::wrap(old_head + migrated, old_size)];
+            traits::construct(allocator, &array[migrated], std::move_if_noexcept(from));
+            traits::destroy(allocator, &from);
+            COP3530_COUNT(moves, 1);
+            COP3530_COUNT(resize_bytes, sizeof (E));
+        }
+        for (; steps > 0 && constructed_end < size; steps--) //Every slot holds an element, used or not, as allocate_array() leaves them
+            traits::construct(allocator, &array[constructed_end++]);
+        if (migrated == old_end && constructed_end == size) {
+            for (size_t j = old_end; j < old_size; j++) //The old slots that held no element
+                traits::destroy(allocator, &old_array[Policy::wrap(old_head + j, old_size)]);
+            traits::deallocate(allocator, old_array, old_size);
+            COP3530_COUNT(frees, 1);
+            old_array = nullptr;
+        }
+    }
+
+    //==============================================================================
+    // --------- finish_migration()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    void
+    CBL<E, Policy, Allocator, Growth>::finish_migration() const {
+        if (incremental && old_array != nullptr) migrate(size);
     }
 
     //==============================================================================
     // --------- adjust_size() ----------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     void
-    CBL<E>::adjust_size() {
+    CBL<E, Policy, Allocator, Growth>::adjust_size() {
+        if (incremental && old_array != nullptr) return; //Not halfway through growing
         if (size < 2 * original_size) return; //If the array's size is not larger than or equal to the original array the condition for downsizing is not met.
         if (this->length() >= size / 2) return; //If more than half of the slots in the backing array are being used, the condition for downsizing is not met.
 
         //Once the conditions have been met, we can downsize the array.
-        size_t new_array_size = size * 0.75;
-        E *new_array = new E[new_array_size];
-
-        //If our list circles the array
-        if (head > tail) {
-            int index_array = head;
-            int index_new_array = 0;
-            while (index_array < size)//Copy from head to the end of the array
-                new_array[index_new_array++] = array[index_array++];
-            index_array = 0;
-            while (index_array < tail)//Copy from the beginning of the array to the tail 
-                new_array[index_new_array++] = array[index_array++];
-            tail = index_array;
-            head = 0;
-            delete array;
-            array = new_array;
-            size = new_array_size;
-            return;
-        }
-        //If our list does not circle the array
-        int index_array = head;
-        int index_new_array = 0;
-        while (index_array < tail)
-            new_array[index_new_array++] = array[index_array++];
-        tail = index_array;
-        head = 0;
-        delete array;
-        array = new_array;
-        size = new_array_size;
+        resize(Policy::shrunk_size(size));
     }
 
     //==============================================================================
     // --------- insert() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     void
-    CBL<E>::insert(E element, int position) {
+    CBL<E, Policy, Allocator, Growth>::insert(E element, int position) {
         if (position > length() || position < 0) throw std::runtime_error("Sorry, you cannot insert outside the list boundaries");
-        if (position == length()){
-            this->push_back(element);
+        if (incremental && position == length()) { //Nothing needs to be shifted, so it can grow like push_back
+            push_back(std::move(element));
             return;
         }
-        else if (tail < size - 1 && tail + 1 != head) { //If there is space for increase
-            tail++;
-            size_t real_position = position + head;
-            if (real_position >= size)
-                real_position = real_position - size;
-            if (head < tail) { //If the array does not circle
-                for (int i = tail; i > real_position; i--)
-                    array[i] = array[i - 1];
-                array[real_position] = element;
-            } else if (head > tail && head < real_position) { //If the array circles but the insert position is after the head
-                for (int i = tail - 1; i >= 0; i--)
-                    array[i] = array[i - 1];
-                array[0] = array[size - 1];
-                for (int i = size - 1; i >= real_position; i--)
-                    array[i] = array[i - 1];
-                array[real_position] = element;
-            } else if (head > tail && head > real_position) { //If the array circles put the insert position is before the tail
-                for (int i = tail; i > real_position; i--)
-                    array[i] = array[i - 1];
-                array[real_position] = element;
-            }
-
-        } else { //If there is no space for increase
-            upsize();
-            insert(element, position); //Let's try again
-        }
+        finish_migration();
+        if (no_free_slot()) upsize();
+        size_t const len = length();
+        for (size_t i = len; i > position; i--) //Move every element from the insert position on one spot to the "right"
+            slot(i) = slot(i - 1);
+        slot(position) = element;
+        COP3530_COUNT(moves, len - position);
+        COP3530_COUNT(copies, 1);
+        tail = wrap(tail + 1);
     }
 
     //==============================================================================
     // --------- contents() --------------------------------------------------------------------------------- IT WORKS
 
 
-    template <typename E >
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     E * const
-    CBL<E>::contents() {
+    CBL<E, Policy, Allocator, Growth>::contents() {
+        finish_migration();
         E * const new_array = new E[length()];
-        if (head > tail) { //If the array circles
-            int index_array = head; //Read old array starting at head
-            int index_new_array = 0; //Write new array starting at 0
-            while (index_array < size)//Copy from head to the end of the old array
-                new_array[index_new_array++] = array[index_array++];
-            if (tail > 0) index_array = 0;
-            while (index_array < tail) {//Copy from the beginning of the old array to the tail 
-                new_array[index_new_array++] = array[index_array++];
-            }
-            return new_array;
-        }
-        //If our list does not circle the array
-        int index_array = head;
-        int index_new_array = 0;
-        while (index_array < tail)
-            new_array[index_new_array++] = array[index_array++];
+        size_t index_new_array = 0;
+        for (size_t index_array = head; index_array != tail; index_array = wrap(index_array + 1))
+            new_array[index_new_array++] = array[index_array];
         return new_array;
     }
 
 
+    //==============================================================================
+    // --------- copy_to()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    template <typename OutputIt>
+    OutputIt
+    CBL<E, Policy, Allocator, Growth>::copy_to(OutputIt out) {
+        ring_view<E> const segments = view();
+        out = std::copy(segments.first.begin(), segments.first.end(), out);
+        return std::copy(segments.second.begin(), segments.second.end(), out);
+    }
+
     //==============================================================================
     // --------- push_back() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     void
-    CBL<E>::push_back(E element) {
-        if (tail + 1 == head) this->upsize();
-        if (tail == size - 1 && head == 0) this->upsize();
-        array[tail++] = element;
-        if (tail >= size) tail = 0;
+    CBL<E, Policy, Allocator, Growth>::push_back(E element) {
+        if (no_free_slot()) incremental ? start_migration() : this->upsize();
+        if (incremental && old_array != nullptr && tail == constructed_end) { //A slot migrate() has not constructed yet
+            traits::construct(allocator, &array[tail], element);
+            constructed_end++;
+        } else {
+            array[tail] = element;
+        }
+        tail = wrap(tail + 1);
+        COP3530_COUNT(copies, 1);
+        if (incremental && old_array != nullptr) migrate(migration_step);
     }
 
     //==============================================================================
     // --------- push_front() ------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     void
-    CBL<E>::push_front(E element) {
-        if (tail + 1 == head) this->upsize();
-        if (tail == size - 1 && head == 0) this->upsize();
-        if (head == 0) head = size;
-        array[--head] = element;
+    CBL<E, Policy, Allocator, Growth>::push_front(E element) {
+        finish_migration(); //The slot before the head may not have been constructed yet
+        if (no_free_slot()) this->upsize();
+        head = wrap(head + size - 1);
+        array[head] = element;
+        COP3530_COUNT(copies, 1);
     }
 
     //==============================================================================
     // --------- replace() ---------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E >
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     E
-    CBL<E>::replace(E element, int position) {
-        if (position >= this->length() || this->is_empty()) throw std::runtime_error("Sorry, but that position is outside the list boundaries");
-        size_t real_position = position + head;
-        if (real_position >= size)
-            real_position = real_position - size;
-        E temp = array[real_position];
-        array[real_position] = element;
+    CBL<E, Policy, Allocator, Growth>::replace(E element, int position) {
+        if (position >= this->length() || position < 0) throw std::runtime_error("Sorry, but that position is outside the list boundaries");
+        E temp = slot(position);
+        slot(position) = element;
+        COP3530_COUNT(copies, 1);
         return temp;
     }
 
     //==============================================================================
     // --------- remove() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E >
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     E
-    CBL<E>::remove(int position) {
+    CBL<E, Policy, Allocator, Growth>::remove(int position) {
         if (position > length() - 1 || position < 0)
             throw std::runtime_error("Error from remove method: the position chosen is not in the list");
         if (position == 0) return this->pop_front();
-        size_t real_position = position + head;
-        if (real_position >= size)
-            real_position = real_position - size;
-        E removed = array[real_position];
-        //If our list does not circle the array
-        if (tail > head) {
-            for (int i = real_position; i < tail; i++)
-                array[i] = array[i + 1];
-            tail--;
-        }//If our list circles the array
-        else if (tail < head && head < real_position) {
-            for (int i = real_position; i < size - 1; i++)
-                array[i] = array[i + 1];
-            array[size - 1] = array[0];
-            for (int i = 0; i < tail - 1; i++)
-                array[i] = array[i + 1];
-            tail--;
-        } else if (tail < head && head > real_position) {
-            for (int i = real_position; i < tail - 1; i++)
-                array[i] = array[i + 1];
-            tail--;
-        }
+        finish_migration();
+        E removed = slot(position);
+        size_t const len = length();
+        for (size_t i = position; i < len - 1; i++) //Move every element after the removed one one spot to the "left"
+            slot(i) = slot(i + 1);
+        COP3530_COUNT(moves, len - 1 - position);
+        tail = wrap(tail + size - 1);
         this->adjust_size();
         return removed;
     }
@@ -511,15 +777,13 @@ namespace cop3530 {
     //==============================================================================
     // --------- pop_back() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E >
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     E
-    CBL<E>::pop_back() {
+    CBL<E, Policy, Allocator, Growth>::pop_back() {
         if (this->is_empty()) throw std::runtime_error("Sorry, but this list is empty");
-        E temp = array[--tail];
-        if (tail == -1) {
-            temp = array[size - 1];
-            tail = size - 1;
-        }
+        finish_migration();
+        tail = wrap(tail + size - 1);
+        E temp = array[tail];
         this->adjust_size();
         return temp;
     }
@@ -527,88 +791,81 @@ namespace cop3530 {
     //==============================================================================
     // --------- pop_front() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E >
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     E
-    CBL<E>::pop_front() {
+    CBL<E, Policy, Allocator, Growth>::pop_front() {
         if (this->is_empty()) throw std::runtime_error("Sorry, but this list is empty");
-        if (head == size - 1) {
-            E removed = array[head];
-            head = 0;
-            return removed;
-        }
-        E removed = array[head++];
+        if (incremental && old_array != nullptr) migrate(migration_step); //The head is never past migrated, so this moves it first if it is still in the old array
+        E removed = array[head];
+        head = wrap(head + 1);
+        this->adjust_size();
         return removed;
     }
 
     //==============================================================================
     // --------- item_at() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E >
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     E
-    CBL<E>::item_at(int position) {
-        if (position >= this->length() || this->is_empty()) throw std::runtime_error("Sorry, but that position is outside the list boundaries");
-        size_t real_position = position + head;
-        if (real_position >= size)
-            real_position = real_position - size;
-        return array[real_position];
+    CBL<E, Policy, Allocator, Growth>::item_at(int position) {
+        if (position >= this->length() || position < 0) throw std::runtime_error("Sorry, but that position is outside the list boundaries");
+        return slot(position);
     }
 
     //==============================================================================
     // --------- peek_back() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E >
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     E
-    CBL<E>::peek_back() {
+    CBL<E, Policy, Allocator, Growth>::peek_back() {
         if (is_empty()) throw std::runtime_error("This list is empty");
-        if (tail == 0) return array[size - 1];
-        return array[tail - 1];
+        return at_index(wrap(tail + size - 1));
     }
 
     //==============================================================================
     // --------- peek_front() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E >
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     E
-    CBL<E>::peek_front() {
+    CBL<E, Policy, Allocator, Growth>::peek_front() {
         if (is_empty()) throw std::runtime_error("This list is empty");
-        return array[head];
+        return at_index(head);
     }
 
     //==============================================================================
     // --------- is_empty() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     bool
-    CBL<E>::is_empty() {
+    CBL<E, Policy, Allocator, Growth>::is_empty() {
         return head == tail;
     }
 
     //==============================================================================
     // --------- is_full() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     bool
-    CBL<E>::is_full(void) {
+    CBL<E, Policy, Allocator, Growth>::is_full(void) {
         return false; //This list can have an infinite amount of nodes and therefore it always returns false 
     }
 
     //==============================================================================
     // --------- length() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E >
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     size_t
-    CBL<E>::length() {
-        if (is_empty()) return 0;
-        if (tail < head) return size - head + tail;
-        return tail - head;
+    CBL<E, Policy, Allocator, Growth>::length() {
+        return wrap(tail + size - head); //This also covers the case in which the list circles the array
     }
 
     //==============================================================================
     // --------- clear() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     void
-    CBL<E>::clear() {
+    CBL<E, Policy, Allocator, Growth>::clear() {
+        finish_migration(); //The slots at the start of array may not hold elements yet
         head = 0;
         tail = 0;
     }
@@ -616,66 +873,213 @@ namespace cop3530 {
     //==============================================================================
     // --------- contains() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     bool
-    CBL<E>::contains(E element, bool (*equals_function)(const E&, const E&)) {
-        if (is_empty()) return false;
-        //If our list circles the array
-        if (head > tail) {
-            int index = head;
-            while (index < size) //Examine from head to the end of the array
-                if (equals_function(array[index++], element)) return true;
-            index = 0;
-            while (index < tail) //Examine from the beginning of the array to the tail 
-                if (equals_function(array[index++], element)) return true;
-        }
-        //If our list does not circle the array
-        int index = head;
-        while (index < (tail))
-            if (equals_function(array[index++], element)) return true;
-        return false;
+    CBL<E, Policy, Allocator, Growth>::contains(E element, bool (*equals_function)(const E&, const E&)) {
+        return find_if([&](const E& datum) { return equals_function(datum, element); }) != -1;
+    }
+
+    //==============================================================================
+    // --------- find_if()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    template <typename Predicate>
+    int
+    CBL<E, Policy, Allocator, Growth>::find_if(Predicate predicate) {
+        finish_migration();
+        size_t const first_end = head <= tail ? tail : size; //The elements sit in [head, first_end) and, if the list wraps, in [0, tail)
+        for (size_t index = head; index < first_end; index++)
+            if (predicate(array[index])) return int(index - head);
+        if (head <= tail) return -1;
+        for (size_t index = 0; index < tail; index++)
+            if (predicate(array[index])) return int(size - head + index);
+        return -1;
+    }
+
+    //==============================================================================
+    // --------- contains() with ==
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    bool
+    CBL<E, Policy, Allocator, Growth>::contains(const E& element) {
+        return find(element) != -1;
+    }
+
+    //==============================================================================
+    // --------- contains() with any callable
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    template <typename Equals>
+    bool
+    CBL<E, Policy, Allocator, Growth>::contains(const E& element, Equals equals) {
+        return find_if([&](const E& datum) { return equals(datum, element); }) != -1;
+    }
+
+    //==============================================================================
+    // --------- find()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    int
+    CBL<E, Policy, Allocator, Growth>::find(const E& element) {
+        finish_migration();
+        size_t const first_end = head <= tail ? tail : size; //The elements sit in [head, first_end) and, if the list wraps, in [0, tail)
+        E const *found = simd_find<E>(array + head, array + first_end, element);
+        if (found != array + first_end) return int(found - (array + head));
+        if (head <= tail) return -1;
+        found = simd_find<E>(array, array + tail, element);
+        return found == array + tail ? -1 : int(size - head + (found - array));
+    }
+
+    //==============================================================================
+    // --------- count()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    size_t
+    CBL<E, Policy, Allocator, Growth>::count(const E& element) {
+        finish_migration();
+        if (head <= tail) return simd_count<E>(array + head, array + tail, element);
+        return simd_count<E>(array + head, array + size, element) + simd_count<E>(array, array + tail, element);
+    }
+
+    //==============================================================================
+    // --------- min()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    E
+    CBL<E, Policy, Allocator, Growth>::min() {
+        finish_migration();
+        if (is_empty()) throw std::runtime_error("Sorry, the list is empty");
+        if (head < tail) return simd_min<E>(array + head, array + tail);
+        E const first = simd_min<E>(array + head, array + size); //Wrapped: one result per segment
+        if (tail == 0) return first;
+        E const second = simd_min<E>(array, array + tail);
+        return second < first ? second : first;
+    }
+
+    //==============================================================================
+    // --------- max()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    E
+    CBL<E, Policy, Allocator, Growth>::max() {
+        finish_migration();
+        if (is_empty()) throw std::runtime_error("Sorry, the list is empty");
+        if (head < tail) return simd_max<E>(array + head, array + tail);
+        E const first = simd_max<E>(array + head, array + size);
+        if (tail == 0) return first;
+        E const second = simd_max<E>(array, array + tail);
+        return first < second ? second : first;
+    }
+
+    //==============================================================================
+    // --------- sum()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    typename sum_type<E>::type
+    CBL<E, Policy, Allocator, Growth>::sum() {
+        finish_migration();
+        if (head <= tail) return simd_sum<E>(array + head, array + tail);
+        return simd_sum<E>(array + head, array + size) + simd_sum<E>(array, array + tail);
     }
 
     //==============================================================================
     // --------- print() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Policy, typename Allocator, typename Growth>
     void
-    CBL<E>::print(std::ostream & o) {
+    CBL<E, Policy, Allocator, Growth>::print(std::ostream & o) {
+        finish_migration();
         if (is_empty()) {
             o << "<empty list>" << std::endl;
             return;
         }
 
-        //If our list circles the array but tail is 0
-        if (head > tail && tail == 0) {
-            int index = head;
-            o << "[";
-            while (index < size - 1)//Print from head to the end of the array
-                o << array[index++] << ",";
-            o << array[index] << "]";
-            return;
+        o << "[";
+        size_t index = head;
+        size_t const last = wrap(tail + size - 1);
+        while (index != last) { //Print from head to the element before the tail, following the circle
+            o << array[index] << ",";
+            index = wrap(index + 1);
         }
-        //If our list circles the array
-        if (head > tail) {
-            int index = head;
-            o << "[";
-            while (index < size)//Print from head to the end of the array
-                o << array[index++] << ",";
-            index = 0;
-            while (index < (tail - 1))//Print from the beginning of the array to the tail 
-                o << array[index++] << ",";
-            o << array[index] << "]";
-            return;
+        o << array[last] << "]";
+    }
+
+    //==============================================================================
+    // --------- view()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    ring_view<E>
+    CBL<E, Policy, Allocator, Growth>::view() {
+        finish_migration();
+        ring_view<E> result;
+        if (head <= tail) {
+            result.first = span<E>(array + head, tail - head);
+        } else { //The contents wrap around the end of the array
+            result.first = span<E>(array + head, size - head);
+            result.second = span<E>(array, tail);
         }
+        return result;
+    }
 
-        //If our list does not circle the array
-        int index = head;
-        o << "[";
-        while (index < (tail - 1))
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    ring_view<const E>
+    CBL<E, Policy, Allocator, Growth>::view() const {
+        finish_migration(); //Moving elements between the arrays leaves the list itself unchanged
+        ring_view<const E> result;
+        if (head <= tail) {
+            result.first = span<const E>(array + head, tail - head);
+        } else {
+            result.first = span<const E>(array + head, size - head);
+            result.second = span<const E>(array, tail);
+        }
+        return result;
+    }
 
-            o << array[index++] << ",";
-        o << array[index] << "]";
+    //==============================================================================
+    // --------- swap()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    void
+    CBL<E, Policy, Allocator, Growth>::swap(CBL& other) {
+        finish_migration();
+        other.finish_migration();
+        swap_allocator(allocator, other.allocator, typename traits::propagate_on_container_swap());
+        std::swap(array, other.array);
+        std::swap(size, other.size);
+        std::swap(original_size, other.original_size);
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+    }
+
+    //==============================================================================
+    // --------- get_allocator()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    typename CBL<E, Policy, Allocator, Growth>::allocator_type
+    CBL<E, Policy, Allocator, Growth>::get_allocator() const {
+        return allocator;
+    }
+
+    //==============================================================================
+    // --------- stats()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    list_stats
+    CBL<E, Policy, Allocator, Growth>::stats() const {
+#ifdef COP3530_INSTRUMENT
+        return instrumentation;
+#else
+        return list_stats();
+#endif
+    }
+
+    //==============================================================================
+    // --------- on_resize()
+
+    template <typename E, typename Policy, typename Allocator, typename Growth>
+    void
+    CBL<E, Policy, Allocator, Growth>::on_resize(resize_listener listener, void *context) {
+        notifier.listen(listener, context);
     }
 }
 
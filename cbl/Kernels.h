@@ -0,0 +1,636 @@
+//Kernels
+// - find, count, min, max and sum over a contiguous range of elements, for the lists that keep their elements contiguously (SDAL, and CBL in at most two segments).
+// - For int32 and float elements each kernel has an SSE2, an AVX2 and an AVX-512 version. The widest one the CPU supports is picked at run time,
+//   so the same binary runs everywhere; every other element type, and every CPU that is not x86, gets the scalar version.
+// - sum() adds 32-bit integers into 64 bits and floats into doubles, so it does not overflow where the scalar loop over E would.
+//   The SIMD versions add floats in a different order than the scalar one, so the last bits of a float sum can differ. min() and max() of ranges holding NaNs are unspecified.
+//
+// by Iago Patiño López
+// with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
+
+#ifndef KERNELS_H
+#define KERNELS_H
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "List.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define COP3530_X86_KERNELS 1
+#define COP3530_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#endif
+
+namespace cop3530 {
+
+    //==============================================================================
+    // CPU dispatch
+
+    enum class simd_level {
+        scalar, sse2, avx2, avx512
+    };
+
+    inline simd_level detect_simd_level() {
+#ifdef COP3530_X86_KERNELS
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) return simd_level::avx512;
+        if (__builtin_cpu_supports("avx2")) return simd_level::avx2;
+        if (__builtin_cpu_supports("sse2")) return simd_level::sse2;
+#endif
+        return simd_level::scalar;
+    }
+
+    //The widest instruction set of this CPU, detected once
+
+    inline simd_level cpu_simd_level() {
+        static const simd_level level = detect_simd_level();
+        return level;
+    }
+
+    //What sum() adds into: 64 bits for integers, double for floating point, E itself for anything else.
+
+    template <typename E>
+    struct sum_type {
+        using type = typename std::conditional<std::is_floating_point<E>::value, double,
+                typename std::conditional<std::is_integral<E>::value,
+                typename std::conditional<std::is_signed<E>::value, long long, unsigned long long>::type, E>::type>::type;
+    };
+
+    namespace simd_detail {
+
+        //==============================================================================
+        // scalar versions
+
+        template <typename E>
+        std::size_t scalar_count(const E *first, const E *last, const E& key) {
+            std::size_t count = 0;
+            for (; first != last; ++first)
+                count += *first == key;
+            return count;
+        }
+
+        template <typename E>
+        E scalar_min(const E *first, const E *last) {
+            E result = *first;
+            for (++first; first != last; ++first)
+                if (*first < result) result = *first;
+            return result;
+        }
+
+        template <typename E>
+        E scalar_max(const E *first, const E *last) {
+            E result = *first;
+            for (++first; first != last; ++first)
+                if (result < *first) result = *first;
+            return result;
+        }
+
+        template <typename E>
+        typename sum_type<E>::type scalar_sum(const E *first, const E *last) {
+            typename sum_type<E>::type result = typename sum_type<E>::type();
+            for (; first != last; ++first)
+                result += *first;
+            return result;
+        }
+
+#ifdef COP3530_X86_KERNELS
+
+        //==============================================================================
+        // int32, SSE2
+
+        COP3530_TARGET("sse2")
+        inline const std::int32_t *find_sse2(const std::int32_t *first, const std::int32_t *last, std::int32_t key) {
+            __m128i const probe = _mm_set1_epi32(key);
+            for (; last - first >= 16; first += 16) { //Four vectors per round, checked with one branch
+                __m128i const a = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) first), probe);
+                __m128i const b = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) (first + 4)), probe);
+                __m128i const c = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) (first + 8)), probe);
+                __m128i const d = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) (first + 12)), probe);
+                if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))) != 0) break;
+            }
+            return find_equal(first, last, key);
+        }
+
+        COP3530_TARGET("sse2")
+        inline std::size_t count_sse2(const std::int32_t *first, const std::int32_t *last, std::int32_t key) {
+            __m128i const probe = _mm_set1_epi32(key);
+            std::size_t count = 0;
+            while (last - first >= 4) {
+                __m128i matches = _mm_setzero_si128(); //Each lane counts down by one per match; flushed before it can overflow
+                const std::int32_t *const stop = last - first > (1 << 30) ? first + (1 << 30) : last;
+                for (; stop - first >= 4; first += 4)
+                    matches = _mm_sub_epi32(matches, _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) first), probe));
+                alignas(16) std::int32_t lanes[4];
+                _mm_store_si128((__m128i *) lanes, matches);
+                count += std::size_t(std::uint32_t(lanes[0])) + std::uint32_t(lanes[1]) + std::uint32_t(lanes[2]) + std::uint32_t(lanes[3]);
+            }
+            return count + scalar_count(first, last, key);
+        }
+
+        COP3530_TARGET("sse2")
+        inline __m128i min_epi32_sse2(__m128i a, __m128i b) { //SSE2 has no pminsd
+            __m128i const a_greater = _mm_cmpgt_epi32(a, b);
+            return _mm_or_si128(_mm_and_si128(a_greater, b), _mm_andnot_si128(a_greater, a));
+        }
+
+        COP3530_TARGET("sse2")
+        inline __m128i max_epi32_sse2(__m128i a, __m128i b) {
+            __m128i const a_greater = _mm_cmpgt_epi32(a, b);
+            return _mm_or_si128(_mm_and_si128(a_greater, a), _mm_andnot_si128(a_greater, b));
+        }
+
+        COP3530_TARGET("sse2")
+        inline std::int32_t min_sse2(const std::int32_t *first, const std::int32_t *last) {
+            if (last - first < 4) return scalar_min(first, last);
+            __m128i result = _mm_loadu_si128((const __m128i *) first);
+            for (first += 4; last - first >= 4; first += 4)
+                result = min_epi32_sse2(result, _mm_loadu_si128((const __m128i *) first));
+            alignas(16) std::int32_t lanes[5];
+            _mm_store_si128((__m128i *) lanes, result);
+            lanes[4] = first != last ? scalar_min(first, last) : lanes[0];
+            return scalar_min(lanes, lanes + 5);
+        }
+
+        COP3530_TARGET("sse2")
+        inline std::int32_t max_sse2(const std::int32_t *first, const std::int32_t *last) {
+            if (last - first < 4) return scalar_max(first, last);
+            __m128i result = _mm_loadu_si128((const __m128i *) first);
+            for (first += 4; last - first >= 4; first += 4)
+                result = max_epi32_sse2(result, _mm_loadu_si128((const __m128i *) first));
+            alignas(16) std::int32_t lanes[5];
+            _mm_store_si128((__m128i *) lanes, result);
+            lanes[4] = first != last ? scalar_max(first, last) : lanes[0];
+            return scalar_max(lanes, lanes + 5);
+        }
+
+        COP3530_TARGET("sse2")
+        inline long long sum_sse2(const std::int32_t *first, const std::int32_t *last) {
+            __m128i result = _mm_setzero_si128();
+            for (; last - first >= 4; first += 4) {
+                __m128i const v = _mm_loadu_si128((const __m128i *) first);
+                __m128i const sign = _mm_cmpgt_epi32(_mm_setzero_si128(), v); //Sign-extends each lane to 64 bits
+                result = _mm_add_epi64(result, _mm_unpacklo_epi32(v, sign));
+                result = _mm_add_epi64(result, _mm_unpackhi_epi32(v, sign));
+            }
+            alignas(16) long long lanes[2];
+            _mm_store_si128((__m128i *) lanes, result);
+            return lanes[0] + lanes[1] + scalar_sum(first, last);
+        }
+
+        //==============================================================================
+        // int32, AVX2
+
+        COP3530_TARGET("avx2")
+        inline const std::int32_t *find_avx2(const std::int32_t *first, const std::int32_t *last, std::int32_t key) {
+            __m256i const probe = _mm256_set1_epi32(key);
+            for (; last - first >= 32; first += 32) {
+                __m256i const a = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) first), probe);
+                __m256i const b = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) (first + 8)), probe);
+                __m256i const c = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) (first + 16)), probe);
+                __m256i const d = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) (first + 24)), probe);
+                if (!_mm256_testz_si256(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d)), _mm256_set1_epi32(-1))) break;
+            }
+            for (; last - first >= 8; first += 8) {
+                int const mask = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) first), probe)));
+                if (mask != 0) return first + __builtin_ctz(mask);
+            }
+            return find_equal(first, last, key);
+        }
+
+        COP3530_TARGET("avx2")
+        inline std::size_t count_avx2(const std::int32_t *first, const std::int32_t *last, std::int32_t key) {
+            __m256i const probe = _mm256_set1_epi32(key);
+            std::size_t count = 0;
+            while (last - first >= 8) {
+                __m256i matches = _mm256_setzero_si256();
+                const std::int32_t *const stop = last - first > (1 << 30) ? first + (1 << 30) : last;
+                for (; stop - first >= 8; first += 8)
+                    matches = _mm256_sub_epi32(matches, _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i *) first), probe));
+                alignas(32) std::uint32_t lanes[8];
+                _mm256_store_si256((__m256i *) lanes, matches);
+                for (int i = 0; i < 8; i++)
+                    count += lanes[i];
+            }
+            return count + scalar_count(first, last, key);
+        }
+
+        COP3530_TARGET("avx2")
+        inline std::int32_t min_avx2(const std::int32_t *first, const std::int32_t *last) {
+            if (last - first < 8) return scalar_min(first, last);
+            __m256i result = _mm256_loadu_si256((const __m256i *) first);
+            for (first += 8; last - first >= 8; first += 8)
+                result = _mm256_min_epi32(result, _mm256_loadu_si256((const __m256i *) first));
+            alignas(32) std::int32_t lanes[9];
+            _mm256_store_si256((__m256i *) lanes, result);
+            lanes[8] = first != last ? scalar_min(first, last) : lanes[0];
+            return scalar_min(lanes, lanes + 9);
+        }
+
+        COP3530_TARGET("avx2")
+        inline std::int32_t max_avx2(const std::int32_t *first, const std::int32_t *last) {
+            if (last - first < 8) return scalar_max(first, last);
+            __m256i result = _mm256_loadu_si256((const __m256i *) first);
+            for (first += 8; last - first >= 8; first += 8)
+                result = _mm256_max_epi32(result, _mm256_loadu_si256((const __m256i *) first));
+            alignas(32) std::int32_t lanes[9];
+            _mm256_store_si256((__m256i *) lanes, result);
+            lanes[8] = first != last ? scalar_max(first, last) : lanes[0];
+            return scalar_max(lanes, lanes + 9);
+        }
+
+        COP3530_TARGET("avx2")
+        inline long long sum_avx2(const std::int32_t *first, const std::int32_t *last) {
+            __m256i result = _mm256_setzero_si256();
+            for (; last - first >= 8; first += 8) {
+                __m256i const v = _mm256_loadu_si256((const __m256i *) first);
+                result = _mm256_add_epi64(result, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+                result = _mm256_add_epi64(result, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+            }
+            alignas(32) long long lanes[4];
+            _mm256_store_si256((__m256i *) lanes, result);
+            return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar_sum(first, last);
+        }
+
+        //==============================================================================
+        // int32, AVX-512
+
+        COP3530_TARGET("avx512f")
+        inline const std::int32_t *find_avx512(const std::int32_t *first, const std::int32_t *last, std::int32_t key) {
+            __m512i const probe = _mm512_set1_epi32(key);
+            for (; last - first >= 16; first += 16) {
+                __mmask16 const mask = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(first), probe);
+                if (mask != 0) return first + __builtin_ctz(mask);
+            }
+            __mmask16 const rest = __mmask16((1u << (last - first)) - 1); //The tail is loaded with a mask, so nothing past last is read
+            __mmask16 const mask = _mm512_mask_cmpeq_epi32_mask(rest, _mm512_maskz_loadu_epi32(rest, first), probe);
+            return mask != 0 ? first + __builtin_ctz(mask) : last;
+        }
+
+        COP3530_TARGET("avx512f")
+        inline std::size_t count_avx512(const std::int32_t *first, const std::int32_t *last, std::int32_t key) {
+            __m512i const probe = _mm512_set1_epi32(key);
+            std::size_t count = 0;
+            for (; last - first >= 16; first += 16)
+                count += __builtin_popcount(_mm512_cmpeq_epi32_mask(_mm512_loadu_si512(first), probe));
+            __mmask16 const rest = __mmask16((1u << (last - first)) - 1);
+            return count + __builtin_popcount(_mm512_mask_cmpeq_epi32_mask(rest, _mm512_maskz_loadu_epi32(rest, first), probe));
+        }
+
+        COP3530_TARGET("avx512f")
+        inline std::int32_t min_avx512(const std::int32_t *first, const std::int32_t *last) {
+            __m512i result = _mm512_set1_epi32(*first); //The range is never empty
+            for (; last - first >= 16; first += 16)
+                result = _mm512_min_epi32(result, _mm512_loadu_si512(first));
+            __mmask16 const rest = __mmask16((1u << (last - first)) - 1);
+            result = _mm512_mask_min_epi32(result, rest, result, _mm512_maskz_loadu_epi32(rest, first));
+            return _mm512_reduce_min_epi32(result);
+        }
+
+        COP3530_TARGET("avx512f")
+        inline std::int32_t max_avx512(const std::int32_t *first, const std::int32_t *last) {
+            __m512i result = _mm512_set1_epi32(*first);
+            for (; last - first >= 16; first += 16)
+                result = _mm512_max_epi32(result, _mm512_loadu_si512(first));
+            __mmask16 const rest = __mmask16((1u << (last - first)) - 1);
+            result = _mm512_mask_max_epi32(result, rest, result, _mm512_maskz_loadu_epi32(rest, first));
+            return _mm512_reduce_max_epi32(result);
+        }
+
+        COP3530_TARGET("avx512f")
+        inline long long sum_avx512(const std::int32_t *first, const std::int32_t *last) {
+            __m512i result = _mm512_setzero_si512();
+            for (; last - first >= 16; first += 16) {
+                __m512i const v = _mm512_loadu_si512(first);
+                result = _mm512_add_epi64(result, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(v)));
+                result = _mm512_add_epi64(result, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(v, 1)));
+            }
+            return _mm512_reduce_add_epi64(result) + scalar_sum(first, last);
+        }
+
+        //==============================================================================
+        // float, SSE2
+
+        COP3530_TARGET("sse2")
+        inline const float *find_sse2(const float *first, const float *last, float key) {
+            __m128 const probe = _mm_set1_ps(key);
+            for (; last - first >= 16; first += 16) {
+                __m128 const a = _mm_cmpeq_ps(_mm_loadu_ps(first), probe);
+                __m128 const b = _mm_cmpeq_ps(_mm_loadu_ps(first + 4), probe);
+                __m128 const c = _mm_cmpeq_ps(_mm_loadu_ps(first + 8), probe);
+                __m128 const d = _mm_cmpeq_ps(_mm_loadu_ps(first + 12), probe);
+                if (_mm_movemask_ps(_mm_or_ps(_mm_or_ps(a, b), _mm_or_ps(c, d))) != 0) break;
+            }
+            return find_equal(first, last, key);
+        }
+
+        COP3530_TARGET("sse2")
+        inline std::size_t count_sse2(const float *first, const float *last, float key) {
+            __m128 const probe = _mm_set1_ps(key);
+            std::size_t count = 0;
+            while (last - first >= 4) {
+                __m128i matches = _mm_setzero_si128();
+                const float *const stop = last - first > (1 << 30) ? first + (1 << 30) : last;
+                for (; stop - first >= 4; first += 4)
+                    matches = _mm_sub_epi32(matches, _mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(first), probe)));
+                alignas(16) std::uint32_t lanes[4];
+                _mm_store_si128((__m128i *) lanes, matches);
+                count += std::size_t(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+            }
+            return count + scalar_count(first, last, key);
+        }
+
+        COP3530_TARGET("sse2")
+        inline float min_sse2(const float *first, const float *last) {
+            if (last - first < 4) return scalar_min(first, last);
+            __m128 result = _mm_loadu_ps(first);
+            for (first += 4; last - first >= 4; first += 4)
+                result = _mm_min_ps(result, _mm_loadu_ps(first));
+            alignas(16) float lanes[5];
+            _mm_store_ps(lanes, result);
+            lanes[4] = first != last ? scalar_min(first, last) : lanes[0];
+            return scalar_min(lanes, lanes + 5);
+        }
+
+        COP3530_TARGET("sse2")
+        inline float max_sse2(const float *first, const float *last) {
+            if (last - first < 4) return scalar_max(first, last);
+            __m128 result = _mm_loadu_ps(first);
+            for (first += 4; last - first >= 4; first += 4)
+                result = _mm_max_ps(result, _mm_loadu_ps(first));
+            alignas(16) float lanes[5];
+            _mm_store_ps(lanes, result);
+            lanes[4] = first != last ? scalar_max(first, last) : lanes[0];
+            return scalar_max(lanes, lanes + 5);
+        }
+
+        COP3530_TARGET("sse2")
+        inline double sum_sse2(const float *first, const float *last) {
+            __m128d result = _mm_setzero_pd();
+            for (; last - first >= 4; first += 4) {
+                __m128 const v = _mm_loadu_ps(first);
+                result = _mm_add_pd(result, _mm_cvtps_pd(v));
+                result = _mm_add_pd(result, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+            }
+            alignas(16) double lanes[2];
+            _mm_store_pd(lanes, result);
+            return lanes[0] + lanes[1] + scalar_sum(first, last);
+        }
+
+        //==============================================================================
+        // float, AVX2
+
+        COP3530_TARGET("avx2")
+        inline const float *find_avx2(const float *first, const float *last, float key) {
+            __m256 const probe = _mm256_set1_ps(key);
+            for (; last - first >= 32; first += 32) {
+                __m256 const a = _mm256_cmp_ps(_mm256_loadu_ps(first), probe, _CMP_EQ_OQ);
+                __m256 const b = _mm256_cmp_ps(_mm256_loadu_ps(first + 8), probe, _CMP_EQ_OQ);
+                __m256 const c = _mm256_cmp_ps(_mm256_loadu_ps(first + 16), probe, _CMP_EQ_OQ);
+                __m256 const d = _mm256_cmp_ps(_mm256_loadu_ps(first + 24), probe, _CMP_EQ_OQ);
+                if (_mm256_movemask_ps(_mm256_or_ps(_mm256_or_ps(a, b), _mm256_or_ps(c, d))) != 0) break;
+            }
+            for (; last - first >= 8; first += 8) {
+                int const mask = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(first), probe, _CMP_EQ_OQ));
+                if (mask != 0) return first + __builtin_ctz(mask);
+            }
+            return find_equal(first, last, key);
+        }
+
+        COP3530_TARGET("avx2")
+        inline std::size_t count_avx2(const float *first, const float *last, float key) {
+            __m256 const probe = _mm256_set1_ps(key);
+            std::size_t count = 0;
+            while (last - first >= 8) {
+                __m256i matches = _mm256_setzero_si256();
+                const float *const stop = last - first > (1 << 30) ? first + (1 << 30) : last;
+                for (; stop - first >= 8; first += 8)
+                    matches = _mm256_sub_epi32(matches, _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(first), probe, _CMP_EQ_OQ)));
+                alignas(32) std::uint32_t lanes[8];
+                _mm256_store_si256((__m256i *) lanes, matches);
+                for (int i = 0; i < 8; i++)
+                    count += lanes[i];
+            }
+            return count + scalar_count(first, last, key);
+        }
+
+        COP3530_TARGET("avx2")
+        inline float min_avx2(const float *first, const float *last) {
+            if (last - first < 8) return scalar_min(first, last);
+            __m256 result = _mm256_loadu_ps(first);
+            for (first += 8; last - first >= 8; first += 8)
+                result = _mm256_min_ps(result, _mm256_loadu_ps(first));
+            alignas(32) float lanes[9];
+            _mm256_store_ps(lanes, result);
+            lanes[8] = first != last ? scalar_min(first, last) : lanes[0];
+            return scalar_min(lanes, lanes + 9);
+        }
+
+        COP3530_TARGET("avx2")
+        inline float max_avx2(const float *first, const float *last) {
+            if (last - first < 8) return scalar_max(first, last);
+            __m256 result = _mm256_loadu_ps(first);
+            for (first += 8; last - first >= 8; first += 8)
+                result = _mm256_max_ps(result, _mm256_loadu_ps(first));
+            alignas(32) float lanes[9];
+            _mm256_store_ps(lanes, result);
+            lanes[8] = first != last ? scalar_max(first, last) : lanes[0];
+            return scalar_max(lanes, lanes + 9);
+        }
+
+        COP3530_TARGET("avx2")
+        inline double sum_avx2(const float *first, const float *last) {
+            __m256d result = _mm256_setzero_pd();
+            for (; last - first >= 8; first += 8) {
+                __m256 const v = _mm256_loadu_ps(first);
+                result = _mm256_add_pd(result, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+                result = _mm256_add_pd(result, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+            }
+            alignas(32) double lanes[4];
+            _mm256_store_pd(lanes, result);
+            return lanes[0] + lanes[1] + lanes[2] + lanes[3] + scalar_sum(first, last);
+        }
+
+        //==============================================================================
+        // float, AVX-512
+
+        COP3530_TARGET("avx512f")
+        inline const float *find_avx512(const float *first, const float *last, float key) {
+            __m512 const probe = _mm512_set1_ps(key);
+            for (; last - first >= 16; first += 16) {
+                __mmask16 const mask = _mm512_cmp_ps_mask(_mm512_loadu_ps(first), probe, _CMP_EQ_OQ);
+                if (mask != 0) return first + __builtin_ctz(mask);
+            }
+            __mmask16 const rest = __mmask16((1u << (last - first)) - 1);
+            __mmask16 const mask = _mm512_mask_cmp_ps_mask(rest, _mm512_maskz_loadu_ps(rest, first), probe, _CMP_EQ_OQ);
+            return mask != 0 ? first + __builtin_ctz(mask) : last;
+        }
+
+        COP3530_TARGET("avx512f")
+        inline std::size_t count_avx512(const float *first, const float *last, float key) {
+            __m512 const probe = _mm512_set1_ps(key);
+            std::size_t count = 0;
+            for (; last - first >= 16; first += 16)
+                count += __builtin_popcount(_mm512_cmp_ps_mask(_mm512_loadu_ps(first), probe, _CMP_EQ_OQ));
+            __mmask16 const rest = __mmask16((1u << (last - first)) - 1);
+            return count + __builtin_popcount(_mm512_mask_cmp_ps_mask(rest, _mm512_maskz_loadu_ps(rest, first), probe, _CMP_EQ_OQ));
+        }
+
+        COP3530_TARGET("avx512f")
+        inline float min_avx512(const float *first, const float *last) {
+            __m512 result = _mm512_set1_ps(*first);
+            for (; last - first >= 16; first += 16)
+                result = _mm512_min_ps(result, _mm512_loadu_ps(first));
+            __mmask16 const rest = __mmask16((1u << (last - first)) - 1);
+            result = _mm512_mask_min_ps(result, rest, result, _mm512_maskz_loadu_ps(rest, first));
+            return _mm512_reduce_min_ps(result);
+        }
+
+        COP3530_TARGET("avx512f")
+        inline float max_avx512(const float *first, const float *last) {
+            __m512 result = _mm512_set1_ps(*first);
+            for (; last - first >= 16; first += 16)
+                result = _mm512_max_ps(result, _mm512_loadu_ps(first));
+            __mmask16 const rest = __mmask16((1u << (last - first)) - 1);
+            result = _mm512_mask_max_ps(result, rest, result, _mm512_maskz_loadu_ps(rest, first));
+            return _mm512_reduce_max_ps(result);
+        }
+
+        COP3530_TARGET("avx512f")
+        inline double sum_avx512(const float *first, const float *last) {
+            __m512d result = _mm512_setzero_pd();
+            for (; last - first >= 16; first += 16) {
+                __m512 const v = _mm512_loadu_ps(first);
+                result = _mm512_add_pd(result, _mm512_cvtps_pd(_mm512_castps512_ps256(v)));
+                result = _mm512_add_pd(result, _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(v), 1))));
+            }
+            return _mm512_reduce_add_pd(result) + scalar_sum(first, last);
+        }
+
+        //==============================================================================
+        // dispatch
+
+        //Picks the version for the given level. Only instantiated for int32 and float.
+
+        template <typename E>
+        struct dispatch {
+
+            static const E *find(const E *first, const E *last, const E& key, simd_level level) {
+                switch (level) {
+                    case simd_level::avx512: return find_avx512(first, last, key);
+                    case simd_level::avx2: return find_avx2(first, last, key);
+                    case simd_level::sse2: return find_sse2(first, last, key);
+                    default: return find_equal(first, last, key);
+                }
+            }
+
+            static std::size_t count(const E *first, const E *last, const E& key, simd_level level) {
+                switch (level) {
+                    case simd_level::avx512: return count_avx512(first, last, key);
+                    case simd_level::avx2: return count_avx2(first, last, key);
+                    case simd_level::sse2: return count_sse2(first, last, key);
+                    default: return scalar_count(first, last, key);
+                }
+            }
+
+            static E min(const E *first, const E *last, simd_level level) {
+                switch (level) {
+                    case simd_level::avx512: return min_avx512(first, last);
+                    case simd_level::avx2: return min_avx2(first, last);
+                    case simd_level::sse2: return min_sse2(first, last);
+                    default: return scalar_min(first, last);
+                }
+            }
+
+            static E max(const E *first, const E *last, simd_level level) {
+                switch (level) {
+                    case simd_level::avx512: return max_avx512(first, last);
+                    case simd_level::avx2: return max_avx2(first, last);
+                    case simd_level::sse2: return max_sse2(first, last);
+                    default: return scalar_max(first, last);
+                }
+            }
+
+            static typename sum_type<E>::type sum(const E *first, const E *last, simd_level level) {
+                switch (level) {
+                    case simd_level::avx512: return sum_avx512(first, last);
+                    case simd_level::avx2: return sum_avx2(first, last);
+                    case simd_level::sse2: return sum_sse2(first, last);
+                    default: return scalar_sum(first, last);
+                }
+            }
+        };
+
+        template <typename E>
+        struct has_kernels : std::integral_constant<bool, std::is_same<E, std::int32_t>::value || std::is_same<E, float>::value> {
+        };
+#else
+        template <typename E>
+        struct dispatch;
+
+        template <typename E>
+        struct has_kernels : std::false_type {
+        };
+#endif
+
+        //Everything else runs the scalar version
+
+        template <typename E, bool = has_kernels<E>::value>
+        struct select : dispatch<E> {
+        };
+
+        template <typename E>
+        struct select<E, false> {
+
+            static const E *find(const E *first, const E *last, const E& key, simd_level) {
+                return find_equal(first, last, key);
+            }
+
+            static std::size_t count(const E *first, const E *last, const E& key, simd_level) {
+                return scalar_count(first, last, key);
+            }
+
+            static E min(const E *first, const E *last, simd_level) {
+                return scalar_min(first, last);
+            }
+
+            static E max(const E *first, const E *last, simd_level) {
+                return scalar_max(first, last);
+            }
+
+            static typename sum_type<E>::type sum(const E *first, const E *last, simd_level) {
+                return scalar_sum(first, last);
+            }
+        };
+    }
+
+    //==============================================================================
+    // kernels
+    // The level defaults to the CPU's own and must never be above it. min() and max() need a range that is not empty.
+
+    template <typename E>
+    const E *simd_find(const E *first, const E *last, const E& key, simd_level level = cpu_simd_level()) { //The first element == key, or last
+        return simd_detail::select<E>::find(first, last, key, level);
+    }
+
+    template <typename E>
+    std::size_t simd_count(const E *first, const E *last, const E& key, simd_level level = cpu_simd_level()) { //How many elements are == key
+        return simd_detail::select<E>::count(first, last, key, level);
+    }
+
+    template <typename E>
+    E simd_min(const E *first, const E *last, simd_level level = cpu_simd_level()) {
+        return simd_detail::select<E>::min(first, last, level);
+    }
+
+    template <typename E>
+    E simd_max(const E *first, const E *last, simd_level level = cpu_simd_level()) {
+        return simd_detail::select<E>::max(first, last, level);
+    }
+
+    template <typename E>
+    typename sum_type<E>::type simd_sum(const E *first, const E *last, simd_level level = cpu_simd_level()) {
+        return simd_detail::select<E>::sum(first, last, level);
+    }
+}
+
+#endif /* KERNELS_H */
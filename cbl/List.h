@@ -1,5 +1,5 @@
 //List
-// -defines de ADT List
+// -defines de ADT List, as a static interface every list derives from (static_list) and as the original virtual one (List, through virtual_list)
 //
 // by Iago Patiño López
 // with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
@@ -7,6 +7,18 @@
 
 #ifndef LIST_H
 #define LIST_H
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#if __cplusplus > 201703L && defined(__has_include)
+#if __has_include(<span>)
+#include <span>
+#endif
+#endif
 namespace cop3530 {
     //==============================================================================
     // node
@@ -17,6 +29,343 @@ namespace cop3530 {
         node* next;
     };
 
+    //==============================================================================
+    // allocator propagation
+    // The lists take their allocator along on copy-assignment, move-assignment and swap only when std::allocator_traits says so.
+    // Call these with the allocator's propagate_on_container_... trait, e.g. assign_allocator(mine, theirs, typename traits::propagate_on_container_copy_assignment()).
+
+    template <typename Allocator>
+    void assign_allocator(Allocator& to, const Allocator& from, std::true_type) {
+        to = from;
+    }
+
+    template <typename Allocator>
+    void assign_allocator(Allocator&, const Allocator&, std::false_type) {
+    }
+
+    template <typename Allocator>
+    void move_allocator(Allocator& to, Allocator& from, std::true_type) {
+        to = std::move(from);
+    }
+
+    template <typename Allocator>
+    void move_allocator(Allocator&, Allocator&, std::false_type) {
+    }
+
+    template <typename Allocator>
+    void swap_allocator(Allocator& a, Allocator& b, std::true_type) {
+        using std::swap;
+        swap(a, b);
+    }
+
+    template <typename Allocator>
+    void swap_allocator(Allocator&, Allocator&, std::false_type) {
+    }
+
+    //==============================================================================
+    // span
+    // A non-owning view of contiguous elements. It is std::span where the standard library has it, and otherwise a minimal stand-in with the same names.
+
+#ifdef __cpp_lib_span
+    template <typename T>
+    using span = std::span<T>;
+#else
+
+    template <typename T>
+    class span {
+    public:
+        using element_type = T;
+        using value_type = typename std::remove_cv<T>::type;
+        using size_type = std::size_t;
+        using pointer = T*;
+        using reference = T&;
+        using iterator = T*;
+
+        span() : elements(nullptr), count(0) {
+        }
+
+        span(T *elements, std::size_t count) : elements(elements), count(count) {
+        }
+
+        template <typename U, typename = typename std::enable_if<std::is_convertible<U(*)[], T(*)[]>::value>::type>
+        span(const span<U>& other) : elements(other.data()), count(other.size()) { //A span converts to a span of const elements
+        }
+
+        T *data() const {
+            return elements;
+        }
+
+        std::size_t size() const {
+            return count;
+        }
+
+        std::size_t size_bytes() const {
+            return count * sizeof (T);
+        }
+
+        bool empty() const {
+            return count == 0;
+        }
+
+        T& operator[](std::size_t index) const {
+            return elements[index];
+        }
+
+        T *begin() const {
+            return elements;
+        }
+
+        T *end() const {
+            return elements + count;
+        }
+
+    private:
+        T *elements;
+        std::size_t count;
+    };
+#endif
+
+    //==============================================================================
+    // instrumentation
+    // Built with -DCOP3530_INSTRUMENT, every list counts what its operations do and reports the counts through stats(). Without it the counters
+    // are not even members and every COP3530_COUNT compiles to nothing, so stats() just returns zeros.
+
+    struct list_stats {
+        std::size_t node_hops = 0; //Links followed to reach a position or to scan the list
+        std::size_t copies = 0; //Elements written into the list (inserted or replaced)
+        std::size_t moves = 0; //Elements relocated inside the list: shifted to open or close a gap, or moved into a new backing array
+        std::size_t allocations = 0; //Calls to the allocator
+        std::size_t frees = 0; //Calls to the allocator to deallocate
+        std::size_t resizes = 0; //Times the backing array (SDAL, CBL) or the directory (CDAL) was replaced
+        std::size_t resize_bytes = 0; //Bytes of elements or directory entries those resizes moved
+        std::size_t pool_hits = 0; //PSLL: nodes taken from the pool
+        std::size_t pool_misses = 0; //PSLL: nodes that needed a new slab first
+        std::size_t chunk_allocations = 0; //CDAL: columns(arrays) allocated
+    };
+
+#ifdef COP3530_INSTRUMENT
+#define COP3530_COUNT(counter, n) (this->instrumentation.counter += (n))
+#else
+#define COP3530_COUNT(counter, n) ((void) 0)
+#endif
+
+    //==============================================================================
+    // resize events
+    // SDAL and CBL report every replacement of their backing array, and CDAL every array it adds or frees, to the listener given to on_resize(),
+    // with how long it took. A list without a listener does not even read the clock.
+
+    struct resize_event {
+        bool grew; //false when the list shrank
+        std::size_t old_capacity; //Elements the list had room for before the event
+        std::size_t new_capacity; //And after it
+        std::size_t elements; //Elements in the list
+        std::size_t bytes_moved; //Bytes of elements (or, for CDAL, of directory entries) copied into the new storage
+        std::uint64_t nanoseconds; //Wall time of the whole event, allocation and deallocation included
+    };
+
+    typedef void (*resize_listener)(const resize_event& event, void *context); //context is whatever was given to on_resize() along with the listener
+
+    class resize_notifier { //What a list keeps for on_resize(). It stays with the list object: copies, moves and swaps leave it alone.
+    public:
+        using clock = std::chrono::steady_clock;
+
+        void listen(resize_listener listener, void *context) {
+            this->listener = listener;
+            this->context = context;
+        }
+
+        clock::time_point start() const { //Call before resizing and hand the result to finish()
+            return listener == nullptr ? clock::time_point() : clock::now();
+        }
+
+        void finish(clock::time_point started, std::size_t old_capacity, std::size_t new_capacity, std::size_t elements, std::size_t bytes_moved) const {
+            if (listener == nullptr) return;
+            resize_event event;
+            event.grew = new_capacity > old_capacity;
+            event.old_capacity = old_capacity;
+            event.new_capacity = new_capacity;
+            event.elements = elements;
+            event.bytes_moved = bytes_moved;
+            event.nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - started).count();
+            listener(event, context);
+        }
+
+    private:
+        resize_listener listener = nullptr;
+        void *context = nullptr;
+    };
+
+    //==============================================================================
+    // growth modes
+    // How SDAL and CBL (their last template parameter) move their elements into a larger array once the current one is full.
+
+    //Every element is moved in the push that finds the array full: cheap on average, but that one push takes time proportional to the length.
+    struct all_at_once_growth {
+    };
+
+    //The old array stays alive next to the new one and a few elements move across in each of the following operations, as in incremental
+    //rehashing, so no push_back takes more than constant time. The operations that need every element in one place finish the move first.
+    struct incremental_growth {
+    };
+
+    //==============================================================================
+    // search helpers
+
+    //Returns the first element of [first, last) that is == key, or last. For arithmetic types the range is compared in blocks without leaving the block early,
+    //which lets the compiler use SIMD compares; the block that holds the match is then searched one element at a time.
+
+    template <typename E>
+    const E *find_equal(const E *first, const E *last, const E& key, std::true_type) {
+        static constexpr std::ptrdiff_t block = 64 / sizeof (E) < 16 ? 16 : 64 / sizeof (E);
+        const E probe = key; //A local copy, so the compiler knows the key cannot alias the range
+        while (last - first >= block) {
+            unsigned found = 0;
+            for (std::ptrdiff_t i = 0; i < block; i++)
+                found |= first[i] == probe;
+            if (found) break;
+            first += block;
+        }
+        for (; first != last; ++first)
+            if (*first == probe) return first;
+        return last;
+    }
+
+    template <typename E>
+    const E *find_equal(const E *first, const E *last, const E& key, std::false_type) {
+        for (; first != last; ++first)
+            if (*first == key) return first;
+        return last;
+    }
+
+    template <typename E>
+    const E *find_equal(const E *first, const E *last, const E& key) {
+        return find_equal(first, last, key, typename std::is_arithmetic<E>::type());
+    }
+
+    //==============================================================================
+    // static interface
+    // Every list derives from static_list<ItsOwnType, E>, which forwards each operation to the list itself without a virtual call.
+    // Generic code that takes a static_list<Derived, E>& gets the whole List interface with the calls resolved, and inlined, at compile time.
+
+    template <typename Derived, typename E>
+    class static_list {
+    public:
+        using value_type = E;
+
+        void insert(E element, int position) {
+            derived().insert(std::move(element), position);
+        }
+
+        void push_back(E element) {
+            derived().push_back(std::move(element));
+        }
+
+        void push_front(E element) {
+            derived().push_front(std::move(element));
+        }
+
+        E replace(E element, int position) {
+            return derived().replace(std::move(element), position);
+        }
+
+        E remove(int position) {
+            return derived().remove(position);
+        }
+
+        E pop_back(void) {
+            return derived().pop_back();
+        }
+
+        E pop_front(void) {
+            return derived().pop_front();
+        }
+
+        E item_at(int position) {
+            return derived().item_at(position);
+        }
+
+        E peek_back(void) {
+            return derived().peek_back();
+        }
+
+        E peek_front(void) {
+            return derived().peek_front();
+        }
+
+        bool is_empty(void) {
+            return derived().is_empty();
+        }
+
+        bool is_full(void) {
+            return derived().is_full();
+        }
+
+        std::size_t length(void) {
+            return derived().length();
+        }
+
+        void clear(void) {
+            derived().clear();
+        }
+
+        bool contains(E element, bool (*equals_function)(const E&, const E&)) {
+            return derived().contains(std::move(element), equals_function);
+        }
+
+        template <typename Predicate>
+        int find_if(Predicate predicate) {
+            return derived().find_if(predicate);
+        }
+
+        bool contains(const E& element) {
+            return derived().contains(element);
+        }
+
+        template <typename Equals>
+        bool contains(const E& element, Equals equals) {
+            return derived().contains(element, equals);
+        }
+
+        void print(std::ostream& o) {
+            derived().print(o);
+        }
+
+        E * const contents() {
+            return derived().contents();
+        }
+
+        template <typename OutputIt>
+        OutputIt copy_to(OutputIt out) { //Not part of the virtual List: a template member cannot be virtual
+            return derived().copy_to(out);
+        }
+
+        list_stats stats() { //All zeros unless built with COP3530_INSTRUMENT
+            return derived().stats();
+        }
+
+        Derived& derived() {
+            return static_cast<Derived&> (*this);
+        }
+
+    protected:
+        ~static_list() { //Lists are not destroyed through the static interface, so it needs no virtual destructor
+        }
+    };
+
+    //True for any list that provides the static interface
+    template <typename L>
+    struct is_static_list : std::is_base_of<static_list<L, typename L::value_type>, L> {
+    };
+
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+    template <typename L>
+    concept list_type = is_static_list<L>::value;
+#endif
+
+    //==============================================================================
+    // dynamic interface
+    // The original, virtual List ADT. None of the lists derive from it any more: wrap one in virtual_list (below) to use it through a List<E>*.
+
     template <typename E>
     class List {
     public:
@@ -41,6 +390,97 @@ namespace cop3530 {
         virtual ~List() {
         }; //Destructor method
     };
+
+    //==============================================================================
+    // virtual adapter
+    // For code that needs to pick the implementation at run time: virtual_list<SSLL<int> > owns an SSLL<int> and is a List<int>.
+
+    template <typename L>
+    class virtual_list : public List<typename L::value_type> {
+    public:
+        using E = typename L::value_type;
+
+        virtual_list() {
+        }
+
+        explicit virtual_list(L list) : list(std::move(list)) {
+        }
+
+        void insert(E element, int position) override {
+            list.insert(std::move(element), position);
+        }
+
+        void push_back(E element) override {
+            list.push_back(std::move(element));
+        }
+
+        void push_front(E element) override {
+            list.push_front(std::move(element));
+        }
+
+        E replace(E element, int position) override {
+            return list.replace(std::move(element), position);
+        }
+
+        E remove(int position) override {
+            return list.remove(position);
+        }
+
+        E pop_back(void) override {
+            return list.pop_back();
+        }
+
+        E pop_front(void) override {
+            return list.pop_front();
+        }
+
+        E item_at(int position) override {
+            return list.item_at(position);
+        }
+
+        E peek_back(void) override {
+            return list.peek_back();
+        }
+
+        E peek_front(void) override {
+            return list.peek_front();
+        }
+
+        bool is_empty(void) override {
+            return list.is_empty();
+        }
+
+        bool is_full(void) override {
+            return list.is_full();
+        }
+
+        size_t length(void) override {
+            return list.length();
+        }
+
+        void clear(void) override {
+            list.clear();
+        }
+
+        bool contains(E element, bool (*equals_function)(const E&, const E&)) override {
+            return list.contains(std::move(element), equals_function);
+        }
+
+        void print(std::ostream& o) override {
+            list.print(o);
+        }
+
+        E * const contents() override {
+            return list.contents();
+        }
+
+        L& get() { //The list itself, for calls that should not go through the virtual interface
+            return list;
+        }
+
+    private:
+        L list;
+    };
 }
 
 #endif /* LIST_H */
@@ -0,0 +1,318 @@
+// Multi-Producer/Multi-Consumer Circular Buffer List (MPMC_CBL)
+// A bounded, lock-free circular buffer that any number of threads can push to and pop from at the same time.
+// Like SPSC_CBL, the backing array never grows, its size is a power of two (CBL's power_of_two_policy) and head and tail are free-running counters.
+// Because several threads share each end, every slot also carries a sequence number that says whose turn it is (D. Vyukov's bounded MPMC queue):
+//  - sequence == position        the slot is free for the producer that claims that tail position
+//  - sequence == position + 1    the slot holds the element for the consumer that claims that head position
+// A thread claims a position with a compare-and-swap on head or tail and then owns the slot until it advances the sequence,
+// so producers only contend with producers, consumers only contend with consumers, and no thread ever waits on a lock.
+// Only the List operations that make sense for a concurrent queue are offered.
+// The slots are raw storage: a producer constructs its element in place and the consumer moves it out and destroys it, so E only needs to be
+// copy constructible (for push) and move constructible (for pop), not default constructible.
+// peek_front() reads a slot that a consumer may pop, and the next lap's producer then overwrite, while it reads. That is only defined when the
+// slot is an atomic, so an element that is trivially copyable and 1, 2, 4 or 8 bytes is kept in a std::atomic<E> instead, and only such
+// elements can be peeked at.
+//
+// by Iago Patiño López
+// with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
+
+#ifndef MPMC_CBL_H
+#define MPMC_CBL_H
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include "CBL.h"
+
+namespace cop3530 {
+
+    //==============================================================================
+    // slot payloads
+
+    //Whether E fits in a std::atomic<E> that every platform we build on handles without a lock
+
+    template <typename E>
+    struct fits_lock_free_atomic : std::integral_constant<bool, std::is_trivially_copyable<E>::value &&
+    (sizeof (E) == 1 || sizeof (E) == 2 || sizeof (E) == 4 || sizeof (E) == 8)> {
+    };
+
+    //Raw storage: holds an element only between its push and its pop.
+
+    template <typename E, bool Atomic = fits_lock_free_atomic<E>::value>
+    class mpmc_payload {
+    public:
+        static constexpr bool peekable = false;
+
+        void construct(const E& element) {
+            ::new (static_cast<void *>(storage)) E(element);
+        }
+
+        E take() { //Moves the element out. It still has to be destroyed.
+            return E(std::move(*datum()));
+        }
+
+        void destroy() {
+            datum()->~E();
+        }
+
+    private:
+        E *datum() {
+            return reinterpret_cast<E *>(storage);
+        }
+
+        alignas(E) unsigned char storage[sizeof (E)];
+    };
+
+    //A std::atomic<E>: another thread may load it while the slot is being popped or refilled, so peek_front() can read it.
+
+    template <typename E>
+    class mpmc_payload<E, true> {
+    public:
+        static constexpr bool peekable = true;
+
+        void construct(const E& element) {
+            value.store(element, std::memory_order_relaxed); //The slot's sequence number orders it
+        }
+
+        E take() {
+            return load();
+        }
+
+        E load() const {
+            return value.load(std::memory_order_relaxed);
+        }
+
+        void destroy() {
+        }
+
+    private:
+        std::atomic<E> value;
+    };
+
+    //==============================================================================
+    // MPMC_CBL
+
+    template <typename E>
+    class MPMC_CBL {
+    public:
+        using size_t = std::size_t;
+        using value_type = E;
+
+        //operations
+        explicit MPMC_CBL(size_t capacity = 64); //The capacity is rounded up to a power of two
+        MPMC_CBL(const MPMC_CBL& other) = delete; //The counters belong to running threads, so the queue cannot be copied or moved
+        MPMC_CBL & operator=(const MPMC_CBL& other) = delete;
+        ~MPMC_CBL();
+
+        bool try_push_back(const E& element); //Appends the element and returns true, or returns false if the queue is full
+        bool try_pop_front(E& element); //Moves the head into element and returns true, or returns false if the queue is empty
+
+        void push_back(E element); //Appends the specified element to the queue, or throws if it is full
+        E pop_front(void); //Removes and returns the element at the queue's head, or throws if it is empty
+        E peek_front(void); //Returns a copy of the element at the queue's head, or throws if it is empty. Only for trivially copyable elements of 1, 2, 4 or 8 bytes.
+
+        //From any thread's point of view these are only a snapshot.
+        size_t length(void) const; //Returns the number of elements in the queue
+        bool is_empty(void) const; //Returns true IFF the queue contains no elements
+        bool is_full(void) const; //Returns true IFF no more elements can be added to the queue
+        size_t capacity(void) const; //Returns the number of slots in the backing array
+
+    private:
+        static constexpr size_t cache_line = 64;
+
+        struct cell {
+            std::atomic<size_t> sequence; //Whose turn it is to use this slot, see above
+            mpmc_payload<E> payload;
+        };
+
+        cell *claim_front(size_t& position); //Claims the head position for this consumer and returns its slot, or nullptr if the queue is empty
+        void release_front(cell *slot, size_t position); //Destroys the element the consumer moved out and hands the slot to the next lap's producer
+
+        size_t const size; //This is the size of the backing array, a power of two
+        cell * const array; //This is the backing array
+
+        alignas(cache_line) std::atomic<size_t> head; //Next position a consumer will claim
+        alignas(cache_line) std::atomic<size_t> tail; //Next position a producer will claim
+        char padding[cache_line - sizeof (size_t)]; //Keeps whatever is allocated after the queue off the producers' line
+    };
+
+    //==============================================================================
+    // ------- constructor
+
+    template <typename E>
+    MPMC_CBL<E>::MPMC_CBL(size_t capacity) : size(power_of_two_policy::initial_size(capacity)), array(new cell[size]), head(0), tail(0) {
+        for (size_t i = 0; i < size; i++) //Every slot starts free for the producer of the first lap
+            array[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // ------  destructor
+
+    template <typename E>
+    MPMC_CBL<E>::~MPMC_CBL() { //No other thread may be using the queue by now, so every position in [head, tail) holds an element
+        for (size_t position = head.load(std::memory_order_relaxed); position != tail.load(std::memory_order_relaxed); position++)
+            array[power_of_two_policy::wrap(position, size)].payload.destroy();
+        delete [] array;
+    }
+
+    //==============================================================================
+    // operations
+
+    //==============================================================================
+    // --------- try_push_back()
+
+    template <typename E>
+    bool
+    MPMC_CBL<E>::try_push_back(const E& element) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        cell *slot;
+        while (true) {
+            slot = &array[power_of_two_policy::wrap(position, size)];
+            size_t const sequence = slot->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t const difference = std::ptrdiff_t(sequence) - std::ptrdiff_t(position);
+            if (difference == 0) { //The slot is free: try to claim this position
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (difference < 0) { //The slot still holds the element from the previous lap: the queue is full
+                return false;
+            } else { //Another producer claimed this position first
+                position = tail.load(std::memory_order_relaxed);
+            }
+        }
+        slot->payload.construct(element);
+        slot->sequence.store(position + 1, std::memory_order_release); //Hand the slot to the consumer of this position
+        return true;
+    }
+
+    //==============================================================================
+    // --------- claim_front()
+
+    template <typename E>
+    typename MPMC_CBL<E>::cell *
+    MPMC_CBL<E>::claim_front(size_t& position) {
+        position = head.load(std::memory_order_relaxed);
+        cell *slot;
+        while (true) {
+            slot = &array[power_of_two_policy::wrap(position, size)];
+            size_t const sequence = slot->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t const difference = std::ptrdiff_t(sequence) - std::ptrdiff_t(position + 1);
+            if (difference == 0) { //The slot holds an element: try to claim this position
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+            } else if (difference < 0) { //No producer has filled this slot yet: the queue is empty
+                return nullptr;
+            } else { //Another consumer claimed this position first
+                position = head.load(std::memory_order_relaxed);
+            }
+        }
+        return slot;
+    }
+
+    //==============================================================================
+    // --------- release_front()
+
+    template <typename E>
+    void
+    MPMC_CBL<E>::release_front(cell *slot, size_t position) {
+        slot->payload.destroy();
+        slot->sequence.store(position + size, std::memory_order_release); //Hand the slot to the producer of the next lap
+    }
+
+    //==============================================================================
+    // --------- try_pop_front()
+
+    template <typename E>
+    bool
+    MPMC_CBL<E>::try_pop_front(E& element) {
+        size_t position;
+        cell * const slot = claim_front(position);
+        if (slot == nullptr) return false;
+        element = slot->payload.take();
+        release_front(slot, position);
+        return true;
+    }
+
+    //==============================================================================
+    // --------- push_back()
+
+    template <typename E>
+    void
+    MPMC_CBL<E>::push_back(E element) {
+        if (!try_push_back(element)) throw std::runtime_error("Sorry, the queue is full");
+    }
+
+    //==============================================================================
+    // --------- pop_front()
+
+    template <typename E>
+    E
+    MPMC_CBL<E>::pop_front() {
+        size_t position;
+        cell * const slot = claim_front(position);
+        if (slot == nullptr) throw std::runtime_error("Sorry, but this queue is empty");
+        E element(slot->payload.take()); //Constructed from the slot, so E needs no default constructor
+        release_front(slot, position);
+        return element;
+    }
+
+    //==============================================================================
+    // --------- peek_front()
+
+    template <typename E>
+    E
+    MPMC_CBL<E>::peek_front() {
+        static_assert(mpmc_payload<E>::peekable, "peek_front() reads a slot another thread may be writing, which is only defined for elements kept in a lock-free std::atomic");
+        while (true) {
+            size_t const position = head.load(std::memory_order_acquire);
+            cell const &slot = array[power_of_two_policy::wrap(position, size)];
+            if (slot.sequence.load(std::memory_order_acquire) != position + 1) { //No producer has filled this slot yet
+                if (head.load(std::memory_order_acquire) == position) throw std::runtime_error("This queue is empty");
+                continue;
+            }
+            E const copy = slot.payload.load(); //An atomic load, so it is defined even if the slot has been popped and refilled since
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == position + 1) //Nobody popped the element before we loaded it, so the copy is that element
+                return copy;
+        }
+    }
+
+    //==============================================================================
+    // --------- length()
+
+    template <typename E>
+    size_t
+    MPMC_CBL<E>::length() const {
+        size_t const h = head.load(std::memory_order_acquire);
+        size_t const t = tail.load(std::memory_order_acquire);
+        if (t <= h) return 0;
+        return t - h > size ? size : t - h; //Claimed positions whose elements are still being written count as well
+    }
+
+    //==============================================================================
+    // --------- is_empty()
+
+    template <typename E>
+    bool
+    MPMC_CBL<E>::is_empty() const {
+        return length() == 0;
+    }
+
+    //==============================================================================
+    // --------- is_full()
+
+    template <typename E>
+    bool
+    MPMC_CBL<E>::is_full() const {
+        return length() >= size;
+    }
+
+    //==============================================================================
+    // --------- capacity()
+
+    template <typename E>
+    size_t
+    MPMC_CBL<E>::capacity() const {
+        return size;
+    }
+}
+
+#endif /* MPMC_CBL_H */
@@ -0,0 +1,213 @@
+// Single-Producer/Single-Consumer Circular Buffer List (SPSC_CBL)
+// A bounded, lock-free variant of the CBL for handing elements from exactly one producer thread to exactly one consumer thread.
+// The backing array never grows: its size is rounded up to a power of two with CBL's power_of_two_policy and every slot can hold an element.
+// head and tail are free-running counters, wrapped into the array with the policy. Only the producer writes tail and only the consumer writes head,
+// so the two threads synchronise through a release store of their own counter and an acquire load of the other one, without a lock.
+// head and tail live on different cache lines so that the producer and the consumer do not invalidate each other's line on every operation,
+// and each side keeps a private copy of the other side's counter that it only refreshes when the queue looks full (or empty).
+// The slots are raw storage, as in MPMC_CBL: the producer constructs its element in place and the consumer moves it out and destroys it,
+// so E only needs to be copy constructible (for push) and move assignable (for pop), not default constructible.
+//
+// by Iago Patiño López
+// with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
+
+#ifndef SPSC_CBL_H
+#define SPSC_CBL_H
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+#include "CBL.h"
+
+namespace cop3530 {
+
+    template <typename E>
+    class SPSC_CBL {
+    public:
+        using size_t = std::size_t;
+        using value_type = E;
+
+        //operations
+        explicit SPSC_CBL(size_t capacity = 64); //The capacity is rounded up to a power of two
+        SPSC_CBL(const SPSC_CBL& other) = delete; //The counters belong to two running threads, so the queue cannot be copied or moved
+        SPSC_CBL & operator=(const SPSC_CBL& other) = delete;
+        ~SPSC_CBL();
+
+        //Producer side
+        bool try_push_back(const E& element); //Appends the element and returns true, or returns false if the queue is full
+        size_t try_push_back(const E* elements, size_t count); //Appends as many of the elements as fit and returns how many that was
+
+        //Consumer side
+        bool try_pop_front(E& element); //Moves the head into element and returns true, or returns false if the queue is empty
+        size_t try_pop_front(E* elements, size_t count); //Moves up to count elements into the given array and returns how many that was
+
+        //Either side. From the other thread's point of view these are only a snapshot.
+        size_t length(void) const; //Returns the number of elements in the queue
+        bool is_empty(void) const; //Returns true IFF the queue contains no elements
+        bool is_full(void) const; //Returns true IFF no more elements can be added to the queue
+        size_t capacity(void) const; //Returns the number of slots in the backing array
+
+    private:
+        static constexpr size_t cache_line = 64;
+
+        struct cell {
+            alignas(E) unsigned char storage[sizeof (E)]; //Holds an element only between its push and its pop
+
+            E *datum() {
+                return reinterpret_cast<E *>(storage);
+            }
+        };
+
+        size_t const size; //This is the size of the backing array, a power of two
+        cell * const array; //This is the backing array
+
+        alignas(cache_line) std::atomic<size_t> head; //Number of elements popped so far. Written by the consumer only.
+        size_t cached_tail; //The consumer's last look at tail
+
+        alignas(cache_line) std::atomic<size_t> tail; //Number of elements pushed so far. Written by the producer only.
+        size_t cached_head; //The producer's last look at head
+
+        char padding[cache_line - sizeof (size_t)]; //Keeps whatever is allocated after the queue off the producer's line
+    };
+
+    //==============================================================================
+    // ------- constructor
+
+    template <typename E>
+    SPSC_CBL<E>::SPSC_CBL(size_t capacity) : size(power_of_two_policy::initial_size(capacity)), array(new cell[size]), head(0), cached_tail(0), tail(0), cached_head(0) {
+    }
+
+    // ------  destructor
+
+    template <typename E>
+    SPSC_CBL<E>::~SPSC_CBL() { //Neither thread may be using the queue by now, so every position in [head, tail) holds an element
+        for (size_t position = head.load(std::memory_order_relaxed); position != tail.load(std::memory_order_relaxed); position++)
+            array[power_of_two_policy::wrap(position, size)].datum()->~E();
+        delete [] array;
+    }
+
+    //==============================================================================
+    // operations
+
+    //==============================================================================
+    // --------- try_push_back()
+
+    template <typename E>
+    bool
+    SPSC_CBL<E>::try_push_back(const E& element) {
+        size_t const t = tail.load(std::memory_order_relaxed); //Only we write tail
+        if (t - cached_head == size) { //Looks full, so see how far the consumer has got
+            cached_head = head.load(std::memory_order_acquire); //Acquire: the consumer is done with the slots it popped
+            if (t - cached_head == size) return false;
+        }
+        ::new (static_cast<void *>(array[power_of_two_policy::wrap(t, size)].datum())) E(element);
+        tail.store(t + 1, std::memory_order_release); //Release: the element is written before the consumer can see it
+        return true;
+    }
+
+    //==============================================================================
+    // --------- try_push_back() batch
+
+    template <typename E>
+    size_t
+    SPSC_CBL<E>::try_push_back(const E* elements, size_t count) {
+        size_t const t = tail.load(std::memory_order_relaxed);
+        if (size - (t - cached_head) < count)
+            cached_head = head.load(std::memory_order_acquire);
+        size_t const free_slots = size - (t - cached_head);
+        if (count > free_slots) count = free_slots;
+        for (size_t i = 0; i < count; i++) {
+            try {
+                ::new (static_cast<void *>(array[power_of_two_policy::wrap(t + i, size)].datum())) E(elements[i]);
+            } catch (...) {
+                tail.store(t + i, std::memory_order_release); //The elements already constructed are pushed, so that they get popped and destroyed
+                throw;
+            }
+        }
+        tail.store(t + count, std::memory_order_release); //One release publishes the whole batch
+        return count;
+    }
+
+    //==============================================================================
+    // --------- try_pop_front()
+
+    template <typename E>
+    bool
+    SPSC_CBL<E>::try_pop_front(E& element) {
+        size_t const h = head.load(std::memory_order_relaxed); //Only we write head
+        if (h == cached_tail) { //Looks empty, so see how far the producer has got
+            cached_tail = tail.load(std::memory_order_acquire); //Acquire: the producer's writes to the slots are visible
+            if (h == cached_tail) return false;
+        }
+        E *datum = array[power_of_two_policy::wrap(h, size)].datum();
+        element = std::move(*datum);
+        datum->~E();
+        head.store(h + 1, std::memory_order_release); //Release: we are done reading the slot before the producer can reuse it
+        return true;
+    }
+
+    //==============================================================================
+    // --------- try_pop_front() batch
+
+    template <typename E>
+    size_t
+    SPSC_CBL<E>::try_pop_front(E* elements, size_t count) {
+        size_t const h = head.load(std::memory_order_relaxed);
+        if (cached_tail - h < count)
+            cached_tail = tail.load(std::memory_order_acquire);
+        size_t const available = cached_tail - h;
+        if (count > available) count = available;
+        for (size_t i = 0; i < count; i++) {
+            E *datum = array[power_of_two_policy::wrap(h + i, size)].datum();
+            try {
+                elements[i] = std::move(*datum);
+            } catch (...) {
+                head.store(h + i, std::memory_order_release); //The elements already destroyed are popped, so that the queue does not destroy them again
+                throw;
+            }
+            datum->~E();
+        }
+        head.store(h + count, std::memory_order_release);
+        return count;
+    }
+
+    //==============================================================================
+    // --------- length()
+
+    template <typename E>
+    size_t
+    SPSC_CBL<E>::length() const {
+        size_t const h = head.load(std::memory_order_acquire);
+        size_t const t = tail.load(std::memory_order_acquire);
+        return t - h; //The counters never wrap in practice, and unsigned subtraction copes even if they do
+    }
+
+    //==============================================================================
+    // --------- is_empty()
+
+    template <typename E>
+    bool
+    SPSC_CBL<E>::is_empty() const {
+        return length() == 0;
+    }
+
+    //==============================================================================
+    // --------- is_full()
+
+    template <typename E>
+    bool
+    SPSC_CBL<E>::is_full() const {
+        return length() >= size;
+    }
+
+    //==============================================================================
+    // --------- capacity()
+
+    template <typename E>
+    size_t
+    SPSC_CBL<E>::capacity() const {
+        return size;
+    }
+}
+
+#endif /* SPSC_CBL_H */
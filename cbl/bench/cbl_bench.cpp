@@ -0,0 +1,50 @@
+//Circular Buffer List (CBL) benchmark
+// - Times the CBL used as a FIFO queue under each capacity policy.
+//
+// by Iago Patiño López
+// Build from this directory with: g++ -std=c++11 -O2 -I .. cbl_bench.cpp -o cbl_bench
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+//List ADTs included below:
+#include "CBL.h"
+
+using namespace cop3530;
+
+double nanoseconds_since(std::chrono::steady_clock::time_point start, long operations) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / operations;
+}
+
+//Keeps depth elements queued and then pushes one and pops one, operations times, so the head and tail chase each other around the array
+
+template <typename Policy>
+void fifo(const char *policy_name, int depth, long operations) {
+    volatile long sink = 0; //Keeps the compiler from discarding the measured calls
+    CBL<long, Policy> queue;
+    for (int i = 0; i < depth; i++)
+        queue.push_back(i);
+
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < operations; i++) {
+        queue.push_back(i);
+        sink = sink + queue.pop_front();
+    }
+    double steady = nanoseconds_since(start, operations);
+
+    start = std::chrono::steady_clock::now();
+    for (long i = 0; i < operations; i++)
+        sink = sink + queue.item_at(i % depth);
+    double indexed = nanoseconds_since(start, operations);
+
+    std::cout << policy_name << "," << depth << "," << steady << "," << indexed << std::endl;
+}
+
+int main() {
+    std::cout << "policy,depth,push_back_pop_front_ns,item_at_ns" << std::endl;
+    for (int depth = 16; depth <= 65536; depth *= 16) {
+        fifo<half_growth_policy>("half_growth", depth, 20000000);
+        fifo<power_of_two_policy>("power_of_two", depth, 20000000);
+    }
+    return 0;
+}
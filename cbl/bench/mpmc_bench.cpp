@@ -0,0 +1,93 @@
+//Multi-Producer/Multi-Consumer Circular Buffer List (MPMC_CBL) benchmark
+// - Measures throughput under contention for the lock-free MPMC_CBL and for a CBL behind a single mutex.
+//   Usage: mpmc_bench [producers] [consumers] [elements]   (defaults: 4 4 4000000)
+//
+// by Iago Patiño López
+// Build from this directory with: g++ -std=c++11 -O2 -pthread -I .. mpmc_bench.cpp -o mpmc_bench
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//List ADTs included below:
+#include "CBL.h"
+#include "MPMC_CBL.h"
+
+using namespace cop3530;
+
+//The baseline: a CBL with a global lock, given the same non-blocking interface as the MPMC_CBL
+
+class locked_queue {
+public:
+
+    explicit locked_queue(std::size_t capacity) : capacity(capacity) {
+    }
+
+    bool try_push_back(long element) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (list.length() >= capacity) return false;
+        list.push_back(element);
+        return true;
+    }
+
+    bool try_pop_front(long& element) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (list.is_empty()) return false;
+        element = list.pop_front();
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    std::size_t const capacity;
+    CBL<long, power_of_two_policy> list;
+};
+
+//Every producer pushes its share of elements and every consumer pops until all of them are through. Returns nanoseconds per element.
+
+template <typename Queue>
+double contention(int producers, int consumers, long elements) {
+    Queue queue(4096);
+    std::atomic<long> received(0), sum(0);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int p = 0; p < producers; p++) {
+        threads.push_back(std::thread([&, p]() {
+            for (long i = p; i < elements; i += producers) //Producer p sends p, p + producers, p + 2 * producers, ...
+                while (!queue.try_push_back(i))
+                    std::this_thread::yield();
+        }));
+    }
+    for (int c = 0; c < consumers; c++) {
+        threads.push_back(std::thread([&]() {
+            long element, local_sum = 0;
+            while (received.load(std::memory_order_relaxed) < elements) {
+                if (queue.try_pop_front(element)) {
+                    local_sum += element;
+                    received.fetch_add(1, std::memory_order_relaxed);
+                } else std::this_thread::yield();
+            }
+            sum += local_sum;
+        }));
+    }
+    for (std::size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+    double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / elements;
+    return sum.load() == (elements - 1) * elements / 2 ? nanoseconds : -1; //A negative time flags lost elements
+}
+
+int main(int argc, char **argv) {
+    int const producers = argc > 1 ? std::atoi(argv[1]) : 4;
+    int const consumers = argc > 2 ? std::atoi(argv[2]) : 4;
+    long const elements = argc > 3 ? std::atol(argv[3]) : 4000000;
+
+    std::cout << "queue,producers,consumers,elements,ns_per_element" << std::endl;
+    std::cout << "locked_cbl," << producers << "," << consumers << "," << elements << "," << contention<locked_queue>(producers, consumers, elements) << std::endl;
+    std::cout << "mpmc_cbl," << producers << "," << consumers << "," << elements << "," << contention<MPMC_CBL<long> >(producers, consumers, elements) << std::endl;
+    return 0;
+}
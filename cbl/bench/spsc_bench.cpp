@@ -0,0 +1,156 @@
+//Single-Producer/Single-Consumer Circular Buffer List (SPSC_CBL) benchmark
+// - Compares handing elements between threads through a CBL behind a mutex and through the lock-free SPSC_CBL.
+//   Throughput is measured with one thread (push then pop on the same thread) and with a producer and a consumer thread.
+//   Latency is the round trip of one element over a pair of queues between two threads.
+//
+// by Iago Patiño López
+// Build from this directory with: g++ -std=c++11 -O2 -pthread -I .. spsc_bench.cpp -o spsc_bench
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+//List ADTs included below:
+#include "CBL.h"
+#include "SPSC_CBL.h"
+
+using namespace cop3530;
+
+//The baseline: a CBL with a lock, given the same non-blocking interface as the SPSC_CBL
+
+class locked_queue {
+public:
+
+    explicit locked_queue(std::size_t capacity) : capacity(capacity) {
+    }
+
+    bool try_push_back(long element) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (list.length() >= capacity) return false;
+        list.push_back(element);
+        return true;
+    }
+
+    bool try_pop_front(long& element) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (list.is_empty()) return false;
+        element = list.pop_front();
+        return true;
+    }
+
+    std::size_t try_push_back(const long* elements, std::size_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::size_t pushed = 0;
+        while (pushed < count && list.length() < capacity)
+            list.push_back(elements[pushed++]);
+        return pushed;
+    }
+
+    std::size_t try_pop_front(long* elements, std::size_t count) {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::size_t popped = 0;
+        while (popped < count && !list.is_empty())
+            elements[popped++] = list.pop_front();
+        return popped;
+    }
+
+private:
+    std::mutex mutex;
+    std::size_t const capacity;
+    CBL<long, power_of_two_policy> list;
+};
+
+double nanoseconds_since(std::chrono::steady_clock::time_point start, long operations) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / operations;
+}
+
+//One thread pushes and pops in turn, which shows the bare cost of each operation
+
+template <typename Queue>
+double single_thread(long operations) {
+    Queue queue(1024);
+    long element = 0, sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < operations; i++) {
+        queue.try_push_back(i);
+        queue.try_pop_front(element);
+        sum += element;
+    }
+    double result = nanoseconds_since(start, operations);
+    return sum == (operations - 1) * operations / 2 ? result : -1; //A negative time flags lost elements
+}
+
+//A producer thread hands operations elements to a consumer thread, batch elements at a time
+
+template <typename Queue>
+double two_threads(long operations, std::size_t batch) {
+    Queue queue(1024);
+    long sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    std::thread consumer([&]() {
+        long elements[64];
+        for (long received = 0; received < operations;) {
+            std::size_t popped = batch == 1 ? queue.try_pop_front(elements[0]) : queue.try_pop_front(elements, batch);
+            if (popped == 0) std::this_thread::yield();
+            for (std::size_t i = 0; i < popped; i++)
+                sum += elements[i];
+            received += popped;
+        }
+    });
+    long elements[64];
+    for (long sent = 0; sent < operations;) {
+        std::size_t count = batch;
+        if (operations - sent < long(count)) count = operations - sent;
+        for (std::size_t i = 0; i < count; i++)
+            elements[i] = sent + i;
+        std::size_t pushed = batch == 1 ? queue.try_push_back(elements[0]) : queue.try_push_back(elements, count);
+        if (pushed == 0) std::this_thread::yield();
+        sent += pushed;
+    }
+    consumer.join();
+    double result = nanoseconds_since(start, operations);
+    return sum == (operations - 1) * operations / 2 ? result : -1;
+}
+
+//One element bounces between two threads over a pair of queues
+
+template <typename Queue>
+double round_trip(long trips) {
+    Queue there(64), back(64);
+    std::thread echo([&]() {
+        long element;
+        for (long i = 0; i < trips; i++) {
+            while (!there.try_pop_front(element))
+                std::this_thread::yield();
+            while (!back.try_push_back(element))
+                std::this_thread::yield();
+        }
+    });
+    long element = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long i = 0; i < trips; i++) {
+        while (!there.try_push_back(i))
+            std::this_thread::yield();
+        while (!back.try_pop_front(element))
+            std::this_thread::yield();
+    }
+    double result = nanoseconds_since(start, trips);
+    echo.join();
+    return result;
+}
+
+int main() {
+    long const operations = 10000000;
+    std::cout << "queue,threads,batch,ns_per_element" << std::endl;
+    std::cout << "locked_cbl,1,1," << single_thread<locked_queue>(operations) << std::endl;
+    std::cout << "spsc_cbl,1,1," << single_thread<SPSC_CBL<long> >(operations) << std::endl;
+    for (std::size_t batch = 1; batch <= 64; batch *= 8) {
+        std::cout << "locked_cbl,2," << batch << "," << two_threads<locked_queue>(operations, batch) << std::endl;
+        std::cout << "spsc_cbl,2," << batch << "," << two_threads<SPSC_CBL<long> >(operations, batch) << std::endl;
+    }
+    std::cout << "queue,round_trip_ns" << std::endl;
+    std::cout << "locked_cbl," << round_trip<locked_queue>(100000) << std::endl;
+    std::cout << "spsc_cbl," << round_trip<SPSC_CBL<long> >(100000) << std::endl;
+    return 0;
+}
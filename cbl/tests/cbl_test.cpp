@@ -3,19 +3,29 @@
 //
 // by Iago Patiño López
 // with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <vector>
+#include <iterator>
 #include <valarray>
 #include <string>
 #include <sstream>
+#include <type_traits>
 #define DEBUG
 
 //List ADTs included below:
 #include "CBL.h"
+#include "Trace.h"
+#include "SPSC_CBL.h"
+#include "MPMC_CBL.h"
+#include <thread>
 
 
 //Catch testing file included below:
 #define CATCH_CONFIG_MAIN
 #include "catch.h"
+#include "counting_allocator.h"
 
 using namespace cop3530;
 
@@ -25,6 +35,11 @@ bool equals_function(const int& a, const int& b) {
     return a == b;
 }
 
+//The list the shared allocator checks in counting_allocator.h run on.
+
+template <typename Allocator>
+using cbl_with = CBL<int, half_growth_policy, Allocator>;
+
 class person {
 public:
     int age;
@@ -52,6 +67,52 @@ public:
     }
 };
 
+//An element with no default constructor, for the concurrent queues whose slots are raw storage
+
+struct labelled {
+    explicit labelled(const std::string& label) : label(label) {
+    }
+    std::string label;
+};
+
+//An element whose assignment throws once the budget runs out, and which counts the objects alive, for the queues' exception safety
+
+struct fragile {
+    static int assignments_left;
+    static int alive;
+
+    explicit fragile(int value) : value(value) {
+        alive++;
+    }
+    fragile(const fragile& other) : value(other.value) {
+        alive++;
+    }
+    ~fragile() {
+        alive--;
+    }
+    fragile& operator=(const fragile& other) {
+        if (assignments_left-- == 0) throw std::runtime_error("Sorry, but this element refuses to be assigned");
+        value = other.value;
+        return *this;
+    }
+    int value;
+};
+int fragile::assignments_left = -1;
+int fragile::alive = 0;
+
+//Generic code written against the static interface. The calls resolve to the concrete list at compile time.
+//Each turn moves the front element to the back, which a circular buffer does without shifting anything.
+
+template <typename Derived>
+void rotate_front_to_back(static_list<Derived, int>& list, int turns) {
+    for (int i = 0; i < turns; i++)
+        list.push_back(list.pop_front());
+}
+
+//Collects the resize events of the on_resize() tests
+void collect_resize(const resize_event& event, void *events) {
+    static_cast<std::vector<resize_event> *>(events)->push_back(event);
+}
 
 TEST_CASE("Testing each method of the CBAL", "[CBL]") {
 
@@ -450,6 +511,152 @@ TEST_CASE("Testing each method of the CBAL", "[CBL]") {
 
     //OTHER
 
+    SECTION("Testing the power of two capacity policy") {
+        CBL<int, power_of_two_policy> *test_cbal_26 = new CBL<int, power_of_two_policy>(5);
+
+        for (int i = 0; i < 100; i++) { //Wraps around the end of the array many times while growing
+            test_cbal_26->push_back(i);
+            test_cbal_26->push_front(-i);
+            REQUIRE(test_cbal_26->pop_front() == -i);
+        }
+        test_cbal_26->insert(-1, 50);
+        REQUIRE(test_cbal_26->length() == 101);
+        REQUIRE(test_cbal_26->item_at(50) == -1);
+        REQUIRE(test_cbal_26->remove(50) == -1);
+        REQUIRE(test_cbal_26->peek_front() == 0);
+        REQUIRE(test_cbal_26->peek_back() == 99);
+        for (int i = 0; i < 95; i++)
+            REQUIRE(test_cbal_26->pop_front() == i);
+        std::ostringstream stream;
+        test_cbal_26->print(stream);
+        REQUIRE(stream.str() == "[95,96,97,98,99]");
+
+        delete test_cbal_26;
+    }
+
+    SECTION("Testing the single-producer/single-consumer queue") {
+        SPSC_CBL<int> test_cbal_27(5); //An automatic object, so that head and tail get the cache line alignment they ask for
+
+        REQUIRE(test_cbal_27.capacity() == 8);
+        REQUIRE(test_cbal_27.is_empty());
+        int out;
+        REQUIRE(!test_cbal_27.try_pop_front(out));
+        for (int i = 0; i < 8; i++)
+            REQUIRE(test_cbal_27.try_push_back(i));
+        REQUIRE(test_cbal_27.is_full());
+        REQUIRE(!test_cbal_27.try_push_back(8));
+        REQUIRE(test_cbal_27.try_pop_front(out));
+        REQUIRE(out == 0);
+
+        int batch[8] = {10, 11, 12};
+        REQUIRE(test_cbal_27.try_push_back(batch, 3) == 1); //Only one slot is free
+        REQUIRE(test_cbal_27.try_pop_front(batch, 8) == 8);
+        REQUIRE(batch[0] == 1);
+        REQUIRE(batch[7] == 10);
+        REQUIRE(test_cbal_27.length() == 0);
+
+        //Hand 100000 elements from one thread to another through the 8 slots
+        long sum = 0;
+        std::thread consumer([&]() {
+            int element;
+            for (int received = 0; received < 100000;) {
+                if (test_cbal_27.try_pop_front(element)) {
+                    sum += element;
+                    received++;
+                } else std::this_thread::yield();
+            }
+        });
+        for (int i = 0; i < 100000;)
+            if (test_cbal_27.try_push_back(i)) i++;
+            else std::this_thread::yield();
+        consumer.join();
+        REQUIRE(sum == 4999950000L);
+
+        //The slots are raw storage, so elements need no default constructor, and the ones left over are destroyed with the queue
+        SPSC_CBL<labelled> test_cbal_30(2);
+        labelled const words[] = {labelled("b"), labelled("c"), labelled("d")};
+        REQUIRE(test_cbal_30.try_push_back(labelled("a string too long for the small string buffer")));
+        REQUIRE(test_cbal_30.try_push_back(words, 3) == 1);
+        labelled popped("");
+        REQUIRE(test_cbal_30.try_pop_front(popped));
+        REQUIRE(popped.label == "a string too long for the small string buffer");
+        REQUIRE(test_cbal_30.try_push_back(words + 1, 2) == 1);
+        REQUIRE(test_cbal_30.try_pop_front(&popped, 1) == 1);
+        REQUIRE(popped.label == "b");
+        REQUIRE(test_cbal_30.length() == 1);
+
+        {
+            SPSC_CBL<fragile> test_cbal_52(4); //A batch pop that throws keeps every element it has not yet destroyed
+            for (int i = 0; i < 3; i++) REQUIRE(test_cbal_52.try_push_back(fragile(i)));
+            fragile out[3] = {fragile(-1), fragile(-1), fragile(-1)};
+            fragile::assignments_left = 1;
+            REQUIRE_THROWS(test_cbal_52.try_pop_front(out, 3));
+            fragile::assignments_left = -1;
+            REQUIRE(out[0].value == 0);
+            REQUIRE(test_cbal_52.length() == 2);
+            REQUIRE(test_cbal_52.try_pop_front(out, 3) == 2);
+            REQUIRE(out[0].value == 1);
+            REQUIRE(out[1].value == 2);
+            REQUIRE(fragile::alive == 3); //Only the ones in out
+        }
+        REQUIRE(fragile::alive == 0); //Nothing destroyed twice
+    }
+
+    SECTION("Testing the multi-producer/multi-consumer queue") {
+        MPMC_CBL<int> test_cbal_28(4); //An automatic object, so that head and tail get the cache line alignment they ask for
+
+        REQUIRE(test_cbal_28.is_empty());
+        REQUIRE_THROWS(test_cbal_28.pop_front());
+        REQUIRE_THROWS(test_cbal_28.peek_front());
+        for (int i = 0; i < 4; i++)
+            test_cbal_28.push_back(i);
+        REQUIRE(test_cbal_28.is_full());
+        REQUIRE_THROWS(test_cbal_28.push_back(4));
+        REQUIRE(test_cbal_28.peek_front() == 0);
+        REQUIRE(test_cbal_28.pop_front() == 0);
+        REQUIRE(test_cbal_28.length() == 3);
+        while (!test_cbal_28.is_empty())
+            test_cbal_28.pop_front();
+
+        //Four producers each hand 25000 elements to four consumers
+        std::atomic<long> sum(0);
+        std::atomic<int> received(0);
+        std::thread threads[8];
+        for (int t = 0; t < 4; t++) {
+            threads[t] = std::thread([&, t]() {
+                for (int i = t * 25000; i < (t + 1) * 25000;)
+                    if (test_cbal_28.try_push_back(i)) i++;
+                    else std::this_thread::yield();
+            });
+            threads[t + 4] = std::thread([&]() {
+                int element;
+                while (received.load() < 100000)
+                    if (test_cbal_28.try_pop_front(element)) {
+                        sum += element;
+                        received++;
+                    } else std::this_thread::yield();
+            });
+        }
+        for (int t = 0; t < 8; t++)
+            threads[t].join();
+        REQUIRE(received.load() == 100000);
+        REQUIRE(sum.load() == 4999950000L);
+        REQUIRE(test_cbal_28.is_empty());
+
+        //The slots are raw storage, so elements need no default constructor, and the ones left over are destroyed with the queue
+        MPMC_CBL<labelled> test_cbal_29(2);
+        REQUIRE(!mpmc_payload<labelled>::peekable); //Not an atomic, so it offers no peek_front()
+        REQUIRE(mpmc_payload<int>::peekable);
+        test_cbal_29.push_back(labelled("a string too long for the small string buffer"));
+        test_cbal_29.push_back(labelled("b"));
+        REQUIRE(test_cbal_29.pop_front().label == "a string too long for the small string buffer");
+        test_cbal_29.push_back(labelled("c"));
+        labelled popped("");
+        REQUIRE(test_cbal_29.try_pop_front(popped));
+        REQUIRE(popped.label == "b");
+        REQUIRE(test_cbal_29.length() == 1);
+    }
+
     SECTION("Complex multi-function test") {
         CBL<int> *test_cbal_25 = new CBL<int>;
         REQUIRE(test_cbal_25->is_empty());
@@ -650,5 +857,333 @@ TEST_CASE("Testing each method of the CBAL", "[CBL]") {
         delete test_cbl_32;
     }
 
+    SECTION("Testing the allocator") {
+        require_allocator_propagation<cbl_with>();
+
+        allocation_log log;
+        typedef counting_allocator<int, true> propagating;
+        {
+            CBL<int, half_growth_policy, propagating> test_cbal_31(10, propagating(1, &log));
+            REQUIRE(log.allocations == 1); //One array of the slots asked for
+            REQUIRE(log.bytes == long(10 * sizeof (int)));
+            REQUIRE(log.constructions == 10); //Every slot holds an element, used or not, so pushes assign rather than construct
+            for (int i = 0; i < 5; i++) test_cbal_31.push_back(i);
+            for (int i = 0; i < 5; i++) test_cbal_31.pop_front();
+            for (int i = 0; i < 9; i++) test_cbal_31.push_back(i); //Wraps around the end of the array
+            REQUIRE(log.allocations == 1);
+            REQUIRE(log.constructions == 10);
+
+            test_cbal_31.push_back(9); //One slot always stays free, so the tenth element needs a larger array
+            REQUIRE(log.allocations == 2);
+            REQUIRE(log.deallocations == 1);
+            REQUIRE(log.bytes == long(15 * sizeof (int)));
+            REQUIRE(log.constructions == 10 + 15);
+            for (int i = 0; i < 10; i++) REQUIRE(test_cbal_31.item_at(i) == i); //Unwrapped in the new array
+
+            for (int i = 10; i < 15; i++) test_cbal_31.push_back(i);
+            REQUIRE(log.bytes == long(23 * sizeof (int)));
+            for (int i = 0; i < 5; i++) test_cbal_31.pop_front(); //Shrinks once it is twice its first size and less than half full
+            REQUIRE(log.deallocations == 3);
+            REQUIRE(log.bytes == long(17 * sizeof (int)));
+            REQUIRE(test_cbal_31.peek_front() == 5);
+        }
+        REQUIRE(log.bytes == 0);
+        REQUIRE(log.allocations == log.deallocations);
+    }
+
+    SECTION("Testing the static interface and the virtual adapter") {
+        REQUIRE(is_static_list<CBL<int> >::value);
+        CBL<int> test_cbal_35(10);
+        for (int i = 0; i < 8; i++) test_cbal_35.push_back(i);
+        rotate_front_to_back(test_cbal_35, 5);
+        REQUIRE(test_cbal_35.length() == 8);
+        REQUIRE(test_cbal_35.peek_front() == 5);
+        REQUIRE(test_cbal_35.peek_back() == 4);
+        REQUIRE(!test_cbal_35.view().second.empty()); //The elements now wrap around the end of the array
+
+        virtual_list<CBL<int> > test_cbal_36;
+        List<int>& dynamic = test_cbal_36; //Only the adapter is a List<int>
+        dynamic.push_back(1);
+        dynamic.push_front(0); //Goes in the last slot of the array
+        ring_view<int> segments = test_cbal_36.get().view(); //The CBL's own members work on the list behind the adapter
+        REQUIRE(segments.first.size() == 1);
+        REQUIRE(segments.first[0] == 0);
+        REQUIRE(segments.second.size() == 1);
+        std::ostringstream stream;
+        dynamic.print(stream);
+        REQUIRE(stream.str() == "[0,1]");
+        rotate_front_to_back(test_cbal_36.get(), 1);
+        REQUIRE(dynamic.peek_front() == 1);
+        REQUIRE(dynamic.peek_back() == 0);
+    }
+
+    SECTION("Testing find_if and contains in a wrapped list") {
+        CBL<int> test_cbal_37(20); //Slots 10 to 19 hold 10 to 19, and the list wraps so that slots 0 to 4 hold 20 to 24
+        for (int i = 0; i < 15; i++) test_cbal_37.push_back(i);
+        for (int i = 0; i < 10; i++) test_cbal_37.pop_front();
+        for (int i = 15; i < 25; i++) test_cbal_37.push_back(i);
+        REQUIRE(test_cbal_37.find_if([](const int& x) { return x >= 20; }) == 10); //The first slot of the second segment
+        REQUIRE(test_cbal_37.find_if([](const int& x) { return x == 24; }) == 14); //The last one
+        REQUIRE(test_cbal_37.find(22) == 12);
+        REQUIRE(test_cbal_37.contains(20));
+        REQUIRE(test_cbal_37.contains(24));
+        REQUIRE(test_cbal_37.contains(23, [](const int& datum, const int& element) { return datum == element; }));
+        REQUIRE(test_cbal_37.contains(21, equals_function));
+        REQUIRE(!test_cbal_37.contains(9)); //Slots 5 to 9 still hold 5 to 9, but they are outside the list
+        REQUIRE(test_cbal_37.find_if([](const int& x) { return x < 10; }) == -1);
+
+        test_cbal_37.replace(21, 0); //A value in both segments is found in the first one
+        REQUIRE(test_cbal_37.find(21) == 0);
+        REQUIRE(test_cbal_37.find_if([](const int& x) { return x == 21; }) == 0);
+
+        CBL<int> test_cbal_38;
+        REQUIRE(test_cbal_38.find_if([](const int&) { return true; }) == -1);
+        REQUIRE(!test_cbal_38.contains(0));
+        REQUIRE(!test_cbal_38.contains(0, equals_function));
+    }
+
+    SECTION("Testing the SIMD kernels") {
+        CBL<int> test_cbal_40(100); //A list that wraps around the end of its array
+        for (int i = 0; i < 80; i++) test_cbal_40.push_back(0);
+        for (int i = 0; i < 60; i++) {
+            test_cbal_40.pop_front();
+            test_cbal_40.push_back(i);
+        }
+        for (int i = 0; i < 20; i++) {
+            test_cbal_40.pop_front();
+            test_cbal_40.push_back(-i);
+        }
+        REQUIRE(test_cbal_40.find(59) == 59);
+        REQUIRE(test_cbal_40.find(-1) == 61);
+        REQUIRE(test_cbal_40.find(100) == -1);
+        REQUIRE(test_cbal_40.count(0) == 2);
+        REQUIRE(test_cbal_40.min() == -19);
+        REQUIRE(test_cbal_40.max() == 59);
+        REQUIRE(test_cbal_40.sum() == 1770 - 190);
+
+        CBL<float> test_cbal_41;
+        REQUIRE(test_cbal_41.count(1.0f) == 0);
+        REQUIRE_THROWS(test_cbal_41.min());
+        test_cbal_41.push_front(2.5f);
+        test_cbal_41.push_front(-1.5f);
+        REQUIRE(test_cbal_41.min() == -1.5f);
+        REQUIRE(test_cbal_41.max() == 2.5f);
+        REQUIRE(test_cbal_41.sum() == 1.0);
+    }
+
+    SECTION("Testing the random-access iterator across the end of the array") {
+        CBL<int> test_cbal_42(100); //A list that wraps around the end of its array
+        for (int i = 0; i < 80; i++) test_cbal_42.push_back(0);
+        for (int i = 0; i < 80; i++) {
+            test_cbal_42.pop_front();
+            test_cbal_42.push_back((i * 37) % 80);
+        }
+        CBL<int>::iterator first = test_cbal_42.begin(), last = test_cbal_42.end();
+        REQUIRE(last - first == 80);
+        int walked = 0;
+        for (CBL<int>::iterator it = first; it != last; ++it, walked++) //Walking past the end of the array continues at its start
+            REQUIRE(*it == test_cbal_42.item_at(walked));
+        REQUIRE(walked == 80);
+        REQUIRE(first[30] == (30 * 37) % 80);
+        REQUIRE(*(last - 1) == (79 * 37) % 80);
+        std::sort(first, last);
+        for (int i = 0; i < 80; i++) REQUIRE(test_cbal_42.item_at(i) == i);
+        REQUIRE(std::lower_bound(first, last, 42) - first == 42);
+        std::reverse(first, last);
+        REQUIRE(test_cbal_42.peek_front() == 79);
+        REQUIRE(test_cbal_42.peek_back() == 0);
+
+        const CBL<int>& test_cbal_43 = test_cbal_42;
+        CBL<int>::const_iterator const_first = test_cbal_43.begin();
+        REQUIRE(test_cbal_43.end() - const_first == 80);
+        CBL<int>::const_iterator converted = first + 5;
+        REQUIRE(*converted == 74);
+        REQUIRE(converted > const_first);
+    }
+
+    SECTION("Testing the two-span view") {
+        CBL<int> test_cbal_44(100);
+        REQUIRE(test_cbal_44.view().empty());
+        for (int i = 0; i < 60; i++) test_cbal_44.push_back(i);
+        ring_view<int> unwrapped = test_cbal_44.view();
+        REQUIRE(unwrapped.first.size() == 60);
+        REQUIRE(unwrapped.second.empty());
+
+        for (int i = 0; i < 50; i++) { //Now the contents wrap around the end of the array
+            test_cbal_44.pop_front();
+            test_cbal_44.push_back(60 + i);
+        }
+        ring_view<int> wrapped = test_cbal_44.view();
+        REQUIRE(wrapped.size() == 60);
+        REQUIRE(wrapped.first.size() == 50);
+        REQUIRE(wrapped.second.size() == 10);
+        REQUIRE(wrapped.first[0] == 50);
+        REQUIRE(wrapped.second[9] == 109);
+
+        int buffer[60]; //What a writer would do instead of calling contents()
+        std::memcpy(buffer, wrapped.first.data(), wrapped.first.size_bytes());
+        std::memcpy(buffer + wrapped.first.size(), wrapped.second.data(), wrapped.second.size_bytes());
+        for (int i = 0; i < 60; i++) REQUIRE(buffer[i] == 50 + i);
+
+        wrapped.second[0] = -1; //The view is the list itself, not a copy
+        REQUIRE(test_cbal_44.item_at(50) == -1);
+        const CBL<int>& test_cbal_45 = test_cbal_44;
+        ring_view<const int> read_only = test_cbal_45.view();
+        REQUIRE(read_only.second[0] == -1);
+    }
+
+    SECTION("Testing copy_to") {
+        CBL<int> test_cbal_46(100);
+        for (int i = 0; i < 60; i++) test_cbal_46.push_back(i);
+        for (int i = 0; i < 50; i++) { //The contents wrap around the end of the array
+            test_cbal_46.pop_front();
+            test_cbal_46.push_back(60 + i);
+        }
+        int buffer[61];
+        buffer[60] = -1;
+        REQUIRE(test_cbal_46.copy_to(buffer) == buffer + 60);
+        for (int i = 0; i < 60; i++) REQUIRE(buffer[i] == 50 + i);
+        REQUIRE(buffer[60] == -1);
+        std::vector<int> appended;
+        test_cbal_46.copy_to(std::back_inserter(appended));
+        REQUIRE(appended.size() == 60);
+        REQUIRE(appended[59] == 109);
+        CBL<int> test_cbal_47;
+        REQUIRE(test_cbal_47.copy_to(buffer) == buffer);
+    }
+
+    SECTION("Testing the instrumentation counters") {
+        CBL<int> test_cbal_48(10); //One slot always stays free, so the tenth push grows the array
+        for (int i = 0; i < 10; i++) test_cbal_48.push_back(i);
+        test_cbal_48.insert(-1, 4); //Shifts the last six
+        list_stats counted = test_cbal_48.stats();
+#ifdef COP3530_INSTRUMENT
+        REQUIRE(counted.copies == 11);
+        REQUIRE(counted.moves == 9 + 6);
+        REQUIRE(counted.resizes == 1);
+        REQUIRE(counted.resize_bytes == 9 * sizeof (int));
+        REQUIRE(counted.allocations == 2);
+        REQUIRE(counted.frees == 1);
+#else
+        REQUIRE(counted.copies == 0); //Not counted at all
+        REQUIRE(counted.resizes == 0);
+#endif
+    }
+
+    SECTION("Testing the resize events") {
+        CBL<int> test_cbal_49(10);
+        std::vector<resize_event> events;
+        test_cbal_49.on_resize(collect_resize, &events);
+        for (int i = 0; i < 10; i++) test_cbal_49.push_front(i); //One slot always stays free, so the tenth push grows the array
+        REQUIRE(events.size() == 1);
+        REQUIRE(events[0].grew);
+        REQUIRE(events[0].old_capacity == 10);
+        REQUIRE(events[0].new_capacity == 15);
+        REQUIRE(events[0].elements == 9);
+        REQUIRE(events[0].bytes_moved == 9 * sizeof (int));
+        latency_histogram resize_times; //Or straight into a histogram
+        test_cbal_49.on_resize(record_resize_time, &resize_times);
+        for (int i = 0; i < 10; i++) test_cbal_49.push_back(i);
+        REQUIRE(events.size() == 1);
+        REQUIRE(resize_times.count() == 1);
+    }
+
+    SECTION("Testing incremental growth") {
+        CBL<int, half_growth_policy, std::allocator<int>, incremental_growth> test_cbal_50(4);
+        std::vector<resize_event> events;
+        test_cbal_50.on_resize(collect_resize, &events);
+        for (int i = 0; i < 1000; i++) {
+            test_cbal_50.push_back(i);
+            if (i % 3 == 2) REQUIRE(test_cbal_50.pop_front() == i / 3); //The head moves while the elements are still in the old array
+            REQUIRE(test_cbal_50.peek_back() == i);
+            REQUIRE(test_cbal_50.item_at(int(test_cbal_50.length() / 2)) == int((i + 1) / 3 + test_cbal_50.length() / 2));
+        }
+        REQUIRE(events.size() > 5);
+        REQUIRE(events[0].grew);
+        REQUIRE(events[0].bytes_moved == 0); //The elements follow a few at a time
+        REQUIRE(test_cbal_50.length() == 667);
+        REQUIRE(test_cbal_50.sum() == 444222); //333 to 999, added up once every element is back in one array
+
+        //A const list halfway through a migration finishes it to hand out its iterators or its view
+        typedef CBL<std::string, half_growth_policy, std::allocator<std::string>, incremental_growth> growing;
+        growing test_cbal_53(20), test_cbal_54(20);
+        events.clear();
+        test_cbal_53.on_resize(collect_resize, &events);
+        for (int i = 0; i < 22; i++) {
+            test_cbal_53.push_back(std::string(20, char('a' + i)));
+            test_cbal_54.push_back(std::string(20, char('a' + i)));
+        }
+        REQUIRE(test_cbal_53.pop_front() == std::string(20, 'a'));
+        REQUIRE(events.size() == 1); //A push started the migration, and it and the rest moved only a few elements
+        growing const& test_cbal_55 = test_cbal_53;
+        int visited = 0;
+        for (growing::const_iterator it = test_cbal_55.begin(); it != test_cbal_55.end(); ++it, visited++)
+            REQUIRE(*it == std::string(20, char('b' + visited)));
+        REQUIRE(visited == 21);
+        ring_view<const std::string> const elements = static_cast<growing const&> (test_cbal_54).view();
+        REQUIRE(elements.size() == 22);
+        REQUIRE(elements.second.size() == 0); //Migrated to the start of the new array
+        for (int i = 0; i < 22; i++) REQUIRE(elements.first[i] == std::string(20, char('a' + i)));
+        test_cbal_53.push_back("w");
+        REQUIRE(test_cbal_53.peek_back() == "w");
+        REQUIRE(test_cbal_53.peek_front() == std::string(20, 'b'));
+
+        //Every operation, halfway through a migration or not, against a std::vector
+        CBL<std::string, power_of_two_policy, std::allocator<std::string>, incremental_growth> test_cbal_51(3);
+        std::vector<std::string> expected;
+        unsigned state = 2463534242u;
+        for (int i = 0; i < 4000; i++) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            std::string const element(20, char('a' + i % 26)); //Long enough to live on the heap
+            int const position = expected.empty() ? 0 : int(state / 16 % expected.size());
+            switch (state % 16) {
+                case 0: test_cbal_51.insert(element, position);
+                    expected.insert(expected.begin() + position, element);
+                    break;
+                case 1: if (!expected.empty()) {
+                        REQUIRE(test_cbal_51.remove(position) == expected[position]);
+                        expected.erase(expected.begin() + position);
+                    }
+                    break;
+                case 2: case 3: case 4: if (!expected.empty()) {
+                        REQUIRE(test_cbal_51.pop_front() == expected.front());
+                        expected.erase(expected.begin());
+                    }
+                    break;
+                case 5: if (!expected.empty()) {
+                        REQUIRE(test_cbal_51.replace(element, position) == expected[position]);
+                        expected[position] = element;
+                    }
+                    break;
+                case 6: {
+                    CBL<std::string, power_of_two_policy, std::allocator<std::string>, incremental_growth> copy(test_cbal_51);
+                    REQUIRE(copy.length() == expected.size());
+                    if (!expected.empty()) REQUIRE(copy.item_at(position) == expected[position]);
+                    break;
+                }
+                case 7: test_cbal_51.push_front(element);
+                    expected.insert(expected.begin(), element);
+                    break;
+                case 8: if (!expected.empty()) {
+                        REQUIRE(test_cbal_51.pop_back() == expected.back());
+                        expected.pop_back();
+                    }
+                    break;
+                default: test_cbal_51.push_back(element);
+                    expected.push_back(element);
+            }
+            REQUIRE(test_cbal_51.length() == expected.size());
+            if (!expected.empty()) {
+                REQUIRE(test_cbal_51.item_at(position % expected.size()) == expected[position % expected.size()]);
+                REQUIRE(test_cbal_51.peek_front() == expected.front());
+                REQUIRE(test_cbal_51.peek_back() == expected.back());
+            }
+        }
+        std::vector<std::string> contents;
+        test_cbal_51.copy_to(std::back_inserter(contents));
+        REQUIRE(contents == expected);
+    }
 
 }
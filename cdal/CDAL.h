@@ -1,25 +1,128 @@
 //Simple Singly-Linked List (CDAL)
-//This is the one described in lecture. The idea again is that a linked-list of arrays is used as the backing store. Each array has 50 slots. The chain starts off containing just a single array. When the last array in the chain is filled, and a new item is inserted, a new array is added to the chain.
+//This is the one described in lecture. The idea again is that a linked-list of arrays is used as the backing store. Each array has N slots, where N is the second template parameter (see chunk_capacity below for the default). The chain starts off containing just a single array. When the last array in the chain is filled, and a new item is inserted, a new array is added to the chain.
 //Because we don't want the list to waste too much memory, whenever the more than half of the arrays are unused (they would all be at the end of the chain), deallocate half the unused arrays.
+//The chain is a directory: a contiguous array with a pointer to every array, in order, instead of a next pointer in each array. Any position can then be reached by looking its array up in the directory, and an array holds nothing but its slots.
+//view() hands out the elements in place, one contiguous span per array, and copy_to() copies them into a caller's buffer without allocating.
+//The arrays, the directory and the elements go through the Allocator template parameter (rebound as needed) following std::allocator_traits.
+//on_resize() reports every array added or freed, with its wall time, to a callback.
+//Built with COP3530_INSTRUMENT, stats() reports the elements written and shifted, the calls to the allocator, the arrays allocated and every time the directory grew.
 // by Iago Patiño López
 // with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
 
 #ifndef CDAL_H
 #define CDAL_H
+#include <algorithm>
+#include <cstddef>
 #include <stdexcept>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
 #include "List.h"
 
-template <typename E>
+template <typename E, std::size_t N>
 struct array_node {
-    E datum[50];
-    array_node* next;
+    E datum[N]; //The list's directory, not a next pointer, says which array follows, so the array is exactly N slots
 };
 
 namespace cop3530 {
 
+    //The default number of slots per array: the largest power of two whose array still fits in a 4096 byte page, but never fewer than 8 slots.
+    //array_node holds nothing else, so for an element whose size is a power of two up to 512 bytes the array is exactly one page.
+    //Because it is a power of two and a compile-time constant, every position / N and position % N compiles to a shift and a mask.
+
+    constexpr std::size_t floor_power_of_two(std::size_t n, std::size_t power = 1) {
+        return power * 2 > n ? power : floor_power_of_two(n, power * 2);
+    }
+
     template <typename E>
-    class CDAL : public List<E> { //We need to create the list class
+    struct chunk_capacity {
+        static constexpr std::size_t value = 4096 / sizeof (E) < 8 ? 8 : floor_power_of_two(4096 / sizeof (E));
+    };
+
+    //The live contents of a CDAL without copying them: a range of spans, one per column(array) in order, each full except perhaps the last.
+    //It only holds a pointer into the list's directory, so it is as cheap to pass around as the spans themselves.
+
+    template <typename T, std::size_t N>
+    class chunk_range {
+        using node_type = array_node<typename std::remove_const<T>::type, N>;
+
+    public:
+
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = span<T>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = span<T>; //The spans are made on the fly, so they are handed out by value
+
+            iterator() : column(nullptr), remaining(0) {
+            }
+
+            iterator(node_type * const *column, std::size_t remaining) : column(column), remaining(remaining) {
+            }
+
+            reference operator*() const {
+                return span<T>(column[0]->datum, remaining < N ? remaining : N);
+            }
+
+            iterator& operator++() {
+                remaining -= remaining < N ? remaining : N;
+                ++column;
+                return *this;
+            }
+
+            iterator operator++(int) {
+                iterator result(*this);
+                ++*this;
+                return result;
+            }
+
+            bool operator==(const iterator& rhs) const {
+                return column == rhs.column;
+            }
+
+            bool operator!=(const iterator& rhs) const {
+                return column != rhs.column;
+            }
+
+        private:
+            node_type * const *column; //The directory entry of the column(array) the current span covers
+            std::size_t remaining; //The number of elements from that column(array) to the end of the list
+        };
+
+        chunk_range(node_type * const *directory, std::size_t elements) : directory(directory), elements(elements) {
+        }
+
+        iterator begin() const {
+            return iterator(directory, elements);
+        }
+
+        iterator end() const {
+            return iterator(directory + chunks(), 0);
+        }
+
+        std::size_t chunks() const { //The number of spans
+            return (elements + N - 1) / N;
+        }
+
+        std::size_t size() const { //The number of elements
+            return elements;
+        }
+
+        bool empty() const {
+            return elements == 0;
+        }
+
+    private:
+        node_type * const *directory;
+        std::size_t elements;
+    };
+
+    template <typename E, std::size_t N = chunk_capacity<E>::value, typename Allocator = std::allocator<E> >
+    class CDAL : public static_list<CDAL<E, N, Allocator>, E> { //We need to create the list class
 
     public:
 
@@ -27,114 +130,178 @@ namespace cop3530 {
         class CDAL_Iter {
         public:
             // type aliases required for C++ iterator compatibility
-            using value_type = T;
+            using value_type = typename std::remove_const<T>::type;
             using reference = T&;
             using pointer = T*;
             using difference_type = std::ptrdiff_t;
-            using iterator_category = std::forward_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag;
 
             // type aliases for prettier code
             using self_type = CDAL_Iter;
             using self_reference = CDAL_Iter&;
+            using node_type = array_node<typename std::remove_const<T>::type, N>;
 
         private:
-            array_node<T> *head;
-            int index; //This is the index at which the iterator is
-            int array_size;
+            node_type **column; //This is the directory entry of the column(array) in which the element the iterator is pointing at lives
+            node_type *here; //This is that column(array) itself, cached so that dereferencing does not go through the directory
+            std::size_t index; //This is the row of that element within its column(array)
+
+            template <typename U>
+            friend class CDAL_Iter;
+
+            void move_by(difference_type n) { //Moves the iterator n positions, jumping straight to the right column(array) through the directory
+                difference_type offset = difference_type(index) + n;
+                difference_type columns = offset >= 0 ? offset / difference_type(N) : -((-offset - 1) / difference_type(N)) - 1;
+                column += columns;
+                index = std::size_t(offset - columns * difference_type(N));
+                here = *column;
+            }
+
         public:
 
-            explicit CDAL_Iter(int start = 0, array_node<T> *array = 0, int size = 50) : index(start), head(array), array_size(50) { //This is the explicit constructor for the iterator class. It does not allow implicit conversions or copy-initialization.
+            explicit CDAL_Iter(node_type **entry = nullptr, std::size_t start = 0) : column(entry), here(entry ? *entry : nullptr), index(start) { //This is the explicit constructor for the iterator class. It does not allow implicit conversions or copy-initialization.
+            }
+
+            CDAL_Iter(const CDAL_Iter& src) : column(src.column), here(src.here), index(src.index) { //This is the regular constructor for the iterator class
             }
 
-            CDAL_Iter(const CDAL_Iter& src) : index(src.index), head(src.head), array_size(src.array_size) { //This is the regular constructor for the iterator class
+            template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+            CDAL_Iter(const CDAL_Iter<U>& src) : column(src.column), here(src.here), index(src.index) { //An iterator converts to a const_iterator
             }
 
             reference operator*() const {
-                array_node<T> *curr = head;
-                int count = 0;
-                T *value;
-                while (curr) {
-                    for (int i = 0; i < array_size; i++)
-                        if (count++ == this->index) value = &curr->datum[i];
-                    curr = curr->next;
-                }
-                return *value;
+                return here->datum[index];
             }
 
             pointer operator->() const {
-                array_node<T> *curr = head;
-                int count = 0;
-                while (curr) {
-                    for (int i = 0; i < array_size; i++)
-                        if (count++ == this->index) return &curr->datum[i];
-                    curr = curr->next;
-                }
-                return nullptr;
+                return &here->datum[index];
+            }
+
+            reference operator[](difference_type n) const {
+                return *(*this + n);
             }
 
             self_reference operator=(CDAL_Iter<T> const& src) {
-                index = CDAL_Iter(src).index;
-                head = CDAL_Iter(src).head;
-                array_size = CDAL_Iter(src).array_size;
+                column = src.column;
+                here = src.here;
+                index = src.index;
                 return *this;
             }
 
             self_reference operator++() { //Returns the modified iterator
-                index = index + 1;
+                if (++index == N) { //If we walked off the end of the column(array), continue at the start of the next one
+                    here = *++column;
+                    index = 0;
+                }
                 return *this;
             } // preincrement
 
             self_type operator++(int) {
                 CDAL_Iter temp(*this);
-                index = index + 1;
+                ++(*this);
                 return temp;
             } // postincrement
 
+            self_reference operator--() {
+                if (index-- == 0) { //If we walked off the start of the column(array), continue at the end of the previous one
+                    here = *--column;
+                    index = N - 1;
+                }
+                return *this;
+            } // predecrement
+
+            self_type operator--(int) {
+                CDAL_Iter temp(*this);
+                --(*this);
+                return temp;
+            } // postdecrement
+
+            self_reference operator+=(difference_type n) {
+                move_by(n);
+                return *this;
+            }
+
+            self_reference operator-=(difference_type n) {
+                move_by(-n);
+                return *this;
+            }
+
+            self_type operator+(difference_type n) const {
+                CDAL_Iter temp(*this);
+                return temp += n;
+            }
+
+            friend self_type operator+(difference_type n, CDAL_Iter<T> const& it) {
+                return it + n;
+            }
+
+            self_type operator-(difference_type n) const {
+                CDAL_Iter temp(*this);
+                return temp -= n;
+            }
+
+            difference_type operator-(CDAL_Iter<T> const& rhs) const {
+                return (column - rhs.column) * difference_type(N) + (difference_type(index) - difference_type(rhs.index));
+            }
+
             bool operator==(CDAL_Iter<T> const& rhs) const {
-                if (index == rhs.index && head == rhs.head && array_size == rhs.array_size)
-                    return true;
-                else
-                    return false;
+                return column == rhs.column && index == rhs.index;
             }
 
             bool operator!=(CDAL_Iter<T> const& rhs) const {
-                if (index != rhs.index || head != rhs.head || array_size != rhs.array_size)
-                    return true;
-                else
-                    return false;
+                return column != rhs.column || index != rhs.index;
             }
 
-        }; // end SDAL_Iter
+            bool operator<(CDAL_Iter<T> const& rhs) const {
+                return *this - rhs < 0;
+            }
+
+            bool operator>(CDAL_Iter<T> const& rhs) const {
+                return rhs < *this;
+            }
+
+            bool operator<=(CDAL_Iter<T> const& rhs) const {
+                return !(rhs < *this);
+            }
+
+            bool operator>=(CDAL_Iter<T> const& rhs) const {
+                return !(*this < rhs);
+            }
+
+        }; // end CDAL_Iter
 
         using size_t = std::size_t; // you may comment out this line if your compiler complains
         using value_type = E;
         using iterator = CDAL_Iter<E>; //When we use the word iterator, we mean the iterator class
         using const_iterator = CDAL_Iter<E const>;
 
+        using allocator_type = Allocator;
+
         //operations
         CDAL(); //This is the constructor method of the singly linked list
+        explicit CDAL(const Allocator& allocator); //Constructs an empty list whose arrays come from the given allocator
         CDAL(const CDAL& other); //copy constructor
         CDAL(CDAL&& other); //move constructor
         ~CDAL(); //This is the destructor method of the singly linked list
 
         iterator begin() {
             if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
-            return CDAL_Iter<E>(0, head_node, default_size);
+            return iterator(&directory[0], 0);
         }
 
         iterator end() {
             if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
-            return CDAL_Iter<E>(tail_index, head_node, default_size);
+            return iterator(&directory[tail_index / default_size], tail_index % default_size);
         }
 
         const_iterator begin() const {
-            if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
-            return CDAL_Iter<E>(0, &head_node, default_size);
+            if (tail_index == 0) throw std::runtime_error("Sorry, but the list is empty");
+            return const_iterator(&directory[0], 0);
         }
 
         const_iterator end() const {
-            if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
-            return CDAL_Iter<E>(tail_index, &head_node, default_size);
+            if (tail_index == 0) throw std::runtime_error("Sorry, but the list is empty");
+            return const_iterator(&directory[tail_index / default_size], tail_index % default_size);
         }
         CDAL & operator=(const CDAL & other);
         CDAL & operator=(CDAL&& other);
@@ -153,115 +320,203 @@ namespace cop3530 {
         size_t length(void); //Returns the number of elements in the list as a size_t
         void clear(void); //removes all elements from the list
         bool contains(E element, bool (*equals_function)(const E&, const E&)); //returns true IFF at least one of the elements of the list matches the specified element
+        template <typename Predicate>
+        int find_if(Predicate predicate); //Returns the position of the first element for which predicate(element) is true, or -1 if there is none
+        bool contains(const E& element); //returns true IFF at least one of the elements of the list is == to the specified element
+        template <typename Equals>
+        bool contains(const E& element, Equals equals); //returns true IFF equals(list element, element) holds for at least one of the elements. Any callable works, and the compiler can inline it.
         void print(std::ostream& o); //If the list is empty, inserts "<empty list>" into the ostream; otherwise, inserts, enclosed in square brackets, the list's elements, separated by commas, in sequential order
 
         E * const contents(); //Allocates, initializes, and returns an array containing a copy of the list's elements in sequential order
+        template <typename OutputIt>
+        OutputIt copy_to(OutputIt out); //Writes the elements, in sequential order, through out (a caller's buffer, a back_inserter...) and returns it past the last one. Allocates nothing.
+        chunk_range<E, N> view(); //Returns the elements in place, one contiguous span per column(array), without copying them. Adding or removing elements invalidates the view.
+        chunk_range<const E, N> view() const;
+
+        void swap(CDAL& other); //Exchanges the contents of the two lists. The allocators are exchanged too if they propagate on swap; otherwise they must compare equal.
+        allocator_type get_allocator() const; //Returns a copy of the allocator
+        list_stats stats() const; //What the list's operations have done so far. All zeros unless built with COP3530_INSTRUMENT.
+        void on_resize(resize_listener listener, void *context = nullptr); //Calls listener(event, context) after every resize, see resize_event. nullptr stops it.
 
     private:
+        using traits = std::allocator_traits<Allocator>;
+        using column_allocator = typename traits::template rebind_alloc<array_node<E, N> >;
+        using directory_allocator = typename traits::template rebind_alloc<array_node<E, N> *>;
+
         //variables
-        array_node<E> *head_node; //This pointer points at the first node, not the first element of the list
+        Allocator allocator;
+        array_node<E, N> *head_node; //This pointer points at the first node, not the first element of the list
+        array_node<E, N> **directory; //directory[i] points at column(array) i of the chain. The entry after the last column is always nullptr
+        size_t directory_size; //This is the number of entries the directory has room for
+        size_t column_count; //This is the number of columns(arrays) in the chain
         int tail_index; //This is the index of one pass the last element of the list
-        size_t const default_size = 50; //This is the default size of each array
+        static constexpr size_t default_size = N; //This is the size of each array
+        resize_notifier notifier; //See on_resize()
+#ifdef COP3530_INSTRUMENT
+        list_stats instrumentation;
+#endif
 
         int last_element_column(); //This tells you in which node(array) the tail is, starting at 0
         int last_element_row(); //Within the column(array) in which tail is, this tells you at which index is the tail
+        E& element_at(size_t position); //Returns the slot that holds the given position, found through the directory
+        void add_column(); //Allocates a new column(array) at the end of the chain and records it in the directory
+        void release_columns(size_t keep); //Deallocates every column(array) after the first keep ones
+        void start_chain(); //Gives an empty list a directory with a single column(array)
+        void release_chain(); //Deallocates every column(array) and the directory
+        array_node<E, N> **allocate_directory(size_t entries); //Returns a directory with every entry set to nullptr
+        void deallocate_directory(array_node<E, N> **entries, size_t count);
         void adjust_size(); //Whenever we have more than one empty array, it deallocates arrays until there is only one empty array
     };
 
     //==============================================================================
     // ------- constructor
 
-    template <typename E>
-    CDAL<E>::CDAL() {
+    template <typename E, std::size_t N, typename Allocator>
+    CDAL<E, N, Allocator>::CDAL() : CDAL(Allocator()) {
+    }
+
+    template <typename E, std::size_t N, typename Allocator>
+    CDAL<E, N, Allocator>::CDAL(const Allocator& allocator) : allocator(allocator) {
         tail_index = 0; //We shall start at index 0
-        head_node = new array_node<E>;
+        start_chain();
     }
 
     //==============================================================================
     // ------- copy constructor
 
-    template <typename E>
-    CDAL<E>::CDAL(const CDAL& other) {
+    template <typename E, std::size_t N, typename Allocator>
+    CDAL<E, N, Allocator>::CDAL(const CDAL& other) : allocator(traits::select_on_container_copy_construction(other.allocator)) {
         tail_index = other.tail_index;
+        directory_size = other.directory_size;
+        directory = allocate_directory(directory_size);
+        column_count = 0;
 
         //Create the necessary nodes
-        head_node = new array_node<E>;
-        array_node<E> *temp = head_node;
-        for (int i = 0; i < (other.tail_index - 1) / other.default_size; i++) {
-            temp->next = new array_node<E>;
-            temp = temp->next;
-        }
+        do {
+            add_column();
+        } while (column_count * default_size < other.tail_index);
+        head_node = directory[0];
 
         //Copy the data
-        array_node<E> *new_temp = head_node;
-        array_node<E> *old_temp = other.head_node;
-        for (int i = 0; i <= (other.tail_index - 1) / other.default_size; i++) { //for every column
-            for (int i = 0; i < default_size; i++) { //for every row
-                new_temp->datum[i] = old_temp->datum[i];
-            }
-            new_temp = new_temp->next;
-            old_temp = old_temp->next;
-        }
+        for (int i = 0; i < tail_index; i++)
+            element_at(i) = other.directory[i / default_size]->datum[i % default_size];
     }
 
     //==============================================================================
     // ------- copy-assignment operator
 
-    template <typename E>
-    CDAL<E> &
-    CDAL<E>::operator=(const CDAL & other) {
+    template <typename E, std::size_t N, typename Allocator>
+    CDAL<E, N, Allocator> &
+    CDAL<E, N, Allocator>::operator=(const CDAL & other) {
+        if (this == &other) return *this;
+        if (traits::propagate_on_container_copy_assignment::value && allocator != other.allocator) { //Our arrays must go back to the allocator they came from
+            release_chain();
+            assign_allocator(allocator, other.allocator, typename traits::propagate_on_container_copy_assignment());
+            start_chain();
+        }
         tail_index = other.tail_index;
 
-        //Create the necessary nodes
-        head_node = new array_node<E>;
-        array_node<E> *temp = head_node;
-        for (int i = 0; i < (other.tail_index - 1) / other.default_size; i++) {
-            temp->next = new array_node<E>;
-            temp = temp->next;
-        }
+        //Create the necessary nodes, reusing the ones we already have
+        while (column_count * default_size < other.tail_index)
+            add_column();
 
         //Copy the data
-        array_node<E> *new_temp = head_node;
-        array_node<E> *old_temp = other.head_node;
-        for (int i = 0; i <= (other.tail_index - 1) / other.default_size; i++) { //for every column
-            for (int i = 0; i < default_size; i++) { //for every row
-                new_temp->datum[i] = old_temp->datum[i];
-            }
-            new_temp = new_temp->next;
-            old_temp = old_temp->next;
-        }
+        for (int i = 0; i < tail_index; i++)
+            element_at(i) = other.directory[i / default_size]->datum[i % default_size];
+        this->adjust_size();
         return *this;
     }
     // ------  move constructor
 
-    template <typename E>
-    CDAL<E>::CDAL(CDAL&& other) {
+    template <typename E, std::size_t N, typename Allocator>
+    CDAL<E, N, Allocator>::CDAL(CDAL&& other) : allocator(other.allocator) {
         head_node = other.head_node;
+        directory = other.directory;
+        directory_size = other.directory_size;
+        column_count = other.column_count;
         tail_index = other.tail_index;
 
         other.tail_index = 0;
-        other.head_node = new array_node<E>;
+        other.start_chain();
     }
 
     // ------- move assignment operator
 
-    template <typename E>
-    CDAL<E> &
-    CDAL<E>::operator=(CDAL&& other) {
+    template <typename E, std::size_t N, typename Allocator>
+    CDAL<E, N, Allocator> &
+    CDAL<E, N, Allocator>::operator=(CDAL&& other) {
         if (this != &other) {
-            head_node = other.head_node;
-            tail_index = other.tail_index;
-
-            other.tail_index = 0;
-            other.head_node = new array_node<E>;
+            if (traits::propagate_on_container_move_assignment::value || allocator == other.allocator) {
+                //Swap the chains (and, if it propagates, the allocator they came from), so that other releases ours when it is destroyed
+                swap_allocator(allocator, other.allocator, typename traits::propagate_on_container_move_assignment());
+                std::swap(head_node, other.head_node);
+                std::swap(directory, other.directory);
+                std::swap(directory_size, other.directory_size);
+                std::swap(column_count, other.column_count);
+                tail_index = other.tail_index;
+            } else { //Our allocator cannot free the other list's arrays, so the elements are moved into arrays of our own
+                clear();
+                for (int i = 0; i < other.tail_index; i++)
+                    push_back(std::move(other.element_at(i)));
+            }
+            other.clear();
         }
         return *this;
     }
 
     // ------  destructor
 
-    template <typename E>
-    CDAL<E>::~CDAL() {
+    template <typename E, std::size_t N, typename Allocator>
+    CDAL<E, N, Allocator>::~CDAL() {
+        release_chain();
+    }
+
+    //==============================================================================
+    // --------- start_chain()
+
+    template <typename E, std::size_t N, typename Allocator>
+    void
+    CDAL<E, N, Allocator>::start_chain() {
+        directory_size = 8;
+        directory = allocate_directory(directory_size);
+        column_count = 0;
+        add_column();
+        head_node = directory[0];
+    }
+
+    //==============================================================================
+    // --------- release_chain()
+
+    template <typename E, std::size_t N, typename Allocator>
+    void
+    CDAL<E, N, Allocator>::release_chain() {
+        release_columns(0); //Deallocate every column(array) of the chain
+        deallocate_directory(directory, directory_size);
+    }
+
+    //==============================================================================
+    // --------- allocate_directory()
+
+    template <typename E, std::size_t N, typename Allocator>
+    array_node<E, N> **
+    CDAL<E, N, Allocator>::allocate_directory(size_t entries) {
+        directory_allocator directories(allocator);
+        array_node<E, N> **result = std::allocator_traits<directory_allocator>::allocate(directories, entries);
+        COP3530_COUNT(allocations, 1);
+        for (size_t i = 0; i < entries; i++)
+            result[i] = nullptr;
+        return result;
+    }
+
+    //==============================================================================
+    // --------- deallocate_directory()
+
+    template <typename E, std::size_t N, typename Allocator>
+    void
+    CDAL<E, N, Allocator>::deallocate_directory(array_node<E, N> **entries, size_t count) {
+        directory_allocator directories(allocator);
+        std::allocator_traits<directory_allocator>::deallocate(directories, entries, count);
+        COP3530_COUNT(frees, 1);
     }
 
     //==============================================================================
@@ -271,53 +526,106 @@ namespace cop3530 {
     //==============================================================================
     // --------- adjust_size()
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     void
-    CDAL<E>::adjust_size() {
-        //The following six lines count the number of nodes there are
-        size_t number_of_existing_nodes = 0;
-        array_node<E> *curr = head_node;
-        while (curr) {
-            curr = curr->next; //Move to the next node
-            number_of_existing_nodes++; //Add an existing node
+    CDAL<E, N, Allocator>::adjust_size() {
+        //The following section deletes the excess nodes
+        if (column_count - tail_index / default_size > 2) { //If more than one array is empty
+            resize_notifier::clock::time_point const started = notifier.start();
+            size_t const old_columns = column_count;
+            release_columns(tail_index / default_size + 2); //We keep a single empty array after the tail column
+            notifier.finish(started, old_columns * default_size, column_count * default_size, tail_index, 0); //Nothing is moved
         }
+    }
 
-        //The following section deletes the excess nodes
-        if (number_of_existing_nodes - tail_index / default_size > 2) { //If more than one array is empty
-            array_node<E> *curr2 = head_node;
-            array_node<E> *to_delete;
-            for (int i = 0; i < number_of_existing_nodes; i++) { //For each existing node
-                to_delete = curr2;
-                curr2 = curr2->next;
-                if (i > ((tail_index / default_size) + 1)) delete to_delete;
-            }
+    //==============================================================================
+    // --------- element_at()
+
+    template <typename E, std::size_t N, typename Allocator>
+    E&
+    CDAL<E, N, Allocator>::element_at(size_t position) {
+        return directory[position / default_size]->datum[position % default_size];
+    }
+
+    //==============================================================================
+    // --------- add_column()
+
+    template <typename E, std::size_t N, typename Allocator>
+    void
+    CDAL<E, N, Allocator>::add_column() {
+        resize_notifier::clock::time_point const started = notifier.start();
+        size_t moved_bytes = 0;
+        if (column_count + 1 >= directory_size) { //The directory must keep room for the nullptr entry after the last column
+            size_t new_directory_size = directory_size * 2;
+            array_node<E, N> **new_directory = allocate_directory(new_directory_size);
+            for (size_t i = 0; i < column_count; i++)
+                new_directory[i] = directory[i];
+            deallocate_directory(directory, directory_size);
+            directory = new_directory;
+            directory_size = new_directory_size;
+            COP3530_COUNT(resizes, 1);
+            moved_bytes = column_count * sizeof (array_node<E, N> *);
+            COP3530_COUNT(resize_bytes, moved_bytes);
+        }
+        column_allocator columns(allocator);
+        array_node<E, N> *column = std::allocator_traits<column_allocator>::allocate(columns, 1);
+        size_t constructed = 0;
+        try {
+            for (; constructed < default_size; constructed++) //Every slot of an array holds an element, used or not
+                traits::construct(allocator, &column->datum[constructed]);
+        } catch (...) {
+            while (constructed > 0)
+                traits::destroy(allocator, &column->datum[--constructed]);
+            std::allocator_traits<column_allocator>::deallocate(columns, column, 1);
+            throw;
+        }
+        directory[column_count++] = column;
+        COP3530_COUNT(allocations, 1);
+        COP3530_COUNT(chunk_allocations, 1);
+        notifier.finish(started, (column_count - 1) * default_size, column_count * default_size, tail_index, moved_bytes);
+    }
+
+    //==============================================================================
+    // --------- release_columns()
+
+    template <typename E, std::size_t N, typename Allocator>
+    void
+    CDAL<E, N, Allocator>::release_columns(size_t keep) {
+        column_allocator columns(allocator);
+        while (column_count > keep) {
+            array_node<E, N> *column = directory[--column_count];
+            for (size_t i = 0; i < default_size; i++)
+                traits::destroy(allocator, &column->datum[i]);
+            std::allocator_traits<column_allocator>::deallocate(columns, column, 1);
+            COP3530_COUNT(frees, 1);
+            directory[column_count] = nullptr;
         }
     }
 
     //==============================================================================
     // --------- row  ------------------------------------------------------------------------------ IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     int
-    CDAL<E>::last_element_row() {
+    CDAL<E, N, Allocator>::last_element_row() {
         return (tail_index - 1) % default_size; //Returns the row in which the last list element is, starting at 0
     }
 
     //==============================================================================
     // --------- column()  ------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     int
-    CDAL<E>::last_element_column() {
+    CDAL<E, N, Allocator>::last_element_column() {
         return (tail_index - 1) / default_size; //Returns the node (column) in which the last list element is, starting at 0
     }
 
     //==============================================================================
     // --------- insert() -------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     void
-    CDAL<E>::insert(E element, int position) {
+    CDAL<E, N, Allocator>::insert(E element, int position) {
         if (position == 0) { //If we are inserting at the front, just push front
             push_front(element);
             return;
@@ -330,68 +638,28 @@ namespace cop3530 {
         //If we are trying to insert further than tail or a negative position, throw an error
         if (position > tail_index || position < 0) throw std::runtime_error("Sorry, cannot insert() outiside the boundaries of the list");
 
-        array_node<E> *insertion_array; //This will be a pointer to the insertion column
-        int insertion_column = position / default_size; //This is the column at which insertion must occur
-        int insertion_row = position % default_size; //This is the row at which insertion must occur
-        array_node<E> *curr_array = head_node;
-        E temp1;
-        E temp2;
-        //The following for loop is used to move every element after the insert position one spot (including the insert position itself) so that there can be enough space for the new element
-        for (int column = 0; column <= last_element_column(); column++) { //For every column(array) in which there are elements
-            if (column == insertion_column) insertion_array = curr_array; //If we are in the column(array) at which we want to insert, tag it as the insertion_array
-            if (curr_array->next == nullptr && last_element_row() >= default_size - 2) curr_array->next = new array_node<E>; //If there is no more space, add a column(array)
-
-            if (column >= insertion_column) { //If we are in the column(array) at which we want to insert or further
-                if (column == insertion_column && column != last_element_column()) { //If we are in the right column for insertion but not in the tail column
-                    for (int row = insertion_row; row < 50; row++) {
-                        if (!(row % 2)) {//If the row is an even number
-                            temp1 = curr_array->datum[row];
-                            curr_array->datum[row] = temp2;
-                        } else {//If the row is an odd number
-                            temp2 = curr_array->datum[row];
-                            curr_array->datum[row] = temp1;
-                        }
-                    }
-                } else if (column == insertion_column && column == last_element_column()) { //If we are in the right column for insertion and not in the tail column
-                    for (int row = insertion_row; row <= last_element_row() + 1; row++) {
-
-                        if (!(row % 2)) {//If row is even
-                            temp1 = curr_array->datum[row];
-                            curr_array->datum[row] = temp2;
-                        } else { //If current row is odd
-                            temp2 = curr_array->datum[row];
-                            curr_array->datum[row] = temp1;
-                        }
-                    }
-                } else { //If we have passed the column of insertion
-                    for (int row = 0; row < default_size; row++) {
-                        if (!(row % 2)) {//If the row is even
-                            temp1 = curr_array->datum[row];
-                            curr_array->datum[row] = temp2;
-                        } else {
-                            temp2 = curr_array->datum[row];
-                            curr_array->datum[row] = temp1;
-                        }
-                    }
-                }
-            }
-            curr_array = curr_array->next; //Move to the next column(array)
-        }
+        if (tail_index / default_size >= column_count) add_column(); //If there is no more space, add a column(array)
+
+        //Move every element after the insert position (including the insert position itself) one spot so that there can be enough space for the new element
+        for (int i = tail_index; i > position; i--)
+            element_at(i) = element_at(i - 1);
+        COP3530_COUNT(moves, tail_index - position);
+        COP3530_COUNT(copies, 1);
 
         tail_index++;
-        insertion_array->datum[insertion_row] = element; //This inserts the element at the right position
+        element_at(position) = element; //This inserts the element at the right position
     }
 
     //==============================================================================
     // --------- contents() -------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     E * const
-    CDAL<E>::contents() {
+    CDAL<E, N, Allocator>::contents() {
         E *contents = new E[tail_index];
         int index = 0;
-        array_node<E> *curr = head_node;
         for (int column = 0; column <= last_element_column(); column++) {
+            array_node<E, N> *curr = directory[column];
             if (column != last_element_column()) {
                 for (int row = 0; row < default_size; row++)
                     contents[index++] = curr->datum[row];
@@ -399,58 +667,62 @@ namespace cop3530 {
                 for (int row = 0; row <= last_element_row(); row++)
                     contents[index++] = curr->datum[row];
             }
-            curr = curr->next;
         }
         return contents;
     }
 
 
+    //==============================================================================
+    // --------- copy_to()
+
+    template <typename E, std::size_t N, typename Allocator>
+    template <typename OutputIt>
+    OutputIt
+    CDAL<E, N, Allocator>::copy_to(OutputIt out) {
+        for (span<E> chunk : view())
+            out = std::copy(chunk.begin(), chunk.end(), out);
+        return out;
+    }
+
+    //==============================================================================
+    // --------- view()
+
+    template <typename E, std::size_t N, typename Allocator>
+    chunk_range<E, N>
+    CDAL<E, N, Allocator>::view() {
+        return chunk_range<E, N>(directory, tail_index);
+    }
+
+    template <typename E, std::size_t N, typename Allocator>
+    chunk_range<const E, N>
+    CDAL<E, N, Allocator>::view() const {
+        return chunk_range<const E, N>(directory, tail_index);
+    }
+
     //==============================================================================
     // --------- push_back() --------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     void
-    CDAL<E>::push_back(E element) {
-        tail_index++;
-        array_node<E> *current_column = head_node;
-        //The following for-loop navigates to the the column(array) of tail and adds more space if necessary
-        for (int column = 0; column <= last_element_column(); column++) {
-            if (current_column->next == nullptr && last_element_row() == default_size) current_column->next = new array_node<E>; //If there is no more space, add a column(array)
-            if (current_column->next) current_column = current_column->next;
-        }
-
-        current_column->datum[last_element_row()] = element; //Flls the new tail with the new element.
+    CDAL<E, N, Allocator>::push_back(E element) {
+        if (tail_index / default_size >= column_count) add_column(); //If there is no more space, add a column(array)
+        element_at(tail_index++) = element; //Flls the new tail with the new element.
+        COP3530_COUNT(copies, 1);
     }
 
     //==============================================================================
     // --------- push_front() ---------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     void
-    CDAL<E>::push_front(E element) {
-        //The following for-loop navigates to the the column(array) of tail and adds more space if necessary for insertion
-        array_node<E> *current_column = head_node;
-        for (int i = 0; i <= last_element_column(); i++) {
-            if (current_column->next == nullptr && last_element_row() > default_size - 2) current_column->next = new array_node<E>; //If there is no more space, add a column(array)
-            current_column = current_column->next;
-        }
-        tail_index++;
-        E temp1;
-        E temp2;
-        array_node<E> *temp_node = head_node;
+    CDAL<E, N, Allocator>::push_front(E element) {
+        if (tail_index / default_size >= column_count) add_column(); //If there is no more space, add a column(array)
 
-        for (int i = 0; i <= last_element_column(); i++) { //For every column
-            for (int j = 0; j <= default_size - 1; j++) { //For every row
-                if (!(j % 2)) {//If the number is even
-                    temp1 = temp_node->datum[j];
-                    temp_node->datum[j] = temp2;
-                } else {
-                    temp2 = temp_node->datum[j];
-                    temp_node->datum[j] = temp1;
-                }
-            }
-            temp_node = temp_node->next;
-        }
+        for (int i = tail_index; i > 0; i--) //Move every element one spot to the "right"
+            element_at(i) = element_at(i - 1);
+        COP3530_COUNT(moves, tail_index);
+        COP3530_COUNT(copies, 1);
+        tail_index++;
         head_node->datum[0] = element; //This sets the first item of the list to whatever element is
 
     }
@@ -458,59 +730,30 @@ namespace cop3530 {
     //==============================================================================
     // --------- replace() ------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     E
-    CDAL<E>::replace(E element, int position) {
+    CDAL<E, N, Allocator>::replace(E element, int position) {
         if (position > tail_index - 1 || position < 0)
             throw std::runtime_error("The position requested is outside the list size");
-        int column = position / default_size;
-        int row = position % default_size;
-        array_node<E> *temp = head_node;
-        for (int i = 0; i < column; i++) {
-            temp = temp->next;
-        }
-        E eliminate = temp->datum[row];
-        temp->datum[row] = element;
+        E& slot = element_at(position); //The directory takes us straight to the right column(array)
+        E eliminate = slot;
+        slot = element;
+        COP3530_COUNT(copies, 1);
         return eliminate;
     }
 
     //==============================================================================
     // --------- remove() -------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     E
-    CDAL<E>::remove(int position) {
+    CDAL<E, N, Allocator>::remove(int position) {
         if (position > tail_index - 1 || position < 0) throw std::runtime_error("Sorry, cannot remove an item outside the list boundaries");
-        int removal_column = position / default_size;
-        int removal_row = position % default_size;
-        E to_delete;
-        array_node<E> *curr_coulumn = head_node;
-
-        for (int i = 0; i <= last_element_column(); i++) { //For each column until the tail column
-            for (int j = 0; j <= default_size; j++) { // For every row in the column in which we are
-                if (i == removal_column && j == removal_row) {
-                    to_delete = curr_coulumn->datum[removal_row];
-                    if (j == default_size - 1 && curr_coulumn->next) {
-                        curr_coulumn->datum[j] = curr_coulumn->next->datum[0];
-                    } else {
-                        curr_coulumn->datum[j] = curr_coulumn->datum[j + 1];
-                    }
-                } else if (i == removal_column && j >= removal_row) {
-                    if (j == default_size - 1 && curr_coulumn->next) {
-                        curr_coulumn->datum[j] = curr_coulumn->next->datum[0];
-                    } else {
-                        curr_coulumn->datum[j] = curr_coulumn->datum[j + 1];
-                    }
-                } else if (i > removal_column) {
-                    if (j == default_size - 1 && curr_coulumn->next) {
-                        curr_coulumn->datum[j] = curr_coulumn->next->datum[0];
-                    } else {
-                        curr_coulumn->datum[j] = curr_coulumn->datum[j + 1];
-                    }
-                }
-            }
-            curr_coulumn = curr_coulumn->next;
-        }
+        E to_delete = element_at(position);
+
+        for (int i = position; i < tail_index - 1; i++) //Move every element after the removed one one spot to the "left"
+            element_at(i) = element_at(i + 1);
+        COP3530_COUNT(moves, tail_index - 1 - position);
 
         tail_index--;
         this->adjust_size();
@@ -520,16 +763,12 @@ namespace cop3530 {
     //==============================================================================
     // --------- pop_back() ------------------------------------------------------------ IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     E
-    CDAL<E>::pop_back() {
-        array_node<E> *curr = head_node;
-
-        for (int i = 0; i < last_element_column(); i++) curr = curr->next; //Traverse to the tail column(array)
-
-        E back_item = curr->datum[last_element_row()];
+    CDAL<E, N, Allocator>::pop_back() {
+        if (is_empty()) throw std::runtime_error("Sorry, cannot pop an empty list");
 
-        tail_index--;
+        E back_item = element_at(--tail_index);
 
         this->adjust_size();
 
@@ -539,58 +778,39 @@ namespace cop3530 {
     //==============================================================================
     // --------- pop_front() ----------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     E
-    CDAL<E>::pop_front() {
-        E front_object = head_node->datum[0];
-        array_node<E> *temp_node = head_node;
-        for (int i = 0; i <= last_element_column(); i++) {
-            for (int j = 0; j <= default_size; j++) {
-                temp_node->datum[j] = temp_node->datum[j + 1];
-                if (j == default_size - 1 && temp_node->next) {
-                    temp_node->datum[j] = temp_node->next->datum[0];
-                }
-            }
-            temp_node = temp_node->next;
-        }
-        tail_index--;
-        this->adjust_size();
-        return front_object;
+    CDAL<E, N, Allocator>::pop_front() {
+        if (is_empty()) throw std::runtime_error("Sorry, cannot pop an empty list");
+        return remove(0);
     }
 
     //==============================================================================
     // --------- item_at() ------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     E
-    CDAL<E>::item_at(int position) {
+    CDAL<E, N, Allocator>::item_at(int position) {
         if (position > tail_index - 1 || position < 0) throw std::runtime_error("The position requested is outside the list size");
-        int column = position / default_size;
-        int row = position % default_size;
-        array_node<E> *temp = head_node;
-        for (int i = 0; i < column; i++) {
-            temp = temp->next;
-        }
-
-        E indexed = temp->datum[row];
-        return indexed;
+        return element_at(position); //The directory takes us straight to the right column(array)
     }
 
     //==============================================================================
     // --------- peek_back()------------------------------------------------------------ IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     E
-    CDAL<E>::peek_back() {
-        return item_at(tail_index - 1);
+    CDAL<E, N, Allocator>::peek_back() {
+        if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
+        return element_at(tail_index - 1);
     }
 
     //==============================================================================
     // --------- peek_front() ----------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     E
-    CDAL<E>::peek_front() {
+    CDAL<E, N, Allocator>::peek_front() {
         if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
         return head_node->datum[0];
     }
@@ -598,76 +818,102 @@ namespace cop3530 {
     //==============================================================================
     // --------- is_empty() ------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     bool
-    CDAL<E>::is_empty() {
+    CDAL<E, N, Allocator>::is_empty() {
         return (tail_index == 0);
     }
 
     //==============================================================================
     // --------- is_full() -------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     bool
-    CDAL<E>::is_full(void) {
+    CDAL<E, N, Allocator>::is_full(void) {
         return false;
     }
 
     //==============================================================================
     // --------- length() ---------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     size_t
-    CDAL<E>::length() {
+    CDAL<E, N, Allocator>::length() {
         return tail_index;
     }
 
     //==============================================================================
     // --------- clear() ----------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     void
-    CDAL<E>::clear() {
+    CDAL<E, N, Allocator>::clear() {
         tail_index = 0;
-        array_node<E> *temp = head_node;
-        array_node<E> *to_delete;
-        while (temp) {
-            to_delete = temp;
-            temp = temp->next;
-            delete to_delete;
-        }
-        head_node = new array_node<E>;
+        release_columns(1); //We only keep the first column(array)
     }
 
     //==============================================================================
     // --------- contains() -------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     bool
-    CDAL<E>::contains(E element, bool (*equals_function)(const E&, const E&)) {
-        array_node<E> *temp = head_node;
-        for (int i = 0; i <= last_element_column(); i++) {
-            for (int j = 0; j <= default_size - 1; j++) {
-                if (equals_function(temp->datum[j], element) && !(i == last_element_column() && j > last_element_row())) return true;
-            }
-            temp = temp->next;
+    CDAL<E, N, Allocator>::contains(E element, bool (*equals_function)(const E&, const E&)) {
+        return find_if([&](const E& datum) { return equals_function(datum, element); }) != -1;
+    }
+
+    //==============================================================================
+    // --------- find_if()
+
+    template <typename E, std::size_t N, typename Allocator>
+    template <typename Predicate>
+    int
+    CDAL<E, N, Allocator>::find_if(Predicate predicate) {
+        for (size_t position = 0; position < size_t(tail_index); position += default_size) { //One column(array) at a time, through the directory
+            E const *column = directory[position / default_size]->datum;
+            size_t const used = size_t(tail_index) - position < default_size ? size_t(tail_index) - position : default_size;
+            for (size_t j = 0; j < used; j++)
+                if (predicate(column[j])) return int(position + j);
+        }
+        return -1;
+    }
+
+    //==============================================================================
+    // --------- contains() with ==
+
+    template <typename E, std::size_t N, typename Allocator>
+    bool
+    CDAL<E, N, Allocator>::contains(const E& element) {
+        for (size_t position = 0; position < size_t(tail_index); position += default_size) { //Each column(array) is contiguous, so arithmetic elements are compared with SIMD
+            E const *column = directory[position / default_size]->datum;
+            size_t const used = size_t(tail_index) - position < default_size ? size_t(tail_index) - position : default_size;
+            if (find_equal<E>(column, column + used, element) != column + used) return true;
         }
         return false;
     }
 
+    //==============================================================================
+    // --------- contains() with any callable
+
+    template <typename E, std::size_t N, typename Allocator>
+    template <typename Equals>
+    bool
+    CDAL<E, N, Allocator>::contains(const E& element, Equals equals) {
+        return find_if([&](const E& datum) { return equals(datum, element); }) != -1;
+    }
+
     //==============================================================================
     // --------- print() ----------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, std::size_t N, typename Allocator>
     void
-    CDAL<E>::print(std::ostream& o) {
+    CDAL<E, N, Allocator>::print(std::ostream& o) {
         if (is_empty()) {
             o << "<empty list>" << std::endl;
             return;
         }
-        array_node<E> *curr_column = head_node;
         o << "[";
         for (int i = 0; i <= last_element_column(); i++) { //For every column
+            array_node<E, N> *curr_column = directory[i];
             if (i != last_element_column()) { //If we are not in the tail column
                 for (int j = 0; j < default_size; j++) //For every row
                     o << curr_column->datum[j] << ",";
@@ -680,11 +926,54 @@ namespace cop3530 {
                     o << curr_column->datum[j] << ",";
                 }
             }
-            curr_column = curr_column->next;
         }
         o << "]";
     }
 
+
+    //==============================================================================
+    // --------- swap()
+
+    template <typename E, std::size_t N, typename Allocator>
+    void
+    CDAL<E, N, Allocator>::swap(CDAL& other) {
+        swap_allocator(allocator, other.allocator, typename traits::propagate_on_container_swap());
+        std::swap(head_node, other.head_node);
+        std::swap(directory, other.directory);
+        std::swap(directory_size, other.directory_size);
+        std::swap(column_count, other.column_count);
+        std::swap(tail_index, other.tail_index);
+    }
+
+    //==============================================================================
+    // --------- get_allocator()
+
+    template <typename E, std::size_t N, typename Allocator>
+    typename CDAL<E, N, Allocator>::allocator_type
+    CDAL<E, N, Allocator>::get_allocator() const {
+        return allocator;
+    }
+
+    //==============================================================================
+    // --------- stats()
+
+    template <typename E, std::size_t N, typename Allocator>
+    list_stats
+    CDAL<E, N, Allocator>::stats() const {
+#ifdef COP3530_INSTRUMENT
+        return instrumentation;
+#else
+        return list_stats();
+#endif
+    }
+    //==============================================================================
+    // --------- on_resize()
+
+    template <typename E, std::size_t N, typename Allocator>
+    void
+    CDAL<E, N, Allocator>::on_resize(resize_listener listener, void *context) {
+        notifier.listen(listener, context);
+    }
 }
 
 
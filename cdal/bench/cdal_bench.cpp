@@ -0,0 +1,117 @@
+//Chunky Dynamic Array-based List (CDAL) benchmark
+// - Sweeps the number of slots per array for a small, a cache-line sized and a heap-owning element type.
+//
+// by Iago Patiño López
+// Build from this directory with: g++ -std=c++11 -O2 -I .. cdal_bench.cpp -o cdal_bench
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+//List ADTs included below:
+#include "CDAL.h"
+
+using namespace cop3530;
+
+//A 64 byte plain-old-data element, the size of one cache line
+
+struct line {
+    long values[8];
+
+    line(long value = 0) {
+        for (int i = 0; i < 8; i++)
+            values[i] = value;
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, const line& l) { //Every List must be printable
+        return stream << l.values[0];
+    }
+};
+
+long key(int value) {
+    return value;
+}
+
+long key(const line& value) {
+    return value.values[0];
+}
+
+long key(const std::string& value) {
+    return value.size();
+}
+
+template <typename E>
+E make(int value);
+
+template <>
+int make<int>(int value) {
+    return value;
+}
+
+template <>
+line make<line>(int value) {
+    return line(value);
+}
+
+template <>
+std::string make<std::string>(int value) {
+    return std::string(24, 'a' + value % 26); //Long enough to live on the heap
+}
+
+double nanoseconds_since(std::chrono::steady_clock::time_point start, int operations) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / operations;
+}
+
+//Times push_back, a full iteration, scattered item_at and pop_back for one element type and one array capacity
+
+template <typename E, std::size_t N>
+void sweep(const char *type_name, int size) {
+    volatile long sink = 0; //Keeps the compiler from discarding the measured calls
+    CDAL<E, N> list;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < size; i++)
+        list.push_back(make<E>(i));
+    double push = nanoseconds_since(start, size);
+
+    start = std::chrono::steady_clock::now();
+    long sum = 0;
+    for (typename CDAL<E, N>::iterator it = list.begin(); it != list.end(); ++it)
+        sum += key(*it);
+    sink = sink + sum;
+    double iterate = nanoseconds_since(start, size);
+
+    start = std::chrono::steady_clock::now();
+    unsigned position = 1;
+    for (int i = 0; i < size; i++) {
+        position = position * 1103515245u + 12345u; //Cheap pseudo-random positions
+        sink = sink + key(list.item_at(position % size));
+    }
+    double item = nanoseconds_since(start, size);
+
+    start = std::chrono::steady_clock::now();
+    while (!list.is_empty())
+        sink = sink + key(list.pop_back());
+    double pop = nanoseconds_since(start, size);
+
+    std::cout << type_name << "," << sizeof (E) << "," << N << "," << size << "," << push << "," << iterate << "," << item << "," << pop << std::endl;
+}
+
+template <typename E>
+void sweep_all(const char *type_name, int size) {
+    sweep<E, 8>(type_name, size);
+    sweep<E, 50>(type_name, size); //The capacity the list used to hardcode
+    sweep<E, 64>(type_name, size);
+    sweep<E, 256>(type_name, size);
+    sweep<E, 1024>(type_name, size);
+    sweep<E, 4096>(type_name, size);
+    sweep<E, chunk_capacity<E>::value>(type_name, size);
+}
+
+int main() {
+    std::cout << "type,element_bytes,slots_per_array,size,push_back_ns,iterate_ns,item_at_ns,pop_back_ns" << std::endl;
+    sweep_all<int>("int", 1000000);
+    sweep_all<line>("line64", 250000);
+    sweep_all<std::string>("string", 250000);
+    return 0;
+}
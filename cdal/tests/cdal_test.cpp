@@ -4,9 +4,12 @@
 // by Iago Patiño López
 // with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
 #include <iostream>
+#include <vector>
+#include <iterator>
 #include <valarray>
 #include <string>
 #include <sstream>
+#include <type_traits>
 #define DEBUG
 
 //List ADTs included below:
@@ -17,6 +20,7 @@
 //Catch testing file included below:
 #define CATCH_CONFIG_MAIN
 #include "catch.h"
+#include "counting_allocator.h"
 
 using namespace cop3530;
 
@@ -26,6 +30,11 @@ bool equals_function(const int& a, const int& b) {
     return a == b;
 }
 
+//The list the shared allocator checks in counting_allocator.h run on.
+
+template <typename Allocator>
+using cdal_with = CDAL<int, chunk_capacity<int>::value, Allocator>;
+
 class person {
 public:
     int age;
@@ -53,6 +62,22 @@ public:
     }
 };
 
+//Generic code written against the static interface. The calls resolve to the concrete list at compile time.
+//It empties the list from the back, which frees the arrays left unused at the end of the chain as it goes.
+
+template <typename Derived>
+int drain_back_sum(static_list<Derived, int>& list) {
+    int sum = 0;
+    while (!list.is_empty())
+        sum += list.pop_back();
+    return sum;
+}
+
+//Collects the resize events of the on_resize() tests
+void collect_resize(const resize_event& event, void *events) {
+    static_cast<std::vector<resize_event> *>(events)->push_back(event);
+}
+
 TEST_CASE("Testing each method of the CDAL", "[CDAL]") {
 
     //Basic Functions
@@ -424,6 +449,88 @@ TEST_CASE("Testing each method of the CDAL", "[CDAL]") {
 
     }
 
+    SECTION("Testing iteration across several arrays") {
+        CDAL<int> *test_cdal_34 = new CDAL<int>;
+
+        for (int i = 0; i < 500; i++)
+            test_cdal_34->push_back(i);
+
+        int expected = 0;
+        for (cop3530::CDAL<int>::iterator it = test_cdal_34->begin(); it != test_cdal_34->end(); it++)
+            REQUIRE(*it == expected++);
+        REQUIRE(expected == 500);
+
+        const CDAL<int> &constant_cdal = *test_cdal_34;
+        expected = 0;
+        for (cop3530::CDAL<int>::const_iterator it = constant_cdal.begin(); it != constant_cdal.end(); ++it)
+            REQUIRE(*it == expected++);
+        REQUIRE(expected == 500);
+
+        delete test_cdal_34;
+    }
+
+    SECTION("Testing random access across several arrays") {
+        CDAL<int> *test_cdal_35 = new CDAL<int>;
+
+        for (int i = 0; i < 1000; i++)
+            test_cdal_35->push_back(i);
+
+        REQUIRE(test_cdal_35->item_at(999) == 999);
+        REQUIRE(test_cdal_35->peek_back() == 999);
+        REQUIRE(test_cdal_35->replace(-1, 520) == 520);
+        REQUIRE(test_cdal_35->item_at(520) == -1);
+        REQUIRE(test_cdal_35->remove(520) == -1);
+        REQUIRE(test_cdal_35->item_at(520) == 521);
+        test_cdal_35->insert(520, 520);
+
+        cop3530::CDAL<int>::iterator iterator_begin = test_cdal_35->begin();
+        cop3530::CDAL<int>::iterator iterator_end = test_cdal_35->end();
+        REQUIRE(iterator_end - iterator_begin == 1000);
+        REQUIRE(iterator_begin[777] == 777);
+        REQUIRE(*(iterator_end - 1) == 999);
+        REQUIRE(*(iterator_begin + 50) == 50);
+        iterator_begin += 50;
+        REQUIRE(*--iterator_begin == 49);
+        REQUIRE(iterator_begin < iterator_end);
+
+        cop3530::CDAL<int>::const_iterator converted = iterator_begin; //An iterator converts to a const_iterator in the same column(array)
+        REQUIRE(&*converted == &*iterator_begin);
+        REQUIRE(converted + 951 == static_cast<const CDAL<int>&> (*test_cdal_35).end());
+        REQUIRE((std::is_same<std::iterator_traits<cop3530::CDAL<int>::const_iterator>::value_type, int>::value));
+
+        delete test_cdal_35;
+    }
+
+    SECTION("Testing arrays of a chosen capacity") {
+        CDAL<int, 50> *test_cdal_36 = new CDAL<int, 50>;
+        CDAL<std::string, 8> *test_cdal_37 = new CDAL<std::string, 8>;
+
+        for (int i = 0; i < 130; i++) {
+            test_cdal_36->push_back(i);
+            test_cdal_37->push_back(std::to_string(i));
+        }
+        test_cdal_36->push_front(-1);
+        test_cdal_37->push_front("-1");
+
+        REQUIRE(test_cdal_36->length() == 131);
+        REQUIRE(test_cdal_37->length() == 131);
+        REQUIRE(test_cdal_36->item_at(50) == 49);
+        REQUIRE(test_cdal_37->item_at(8) == "7");
+        REQUIRE(test_cdal_36->remove(0) == -1);
+        REQUIRE(test_cdal_37->remove(0) == "-1");
+        REQUIRE(*(test_cdal_36->end() - 1) == 129);
+        REQUIRE(*(test_cdal_37->begin() + 100) == "100");
+        while (test_cdal_37->length() > 1)
+            test_cdal_37->pop_back();
+        REQUIRE(test_cdal_37->peek_back() == "0");
+
+        REQUIRE(sizeof (array_node<int, chunk_capacity<int>::value>) == 4096); //The default array is one page
+        REQUIRE(sizeof (array_node<double, chunk_capacity<double>::value>) == 4096);
+
+        delete test_cdal_37;
+        delete test_cdal_36;
+    }
+
     SECTION("Complex multi-function test") {
         CDAL<int> *test_cdal_25 = new CDAL<int>;
         REQUIRE(test_cdal_25->is_empty());
@@ -615,4 +722,159 @@ TEST_CASE("Testing each method of the CDAL", "[CDAL]") {
         REQUIRE(dtream.str() == "[1,2,3,4,5,6,7,8,9,10,11,12,13,14,99,16,17,18,19,20,21,22,23,24,25,26,27,28,29,30,31,32,33,34,35,36,37,38,39]");
     }
 
+    SECTION("Testing the allocator") {
+        require_allocator_propagation<cdal_with>();
+
+        allocation_log log;
+        typedef counting_allocator<int, true> propagating;
+        typedef CDAL<int, 8, propagating> small_columns;
+        {
+            small_columns test_cdal_38(propagating(1, &log));
+            REQUIRE(log.allocations == 2); //A directory of 8 entries, then the first column
+            REQUIRE(log.bytes == long(8 * sizeof (array_node<int, 8> *) + sizeof (array_node<int, 8>)));
+            REQUIRE(log.last_allocation == sizeof (array_node<int, 8>));
+            REQUIRE(log.constructions == 8); //Every slot of a column holds an element
+            for (int i = 0; i < 8; i++) test_cdal_38.push_back(i);
+            REQUIRE(log.allocations == 2);
+            test_cdal_38.push_back(8);
+            REQUIRE(log.allocations == 3); //The next column only once the last one is full, from the same allocator rebound
+            REQUIRE(log.constructions == 16);
+
+            for (int i = 9; i < 7 * 8; i++) test_cdal_38.push_back(i);
+            REQUIRE(log.deallocations == 0);
+            test_cdal_38.push_back(56); //An eighth column would leave no directory entry for the nullptr after the last one
+            REQUIRE(log.deallocations == 1); //So the directory was doubled first
+            REQUIRE(log.bytes == long(16 * sizeof (array_node<int, 8> *) + 8 * sizeof (array_node<int, 8>)));
+            REQUIRE(test_cdal_38.item_at(56) == 56);
+
+            for (int i = 0; i < 7 * 8; i++) test_cdal_38.pop_back(); //The columns past the tail go back but one, the directory stays as large
+            REQUIRE(log.bytes == long(16 * sizeof (array_node<int, 8> *) + 2 * sizeof (array_node<int, 8>)));
+            REQUIRE(test_cdal_38.peek_front() == 0);
+        }
+        REQUIRE(log.bytes == 0);
+        REQUIRE(log.allocations == log.deallocations);
+    }
+
+    SECTION("Testing the static interface and the virtual adapter") {
+        REQUIRE(is_static_list<CDAL<int> >::value);
+        CDAL<int, 8> test_cdal_44; //Small arrays, so that the elements span several
+        for (int i = 0; i < 100; i++) test_cdal_44.push_back(i);
+        REQUIRE(test_cdal_44.view().chunks() == 13);
+        REQUIRE(drain_back_sum(test_cdal_44) == 4950);
+        REQUIRE(test_cdal_44.is_empty());
+        REQUIRE(test_cdal_44.view().chunks() == 0);
+
+        virtual_list<CDAL<int, 8> > test_cdal_45;
+        List<int>& dynamic = test_cdal_45; //Only the adapter is a List<int>
+        for (int i = 0; i < 20; i++) dynamic.push_back(i);
+        dynamic.push_front(-1);
+        chunk_range<int, 8> columns = test_cdal_45.get().view(); //The CDAL's own members work on the list behind the adapter
+        REQUIRE(columns.chunks() == 3);
+        REQUIRE((*columns.begin()).size() == 8);
+        REQUIRE((*columns.begin())[0] == -1);
+        REQUIRE(dynamic.item_at(8) == 7);
+        REQUIRE(drain_back_sum(test_cdal_45.get()) == 189);
+        REQUIRE(dynamic.is_empty());
+    }
+
+    SECTION("Testing find_if and contains past the first column") {
+        CDAL<int, 16> test_cdal_46; //The search goes column by column through the directory
+        for (int i = 0; i < 20; i++) test_cdal_46.push_back(2 * i);
+        REQUIRE(test_cdal_46.find_if([](const int& x) { return x >= 32; }) == 16); //The first slot of the second column
+        REQUIRE(test_cdal_46.find_if([](const int& x) { return x == 38; }) == 19); //The last one in use
+        REQUIRE(test_cdal_46.contains(34));
+        REQUIRE(test_cdal_46.contains(38));
+        REQUIRE(test_cdal_46.contains(36, [](const int& datum, const int& element) { return datum == element; }));
+        REQUIRE(test_cdal_46.contains(38, equals_function));
+        REQUIRE(!test_cdal_46.contains(40));
+
+        test_cdal_46.pop_back(); //The second column still holds the popped value in a slot past the tail, which the search must not see
+        REQUIRE(!test_cdal_46.contains(38));
+        REQUIRE(test_cdal_46.find_if([](const int& x) { return x == 38; }) == -1);
+        for (int i = 0; i < 3; i++) test_cdal_46.pop_back(); //Down to exactly one full column
+        REQUIRE(!test_cdal_46.contains(32));
+        REQUIRE(test_cdal_46.contains(30));
+
+        CDAL<int, 16> test_cdal_47;
+        REQUIRE(test_cdal_47.find_if([](const int&) { return true; }) == -1);
+        REQUIRE(!test_cdal_47.contains(0));
+        REQUIRE(!test_cdal_47.contains(0, equals_function));
+    }
+
+    SECTION("Testing the chunk view and copy_to") {
+        CDAL<int, 16> test_cdal_48;
+        REQUIRE(test_cdal_48.view().empty());
+        REQUIRE(test_cdal_48.view().begin() == test_cdal_48.view().end());
+        for (int i = 0; i < 40; i++) test_cdal_48.push_back(i);
+        chunk_range<int, 16> chunks = test_cdal_48.view();
+        REQUIRE(chunks.size() == 40);
+        REQUIRE(chunks.chunks() == 3);
+        int expected = 0, spans = 0;
+        for (span<int> chunk : chunks) { //16, 16 and then 8 elements, each contiguous
+            REQUIRE(chunk.size() == (spans < 2 ? 16u : 8u));
+            for (std::size_t i = 0; i < chunk.size(); i++) REQUIRE(chunk[i] == expected++);
+            spans++;
+        }
+        REQUIRE(spans == 3);
+        (*++chunks.begin())[0] = -16; //The view is the list itself, not a copy
+        REQUIRE(test_cdal_48.item_at(16) == -16);
+
+        for (int i = 40; i < 48; i++) test_cdal_48.push_back(i); //A full last column
+        const CDAL<int, 16>& test_cdal_49 = test_cdal_48;
+        chunk_range<const int, 16> read_only = test_cdal_49.view();
+        REQUIRE(read_only.chunks() == 3);
+        chunk_range<const int, 16>::iterator last = read_only.begin();
+        last++;
+        last++;
+        REQUIRE((*last).size() == 16);
+        REQUIRE(++last == read_only.end());
+
+        int buffer[49];
+        buffer[48] = 99;
+        REQUIRE(test_cdal_48.copy_to(buffer) == buffer + 48);
+        REQUIRE(buffer[16] == -16);
+        REQUIRE(buffer[47] == 47);
+        REQUIRE(buffer[48] == 99);
+        std::vector<int> appended;
+        test_cdal_48.copy_to(std::back_inserter(appended));
+        REQUIRE(appended.size() == 48);
+        REQUIRE(appended[31] == 31);
+    }
+
+    SECTION("Testing the instrumentation counters") {
+        CDAL<int, 4> test_cdal_50; //The directory starts with 8 entries, one of them kept for the nullptr after the last array
+        for (int i = 0; i < 29; i++) test_cdal_50.push_back(i); //The eighth array grows the directory
+        test_cdal_50.push_front(-1); //Shifts all 29
+        list_stats counted = test_cdal_50.stats();
+#ifdef COP3530_INSTRUMENT
+        REQUIRE(counted.copies == 30);
+        REQUIRE(counted.moves == 29);
+        REQUIRE(counted.chunk_allocations == 8);
+        REQUIRE(counted.allocations == 8 + 2);
+        REQUIRE(counted.resizes == 1);
+        REQUIRE(counted.resize_bytes == 7 * sizeof (void *));
+        REQUIRE(counted.frees == 1);
+#else
+        REQUIRE(counted.copies == 0); //Not counted at all
+        REQUIRE(counted.chunk_allocations == 0);
+#endif
+    }
+
+    SECTION("Testing the resize events") {
+        CDAL<int, 4> test_cdal_51;
+        std::vector<resize_event> events;
+        test_cdal_51.on_resize(collect_resize, &events);
+        for (int i = 0; i < 29; i++) test_cdal_51.push_back(i); //Seven more arrays. The last one grows the directory too.
+        REQUIRE(events.size() == 7);
+        REQUIRE(events[0].grew);
+        REQUIRE(events[0].old_capacity == 4);
+        REQUIRE(events[0].new_capacity == 8);
+        REQUIRE(events[0].bytes_moved == 0);
+        REQUIRE(events[6].bytes_moved == 7 * sizeof (void *));
+        while (test_cdal_51.length() > 3) test_cdal_51.pop_back(); //Frees arrays, keeping a single empty one after the tail
+        REQUIRE(events.size() > 7);
+        REQUIRE_FALSE(events.back().grew);
+        REQUIRE(events.back().new_capacity == 8);
+    }
+
 }
@@ -1,21 +1,440 @@
 //Simple Singly-Linked List (PSLL)
 // Similar to the SSLL, except the node allocation/deallocation strategy is different. The list maintains a pool of unused nodes. Whenever an item is added to the list, use a node from the pool of free nodes; if there are no free nodes, then a new node is allocated. Whenever an item is removed, the node is added to the pool.
 //Because we don't want the pool to waste too much memory, whenever the list contains ≥ 100 items AND the pool contains more nodes than half the list size, reduce the number of pool nodes to half the list size (by deallocating the excess).
+//When to trim the pool, and down to how many nodes, comes from the trim policy (the second template parameter). half_length_trim is the rule above;
+//fixed_cap_trim, watermark_trim and never_trim suit other workloads, and reserve() and shrink_pool() let the user warm the pool up or empty it.
+//Nodes are not allocated one at a time: they are carved, in order, out of slabs of 64 to 4096 nodes, so the nodes of a list sit next to each other in memory and the allocator is called once per slab.
+//A node's element is constructed when the node leaves the pool and destroyed when it goes back. Since a slab can only be deallocated as a whole, trimming the pool releases the slabs that are entirely free.
+//With the shared_pool policy a list keeps no pool of its own: all such lists of the same element type draw from one process-wide pool, split into one segment per thread (see shared_node_pool below).
+//insert_after(), emplace_after(), erase_after() and splice_after() edit the list in O(1) right after an iterator, as std::forward_list does. Splicing from another list
+//relinks the nodes, so both lists must be on the shared pool: otherwise the nodes belong to the other list's slabs, and splice_after() throws rather than copy them.
+//Slabs, and the elements in them, go through the Allocator template parameter following std::allocator_traits. The shared pool is process-wide, so it does not use the list's allocator.
+//Built with COP3530_INSTRUMENT, stats() also reports the links followed, the elements written, the calls to the allocator and the pool hits and misses (see list_stats in List.h).
 //
 // by Iago Patiño López
 // with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
 
 #ifndef PSLL_H
 #define PSLL_H
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <new>
 #include <stdexcept>
 #include <iostream>
+#include <type_traits>
+#include <utility>
 #include "List.h"
 
 
 namespace cop3530 {
 
+    //==============================================================================
+    // trim policies
+
+    //Trims the pool whenever the list contains at least MinLength items and the pool contains more than Numerator / Denominator of the list size, down to that fraction.
+
+    template <std::size_t Numerator, std::size_t Denominator, std::size_t MinLength = 0 >
+    struct length_ratio_trim {
+        static bool over_limit(std::size_t pooled, std::size_t length) {
+            return length >= MinLength && pooled > trim_to(pooled, length);
+        }
+
+        static std::size_t trim_to(std::size_t, std::size_t length) {
+            return length * Numerator / Denominator;
+        }
+    };
+
+    //The rule described above: with ≥ 100 items, keep at most half the list size in the pool.
+
+    using half_length_trim = length_ratio_trim<1, 2, 100>;
+
+    //Never lets the pool hold more than Cap nodes.
+
+    template <std::size_t Cap>
+    struct fixed_cap_trim {
+        static bool over_limit(std::size_t pooled, std::size_t) {
+            return pooled > Cap;
+        }
+
+        static std::size_t trim_to(std::size_t, std::size_t) {
+            return Cap;
+        }
+    };
+
+    //Lets the pool grow up to High nodes and then trims it down to Low. The gap between the two keeps a list whose size swings back and forth
+    //from freeing nodes on one swing and allocating them again on the next.
+
+    template <std::size_t High, std::size_t Low>
+    struct watermark_trim {
+        static_assert(Low <= High, "The low watermark cannot be above the high one");
+
+        static bool over_limit(std::size_t pooled, std::size_t) {
+            return pooled > High;
+        }
+
+        static std::size_t trim_to(std::size_t, std::size_t) {
+            return Low;
+        }
+    };
+
+    //Keeps every node until the list is destroyed or shrink_pool() is called.
+
+    struct never_trim {
+        static bool over_limit(std::size_t, std::size_t) {
+            return false;
+        }
+
+        static std::size_t trim_to(std::size_t pooled, std::size_t) {
+            return pooled;
+        }
+    };
+
+    //Does not give each list a pool: nodes come from, and go back to, the calling thread's segment of shared_node_pool<E>.
+
+    struct shared_pool {
+        static bool over_limit(std::size_t, std::size_t) {
+            return false;
+        }
+
+        static std::size_t trim_to(std::size_t pooled, std::size_t) {
+            return pooled;
+        }
+    };
+
+    template <typename TrimPolicy>
+    struct is_shared_pool : std::false_type {
+    };
+
+    template <>
+    struct is_shared_pool<shared_pool> : std::true_type {
+    };
+
+    //==============================================================================
+    // shared node pool
+
+    constexpr std::size_t ceil_power_of_two(std::size_t n, std::size_t power = 1) {
+        return power >= n ? power : ceil_power_of_two(n, power * 2);
+    }
+
+    //A process-wide pool of nodes for one element type, split into segments so that each thread allocates and frees without synchronising with the others.
+    //Every slab is aligned to its own size and starts with a header naming the segment it belongs to, so any node can find its home segment from its address.
+    //A node freed by the thread that owns its segment goes straight onto that segment's free list. A node freed by any other thread is pushed onto the
+    //owner's remote list with a compare-and-swap; the owner takes the whole remote list with one exchange when its own free list runs dry.
+    //When a thread exits its segment is parked for the next thread to start, so nodes that are still in use, or still on their way back, always have a home.
+    //Each slab header counts the slab's nodes in use, which only the owning thread updates. shrink() deallocates the calling thread's slabs that have none,
+    //and so does the thread that takes over a parked segment. The segments themselves are never deallocated.
+    //The registry of parked segments is never destroyed, so a list destroyed after its thread's handle (a static PSLL, say) still returns its nodes safely.
+
+    template <typename E>
+    class shared_node_pool {
+    public:
+        using size_t = std::size_t;
+
+        struct segment_stats { //A snapshot of the calling thread's segment
+            size_t slabs; //Slabs in the segment
+            size_t capacity; //Nodes across those slabs
+            size_t pooled; //Free nodes the thread can take without synchronising, including those not yet carved
+            size_t acquired; //Nodes taken from the segment so far
+            size_t recycled; //How many of those had been given back
+            size_t remote_returns; //Nodes given back by other threads so far
+            size_t slab_allocations; //Slabs allocated so far. Every other acquisition was a pool hit.
+        };
+
+        static node<E> *acquire(void); //Takes a node from the calling thread's segment. The caller constructs the element.
+        static void release(node<E> *released); //Gives back a node whose element has been destroyed, to the segment it came from
+        static void reserve(size_t n); //Makes sure the calling thread's segment has at least n free nodes
+        static void shrink(void); //Deallocates the calling thread's slabs that have no node in use
+        static segment_stats stats(void);
+
+    private:
+        struct segment;
+
+        struct slab_header {
+            segment *owner;
+            void *block; //What ::operator new returned, which the aligned slab was carved from
+            slab_header *next; //The owner's slabs are chained newest first
+            size_t in_use; //Nodes handed out and not yet back on the owner's free list. Only the owning thread updates it.
+        };
+
+        static constexpr size_t header_size = (sizeof (slab_header) + alignof (node<E>) - 1) / alignof (node<E>) * alignof (node<E>);
+        static constexpr size_t slab_size = ceil_power_of_two(header_size + 64 * sizeof (node<E>)) < 65536 ? 65536 : ceil_power_of_two(header_size + 64 * sizeof (node<E>)); //In bytes, a power of two
+        static constexpr size_t slab_nodes = (slab_size - header_size) / sizeof (node<E>);
+
+        struct segment {
+            //Used by the owning thread only
+            node<E> *free_nodes = nullptr;
+            size_t free_count = 0;
+            node<E> *carve = nullptr; //Next node never handed out in the newest slab
+            node<E> *carve_end = nullptr;
+            slab_header *slabs = nullptr;
+            size_t slab_count = 0;
+            size_t acquired = 0;
+            size_t recycled = 0;
+            size_t slab_allocations = 0;
+            segment *next_parked = nullptr;
+
+            char padding[64]; //Keeps the owner's fields off the line that other threads write
+            std::atomic<node<E> *> remote_nodes{nullptr}; //Nodes given back by other threads
+            std::atomic<size_t> remote_returns{0};
+        };
+
+        struct registry { //Segments left by threads that have exited
+            std::mutex lock;
+            segment *parked = nullptr;
+        };
+
+        struct thread_handle { //Parks the thread's segment when the thread exits
+            ~thread_handle();
+        };
+
+        static registry &parked_segments(void);
+        static segment *&owned(void); //The calling thread's segment, or nullptr
+        static bool &exited(void); //Whether the calling thread's handle has been destroyed
+        static segment &local(void);
+        static slab_header *header_of(node<E> *n);
+        static void add_slab(segment &s);
+        static void take_remote(segment &s); //Moves the nodes other threads gave back onto the free list
+        static void release_idle_slabs(segment &s);
+    };
+
+    //==============================================================================
+    // --------- thread state
+
+    template <typename E>
+    typename shared_node_pool<E>::registry &
+    shared_node_pool<E>::parked_segments() {
+        static registry *parked = new registry; //Deliberately never destroyed: threads and static lists may still need it during teardown
+        return *parked;
+    }
+
+    template <typename E>
+    typename shared_node_pool<E>::segment *&
+    shared_node_pool<E>::owned() {
+        static thread_local segment *current = nullptr; //A plain pointer, so it stays readable after the handle is destroyed
+        return current;
+    }
+
+    template <typename E>
+    bool &
+    shared_node_pool<E>::exited() {
+        static thread_local bool handle_destroyed = false;
+        return handle_destroyed;
+    }
+
+    template <typename E>
+    shared_node_pool<E>::thread_handle::~thread_handle() {
+        registry &r = parked_segments();
+        std::lock_guard<std::mutex> lock(r.lock);
+        owned()->next_parked = r.parked;
+        r.parked = owned();
+        owned() = nullptr; //From now on the thread's releases take the remote path, like any other thread's
+        exited() = true;
+    }
+
+    template <typename E>
+    typename shared_node_pool<E>::segment &
+    shared_node_pool<E>::local() {
+        segment *&current = owned();
+        if (current != nullptr) return *current;
+        registry &r = parked_segments();
+        {
+            std::lock_guard<std::mutex> lock(r.lock);
+            current = r.parked;
+            if (current != nullptr) r.parked = current->next_parked;
+        }
+        if (current == nullptr) current = new segment;
+        else { //A parked segment: what came back while it was parked is free now, and so may be whole slabs
+            take_remote(*current);
+            release_idle_slabs(*current);
+        }
+        if (!exited()) { //A thread that allocates again after its handle is gone (from a thread_local list's destructor, say) keeps the segment for good
+            static thread_local thread_handle handle;
+            (void) handle;
+        }
+        return *current;
+    }
+
+    template <typename E>
+    typename shared_node_pool<E>::slab_header *
+    shared_node_pool<E>::header_of(node<E> *n) {
+        return reinterpret_cast<slab_header *> (reinterpret_cast<std::uintptr_t> (n) & ~std::uintptr_t(slab_size - 1));
+    }
+
+    //==============================================================================
+    // --------- add_slab()
+
+    template <typename E>
+    void
+    shared_node_pool<E>::add_slab(segment &s) {
+        void *block = ::operator new(2 * slab_size); //Twice the size, so that an aligned slab fits. Pages of the slack that are never touched are never backed by memory.
+        std::uintptr_t const aligned = (reinterpret_cast<std::uintptr_t> (block) + slab_size - 1) & ~std::uintptr_t(slab_size - 1);
+        slab_header *header = reinterpret_cast<slab_header *> (aligned);
+        header->owner = &s;
+        header->block = block;
+        header->next = s.slabs;
+        header->in_use = 0;
+        s.slabs = header;
+        s.carve = reinterpret_cast<node<E> *> (aligned + header_size);
+        s.carve_end = s.carve + slab_nodes;
+        s.slab_count++;
+        s.slab_allocations++;
+    }
+
+    //==============================================================================
+    // --------- take_remote()
+
+    template <typename E>
+    void
+    shared_node_pool<E>::take_remote(segment &s) {
+        node<E> *returned = s.remote_nodes.exchange(nullptr, std::memory_order_acquire);
+        while (returned != nullptr) {
+            node<E> *n = returned;
+            returned = returned->next;
+            header_of(n)->in_use--;
+            n->next = s.free_nodes;
+            s.free_nodes = n;
+            s.free_count++;
+        }
+    }
+
+    //==============================================================================
+    // --------- release_idle_slabs()
+
+    template <typename E>
+    void
+    shared_node_pool<E>::release_idle_slabs(segment &s) {
+        bool any_idle = false;
+        for (slab_header *h = s.slabs; h != nullptr; h = h->next)
+            if (h->in_use == 0) any_idle = true;
+        if (!any_idle) return;
+
+        //Every node of an idle slab is either on the free list or not carved yet, so unlink the free ones first
+        node<E> **link = &s.free_nodes;
+        for (node<E> *n = s.free_nodes; n != nullptr; n = n->next) {
+            if (header_of(n)->in_use != 0) {
+                *link = n;
+                link = &n->next;
+            } else s.free_count--;
+        }
+        *link = nullptr;
+        if (s.slabs->in_use == 0) { //The newest slab is the one being carved, so nothing is left to carve
+            s.carve = nullptr;
+            s.carve_end = nullptr;
+        }
+
+        slab_header **link_slab = &s.slabs;
+        while (*link_slab != nullptr) {
+            slab_header *h = *link_slab;
+            if (h->in_use == 0) {
+                *link_slab = h->next;
+                ::operator delete(h->block);
+                s.slab_count--;
+            } else link_slab = &h->next;
+        }
+    }
+
+    //==============================================================================
+    // --------- acquire()
+
+    template <typename E>
+    node<E> *
+    shared_node_pool<E>::acquire() {
+        segment &s = local();
+        if (s.free_nodes == nullptr && s.remote_nodes.load(std::memory_order_relaxed) != nullptr) //Take back everything other threads returned
+            take_remote(s);
+        node<E> *taken;
+        if (s.free_nodes != nullptr) {
+            taken = s.free_nodes;
+            s.free_nodes = taken->next;
+            s.free_count--;
+            s.recycled++;
+        } else {
+            if (s.carve == s.carve_end) add_slab(s);
+            taken = s.carve++;
+        }
+        header_of(taken)->in_use++;
+        s.acquired++;
+        return taken;
+    }
+
+    //==============================================================================
+    // --------- release()
+
+    template <typename E>
+    void
+    shared_node_pool<E>::release(node<E> *released) {
+        slab_header *header = header_of(released);
+        segment *owner = header->owner;
+        if (owner == owned()) {
+            header->in_use--;
+            released->next = owner->free_nodes;
+            owner->free_nodes = released;
+            owner->free_count++;
+        } else { //Push onto the owner's remote list. The owner only ever takes the whole list, so there is no ABA problem.
+            node<E> *top = owner->remote_nodes.load(std::memory_order_relaxed);
+            do {
+                released->next = top;
+            } while (!owner->remote_nodes.compare_exchange_weak(top, released, std::memory_order_release, std::memory_order_relaxed));
+            owner->remote_returns.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    //==============================================================================
+    // --------- reserve()
+
+    template <typename E>
+    void
+    shared_node_pool<E>::reserve(size_t n) {
+        segment &s = local();
+        while (s.free_count + size_t(s.carve_end - s.carve) < n) {
+            while (s.carve != s.carve_end) { //Only the newest slab is carved from, so what is left of it goes to the free list first
+                node<E> *left = --s.carve_end;
+                left->next = s.free_nodes;
+                s.free_nodes = left;
+                s.free_count++;
+            }
+            add_slab(s);
+        }
+    }
+
+    //==============================================================================
+    // --------- shrink()
+
+    template <typename E>
+    void
+    shared_node_pool<E>::shrink() {
+        segment &s = local();
+        take_remote(s);
+        release_idle_slabs(s);
+    }
+
+    //==============================================================================
+    // --------- stats()
+
     template <typename E>
-    class PSLL : public List<E> { //We need to create the list class
+    typename shared_node_pool<E>::segment_stats
+    shared_node_pool<E>::stats() {
+        segment &s = local();
+        segment_stats result;
+        result.slabs = s.slab_count;
+        result.capacity = s.slab_count * slab_nodes;
+        result.pooled = s.free_count + size_t(s.carve_end - s.carve);
+        result.acquired = s.acquired;
+        result.recycled = s.recycled;
+        result.remote_returns = s.remote_returns.load(std::memory_order_relaxed);
+        result.slab_allocations = s.slab_allocations;
+        return result;
+    }
+
+    //==============================================================================
+    // PSLL
+
+    template <typename E, typename TrimPolicy = half_length_trim, typename Allocator = std::allocator<E> >
+    class PSLL : public static_list<PSLL<E, TrimPolicy, Allocator>, E> { //We need to create the list class
 
     public:
 
@@ -35,13 +454,18 @@ namespace cop3530 {
 
         private:
             node<T>* here; //This is the pointer the the list member the iterator is pointing at
+            node<T>* const* head_link; //Only set by before_begin(), which points at no node: the list's head pointer tells it apart from end()
+            friend class PSLL; //The _after operations relink the node the iterator points at
+
+            PSLL_Iter(node<T>* start, node<T>* const* head_link) : here(start), head_link(head_link) {
+            }
 
         public:
 
-            explicit PSLL_Iter(node<T>* start = nullptr) : here(start) { //This is the explicit constructor for the iterator class. It does not allow implicit conversions or copy-initialization.
+            explicit PSLL_Iter(node<T>* start = nullptr) : here(start), head_link(nullptr) { //This is the explicit constructor for the iterator class. It does not allow implicit conversions or copy-initialization.
             }
 
-            PSLL_Iter(const PSLL_Iter& src) : here(src.here) { //This is the regular constructor for the iterator class
+            PSLL_Iter(const PSLL_Iter& src) : here(src.here), head_link(src.head_link) { //This is the regular constructor for the iterator class
             }
 
             reference operator*() const {
@@ -53,7 +477,8 @@ namespace cop3530 {
             }
 
             self_reference operator=(PSLL_Iter<T> const& src) {
-                here = PSLL_Iter(src).here;
+                here = src.here;
+                head_link = src.head_link;
                 return *this; //temporary line
             }
 
@@ -69,12 +494,12 @@ namespace cop3530 {
             } // postincrement
 
             bool operator==(PSLL_Iter<T> const& rhs) const {
-                if (here == rhs.here) return true;
+                if (here == rhs.here && head_link == rhs.head_link) return true;
                 return false;
             }
 
             bool operator!=(PSLL_Iter<T> const& rhs) const {
-                if (here != rhs.here) return true;
+                if (here != rhs.here || head_link != rhs.head_link) return true;
                 return false;
             }
 
@@ -84,8 +509,24 @@ namespace cop3530 {
         using value_type = E;
         using iterator = PSLL_Iter<E>; //When we use the word iterator, we mean the iterator class
         using const_iterator = PSLL_Iter<E const>;
+
+        struct pool_stats : list_stats { //A snapshot of the node pool, see stats(). The list_stats part is all zeros unless built with COP3530_INSTRUMENT.
+            size_t slabs; //Slabs currently held by the list
+            size_t capacity; //Nodes across those slabs, in the list or in the pool
+            size_t pooled; //Free nodes ready to be used, including those not yet carved from the newest slab
+            size_t acquired; //Nodes taken from the pool so far
+            size_t recycled; //How many of those were nodes the list had given back
+            size_t slab_allocations; //Slabs allocated so far. Every other acquisition was a pool hit.
+
+            double hit_rate() const { //Fraction of acquisitions served without calling the allocator
+                return acquired == 0 ? 0 : double(acquired - slab_allocations) / acquired;
+            }
+        };
+        using allocator_type = Allocator;
+
         //operations
         PSLL(); //This is the constructor method of the singly linked list
+        explicit PSLL(const Allocator& allocator); //Constructs an empty list whose slabs come from the given allocator
         PSLL(const PSLL& other); //copy constructor
         PSLL(PSLL&& other); //move constructor
         ~PSLL(); //This is the destructor method of the singly linked list
@@ -109,6 +550,10 @@ namespace cop3530 {
             if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
             return PSLL_Iter<E>(tail->next);
         }
+
+        iterator before_begin() { //The position before the first element, to pass to the _after operations (it also works on an empty list, and never equals end()). It cannot be dereferenced or incremented.
+            return PSLL_Iter<E>(nullptr, &head);
+        }
         PSLL & operator=(const PSLL & other);
         PSLL & operator=(PSLL&& other);
         void insert(E element, int); //Adds the specific element to the list at the specified position, shifting the element originally at that and those in subsequent positions one position to the "right"
@@ -126,173 +571,414 @@ namespace cop3530 {
         size_t length(void); //Returns the number of elements in the list as a size_t
         void clear(void); //removes all elements from the list
         bool contains(E element, bool (*equals_function)(const E&, const E&)); //returns true IFF at least one of the elements of the list matches the specified element
+        template <typename Predicate>
+        int find_if(Predicate predicate); //Returns the position of the first element for which predicate(element) is true, or -1 if there is none
+        bool contains(const E& element); //returns true IFF at least one of the elements of the list is == to the specified element
+        template <typename Equals>
+        bool contains(const E& element, Equals equals); //returns true IFF equals(list element, element) holds for at least one of the elements. Any callable works, and the compiler can inline it.
         void print(std::ostream& o); //If the list is empty, inserts "<empty list>" into the ostream; otherwise, inserts, enclosed in square brackets, the list's elements, separated by commas, in sequential order 
 
+        //In the style of std::forward_list: O(1) edits right after a position the caller already holds, so a filter or merge pass is a single traversal
+        iterator insert_after(iterator position, E element); //Inserts the element right after position and returns an iterator to it
+        template <typename... Args>
+        iterator emplace_after(iterator position, Args&&... args); //Same, but constructs the element in place from args
+        iterator erase_after(iterator position); //Removes the element right after position and returns an iterator to the element that followed it (or end())
+        void splice_after(iterator position, PSLL& other); //Moves every element of other, in order, right after position. other must be this list or, on the shared pool, a list with an equal allocator.
+        void splice_after(iterator position, PSLL& other, iterator before); //Moves the element right after before (in other) right after position
+        void splice_after(iterator position, PSLL& other, iterator before_first, iterator last); //Moves the elements strictly between before_first and last (in other) right after position
+
 
         E * const contents(); //Allocates, initializes, and returns an array containing a copy of the list's elements in sequential order
+        template <typename OutputIt>
+        OutputIt copy_to(OutputIt out); //Writes the elements, in sequential order, through out (a caller's buffer, a back_inserter...) and returns it past the last one. Allocates nothing.
+
+        pool_stats stats(void) const; //Returns the node pool's counters
+        void reserve(size_t n); //Makes room for n nodes in the list and its pool together, and keeps them through trimming
+        void shrink_pool(void); //Deallocates every slab whose nodes are all in the pool, and forgets any reserve(). On the shared pool, the calling thread's idle slabs.
+        void swap(PSLL& other); //Exchanges the two lists and their pools. The allocators are exchanged too if they propagate on swap; otherwise they must compare equal.
+        allocator_type get_allocator() const; //Returns a copy of the allocator
 
     private:
+        static constexpr size_t smallest_slab = 64;
+        static constexpr size_t largest_slab = 4096;
+
+        struct slab { //A block of nodes allocated at once. The slabs of a list are chained newest first.
+            node<E> *nodes;
+            size_t size; //Number of nodes in the block
+            size_t carved; //Nodes handed out at least once. Only the newest slab can have nodes left to carve.
+            size_t free; //Scratch count used while trimming
+            slab *next;
+        };
+
+        using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<node<E> >;
+        using node_traits = std::allocator_traits<node_allocator>;
+        using slab_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<slab>;
+        using slab_pointer_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<slab *>;
+
         void psll_rules_check(void);
+        template <typename... Args>
+        node<E> *acquire_node(Args&&... args); //Takes a node from the pool (or from a new slab) and constructs the element in it from args
+        void require_splice_source(const PSLL& other) const; //Throws unless other's nodes can be relinked into this list
+        node<E> *position_node(const iterator& position) const; //The node an _after operation works right after, or nullptr for before_begin(). Throws for end(), after which nothing can go.
+        void link_after(node<E> *previous, node<E> *first, node<E> *last, size_t moved, PSLL& other); //Puts the chain first..last of moved nodes, already unlinked from other, right after previous
+        void release_node(node<E> *released); //Destroys the node's element and returns the node to the pool
+        void add_slab(size_t wanted = 0); //Allocates a new slab, about as large as all the current ones together or as wanted
+        void release_free_slabs(size_t keep); //Deallocates slabs whose nodes are all in the pool, as long as at least keep nodes stay in the pool
+        void release_all(void); //Empties the list and deallocates every slab
+        void free_slab(slab *s); //Deallocates the slab and its nodes, whose elements must already be destroyed
+        void copy_from(const PSLL& other); //Appends copies of the other list's elements
+        void take_pool(PSLL& other); //Takes over the other list's nodes and slabs, which must have come from an equal allocator
         //variables
+        node_allocator allocator;
         node<E> *head;
         node<E> *tail;
-        node<E> *poolhead;
-        node<E> *pooltail;
-        int poolcount;
+        node<E> *poolhead; //Nodes given back to the pool, ready to be reused
+        size_t poolcount; //Number of free nodes: those given back plus those not yet carved from the newest slab
+        size_t next_trim; //The pool size at which to look for free slabs again, so that a pool with no free slab is not scanned on every operation
+        slab *slabs;
+        size_t slab_count;
+        size_t capacity; //Nodes across all slabs. Every one of them is either in the list or in the pool.
+        size_t reserved; //Capacity that trimming must leave in place, see reserve()
+        size_t acquired;
+        size_t recycled;
+        size_t slab_allocations;
+#ifdef COP3530_INSTRUMENT
+        list_stats instrumentation;
+#endif
     };
 
     //==============================================================================
     // ------- constructor  
 
-    template <typename E>
-    PSLL<E>::PSLL() {
+    template <typename E, typename TrimPolicy, typename Allocator>
+    PSLL<E, TrimPolicy, Allocator>::PSLL() : PSLL(Allocator()) {
+    }
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    PSLL<E, TrimPolicy, Allocator>::PSLL(const Allocator& allocator) : allocator(allocator) {
         head = nullptr;
         tail = nullptr;
-        poolcount = 0;
-
-        pooltail = nullptr;
         poolhead = nullptr;
+        poolcount = 0;
+        next_trim = 0;
+        slabs = nullptr;
+        slab_count = 0;
+        capacity = 0;
+        reserved = 0;
+        acquired = 0;
+        recycled = 0;
+        slab_allocations = 0;
     }
     // ------- copy constructor 
 
-    template <typename E>
-    PSLL<E>::PSLL(const PSLL& other) {
-        //First copy the head
-        head = new node<E>;
-        head->datum = other.head->datum;
+    template <typename E, typename TrimPolicy, typename Allocator>
+    PSLL<E, TrimPolicy, Allocator>::PSLL(const PSLL& other) : PSLL(node_traits::select_on_container_copy_construction(other.allocator)) {
+        copy_from(other); //The copy gets a pool of its own
+    }
+
+    // ------- copy-assignment operator 
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    PSLL<E, TrimPolicy, Allocator> &
+    PSLL<E, TrimPolicy, Allocator>::operator=(const PSLL & other) {
+        if (this == &other) return *this;
+        if (node_traits::propagate_on_container_copy_assignment::value && allocator != other.allocator)
+            this->release_all(); //Our slabs must go back to the allocator they came from before we take the other list's
+        else this->clear(); //Our nodes go back to our pool, where the copy can reuse them
+        assign_allocator(allocator, other.allocator, typename node_traits::propagate_on_container_copy_assignment());
+        copy_from(other);
+        return *this;
+    }
+    // ------  move constructor
 
-        //Traversal pointers
-        node<E> *new_nodes = head;
-        node<E> *old_nodes = other.head;
+    template <typename E, typename TrimPolicy, typename Allocator>
+    PSLL<E, TrimPolicy, Allocator>::PSLL(PSLL&& other) : PSLL(other.allocator) {
+        take_pool(other);
+    }
+    // ------- move assignment operator 
 
-        //Deep copy
-        while (old_nodes->next) { //While we have not finished traversing the "old" chain
-            new_nodes->next = new node<E>;
-            new_nodes = new_nodes->next;
-            old_nodes = old_nodes->next;
-            new_nodes->datum = old_nodes->datum;
+    template <typename E, typename TrimPolicy, typename Allocator>
+    PSLL<E, TrimPolicy, Allocator> &
+    PSLL<E, TrimPolicy, Allocator>::operator=(PSLL&& other) {
+        if (this != &other) {
+            if (node_traits::propagate_on_container_move_assignment::value || allocator == other.allocator) {
+                this->release_all();
+                move_allocator(allocator, other.allocator, typename node_traits::propagate_on_container_move_assignment());
+                take_pool(other);
+            } else { //Our allocator cannot free the other list's slabs, so the elements are moved into nodes of our own
+                this->clear();
+                for (node<E> *current = other.head; current != nullptr; current = current->next)
+                    push_back(std::move(current->datum));
+                other.clear();
+            }
         }
+        return *this;
+    }
+    // ------  destructor 
 
-        //Copy the tail
-        tail = new_nodes;
-        tail->next = nullptr;
+    template <typename E, typename TrimPolicy, typename Allocator>
+    PSLL<E, TrimPolicy, Allocator>::~PSLL() {
+        release_all();
+    }
 
-        //Set pool
-        poolcount = 0;
-        pooltail = nullptr;
-        poolhead = nullptr;
+    //==============================================================================
+    // operations
+    //==============================================================================
+    // --------- psll_rules_check() Because we don't want the pool to waste too much memory, the trim policy decides when the pool holds too many nodes and how many to keep.
 
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::psll_rules_check() {
+        size_t const list_length = capacity - poolcount;
+        if (!TrimPolicy::over_limit(poolcount, list_length)) {
+            next_trim = 0;
+            return;
+        }
+        if (poolcount < next_trim) return; //We looked not long ago and the pool has not grown much since
+        size_t keep = TrimPolicy::trim_to(poolcount, list_length);
+        if (reserved > list_length + keep) keep = reserved - list_length; //Never trim below what reserve() asked for
+        release_free_slabs(keep);
+        next_trim = poolcount * 2;
     }
 
-    // ------- copy-assignment operator 
+    //==============================================================================
+    // --------- acquire_node()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    template <typename... Args>
+    node<E> *
+    PSLL<E, TrimPolicy, Allocator>::acquire_node(Args&&... args) {
+        node<E> *taken;
+        if (is_shared_pool<TrimPolicy>::value) {
+            taken = shared_node_pool<E>::acquire(); //Not a hit or miss of this list's pool: the segment's own counters are in stats() already
+            try {
+                node_traits::construct(allocator, &taken->datum, std::forward<Args>(args)...);
+            } catch (...) {
+                shared_node_pool<E>::release(taken); //Back to its segment, so its slab can still become idle
+                throw;
+            }
+            capacity++; //A list on the shared pool has no pool of its own, so its capacity is just the nodes it holds
+        } else {
+            if (poolhead == nullptr && (slabs == nullptr || slabs->carved == slabs->size)) { //No free node anywhere, so this is a pool miss
+                add_slab();
+                COP3530_COUNT(pool_misses, 1);
+            } else COP3530_COUNT(pool_hits, 1);
+            bool const reused = poolhead != nullptr; //Reuse a node the list gave back, or carve the next one (in order, so consecutive pushes get consecutive nodes)
+            taken = reused ? poolhead : &slabs->nodes[slabs->carved];
+            node_traits::construct(allocator, &taken->datum, std::forward<Args>(args)...); //Before the node leaves the pool, so an element that throws leaves the pool as it was
+            if (reused) {
+                poolhead = poolhead->next;
+                recycled++;
+            } else slabs->carved++;
+            poolcount--;
+        }
+        taken->next = nullptr;
+        acquired++;
+        COP3530_COUNT(copies, 1);
+        return taken;
+    }
 
-    template <typename E>
-    PSLL<E> &
-    PSLL<E>::operator=(const PSLL & other) {
-        //First copy the head
-        head = new node<E>;
-        head->datum = other.head->datum;
+    //==============================================================================
+    // --------- release_node()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::release_node(node<E> *released) {
+        node_traits::destroy(allocator, &released->datum);
+        if (is_shared_pool<TrimPolicy>::value) {
+            shared_node_pool<E>::release(released);
+            capacity--;
+            return;
+        }
+        released->next = poolhead;
+        poolhead = released;
+        poolcount++;
+    }
+
+    //==============================================================================
+    // --------- add_slab()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::add_slab(size_t wanted) {
+        size_t size = capacity > wanted ? capacity : wanted; //Doubling the capacity keeps the number of slabs logarithmic until they reach the largest size
+        if (size < smallest_slab) size = smallest_slab;
+        if (size > largest_slab) size = largest_slab;
+        if (slabs != nullptr) { //Only the newest slab is carved from, so whatever is left of the current one goes to the pool (last node first, so they come back out in order)
+            for (size_t i = slabs->size; i > slabs->carved; i--) {
+                node<E> *left = &slabs->nodes[i - 1];
+                left->next = poolhead;
+                poolhead = left;
+            }
+            slabs->carved = slabs->size;
+        }
+        slab_allocator headers(allocator);
+        slab *added = std::allocator_traits<slab_allocator>::allocate(headers, 1);
+        added->nodes = node_traits::allocate(allocator, size); //Raw storage: elements are constructed as nodes are acquired
+        added->size = size;
+        added->carved = 0;
+        added->next = slabs;
+        slabs = added;
+        slab_count++;
+        capacity += size;
+        poolcount += size;
+        slab_allocations++;
+        COP3530_COUNT(allocations, 2); //The header and the nodes
+    }
 
-        //Traversal pointers
-        node<E> *new_nodes = head;
-        node<E> *old_nodes = other.head;
+    //==============================================================================
+    // --------- release_free_slabs()
 
-        //Deep copy
-        while (old_nodes->next) { //While we have not finished traversing the "old" chain
-            new_nodes->next = new node<E>;
-            new_nodes = new_nodes->next;
-            old_nodes = old_nodes->next;
-            new_nodes->datum = old_nodes->datum;
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::release_free_slabs(size_t keep) {
+        if (slab_count == 0) return;
+
+        //Sort the slabs by address so that the slab of any node can be found with a binary search
+        slab_pointer_allocator pointers(allocator);
+        slab **by_address = std::allocator_traits<slab_pointer_allocator>::allocate(pointers, slab_count);
+        COP3530_COUNT(allocations, 1);
+        size_t i = 0;
+        for (slab *s = slabs; s != nullptr; s = s->next) {
+            s->free = s->size - s->carved; //Nodes never carved are free too
+            by_address[i++] = s;
+        }
+        auto lower_address = [](const slab *a, const slab *b) {
+            return std::less<node<E> *>()(a->nodes, b->nodes);
+        };
+        std::sort(by_address, by_address + slab_count, lower_address);
+        auto slab_of = [&](node<E> *n) {
+            size_t low = 0, high = slab_count;
+            while (high - low > 1) {
+                size_t middle = (low + high) / 2;
+                if (std::less<node<E> *>()(n, by_address[middle]->nodes)) high = middle;
+                else low = middle;
+            }
+            return by_address[low];
+        };
+
+        //Count the free nodes of every slab, and choose the slabs that are entirely free
+        for (node<E> *n = poolhead; n != nullptr; n = n->next)
+            slab_of(n)->free++;
+        size_t released = 0;
+        for (i = 0; i < slab_count; i++) {
+            slab *s = by_address[i];
+            if (s->free == s->size && poolcount - s->size >= keep) {
+                poolcount -= s->size;
+                capacity -= s->size;
+                released++;
+            } else s->free = 0; //From here on, a full free count marks a slab to release
+        }
+        if (released != 0) {
+            //Unlink the chosen slabs' nodes from the pool
+            node<E> **link = &poolhead;
+            for (node<E> *n = poolhead; n != nullptr; n = n->next) {
+                slab *s = slab_of(n);
+                if (s->free != s->size) {
+                    *link = n;
+                    link = &n->next;
+                }
+            }
+            *link = nullptr;
+
+            //Deallocate them. Their elements were destroyed when the nodes went back to the pool.
+            slab **link_slab = &slabs;
+            while (*link_slab != nullptr) {
+                slab *s = *link_slab;
+                if (s->free == s->size) {
+                    *link_slab = s->next;
+                    free_slab(s);
+                    slab_count--;
+                } else link_slab = &s->next;
+            }
         }
+        std::allocator_traits<slab_pointer_allocator>::deallocate(pointers, by_address, slab_count + released);
+        COP3530_COUNT(frees, 1);
+    }
+
+    //==============================================================================
+    // --------- free_slab()
 
-        //Copy the tail
-        tail = new_nodes;
-        tail->next = nullptr;
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::free_slab(slab *s) {
+        node_traits::deallocate(allocator, s->nodes, s->size);
+        slab_allocator headers(allocator);
+        std::allocator_traits<slab_allocator>::deallocate(headers, s, 1);
+        COP3530_COUNT(frees, 2);
+    }
 
-        //Set pool
-        poolcount = 0;
-        pooltail = nullptr;
-        poolhead = nullptr;
+    //==============================================================================
+    // --------- release_all()
 
-        return *this;
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::release_all() {
+        clear();
+        while (slabs != nullptr) {
+            slab *s = slabs;
+            slabs = slabs->next;
+            free_slab(s);
+        }
+        poolhead = nullptr;
+        poolcount = 0;
+        next_trim = 0;
+        slab_count = 0;
+        capacity = 0;
+        reserved = 0;
     }
-    // ------  move constructor
 
-    template <typename E>
-    PSLL<E>::PSLL(PSLL&& other) {
+    //==============================================================================
+    // --------- take_pool()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::take_pool(PSLL& other) {
+        //The nodes and the slabs they live in change hands together
         head = other.head;
         tail = other.tail;
         poolhead = other.poolhead;
-        pooltail = other.pooltail;
         poolcount = other.poolcount;
+        next_trim = other.next_trim;
+        slabs = other.slabs;
+        slab_count = other.slab_count;
+        capacity = other.capacity;
+        reserved = other.reserved;
+        acquired = other.acquired;
+        recycled = other.recycled;
+        slab_allocations = other.slab_allocations;
 
         other.head = nullptr;
         other.tail = nullptr;
         other.poolhead = nullptr;
-        other.pooltail = nullptr;
-        poolcount = 0;
-    }
-    // ------- move assignment operator 
-
-    template <typename E>
-    PSLL<E> &
-    PSLL<E>::operator=(PSLL&& other) {
-        if (this != &other) {
-            this->clear();
-            head = other.head;
-            tail = other.tail;
-            poolhead = other.poolhead;
-            pooltail = other.pooltail;
-            poolcount = other.poolcount;
-
-            other.head = nullptr;
-            other.tail = nullptr;
-            other.poolhead = nullptr;
-            other.pooltail = nullptr;
-            poolcount = 0;
-        }
-        return *this;
-    }
-    // ------  destructor 
-
-    template <typename E>
-    PSLL<E>::~PSLL() {
-        clear();
-        while (poolcount > 0) //This deletes every element of the list except for the tail
-        {
-            node<E> *eliminate = poolhead;
-            poolhead = poolhead->next;
-            delete eliminate;
-            poolcount--;
-        }
-
+        other.poolcount = 0;
+        other.next_trim = 0;
+        other.slabs = nullptr;
+        other.slab_count = 0;
+        other.capacity = 0;
+        other.reserved = 0;
     }
 
     //==============================================================================
-    // operations
-    //==============================================================================
-    // --------- psll_rules_check() Because we don't want the pool to waste too much memory, whenever the list contains ≥ 100 items AND the pool contains more nodes than half the list size, reduce the number of pool nodes to half the list size (by deallocating the excess).
+    // --------- copy_from()
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     void
-    PSLL<E>::psll_rules_check() {
-        if (poolcount > 50) {
-            int nodes_to_delete = 50 - poolcount;
-            for (int i = 0; i < nodes_to_delete; i++) {
-                node<E> *eliminate = poolhead;
-                poolhead = poolhead->next;
-                delete eliminate;
-                poolcount--;
-            }
+    PSLL<E, TrimPolicy, Allocator>::copy_from(const PSLL& other) {
+        for (node<E> *old_nodes = other.head; old_nodes != nullptr; old_nodes = old_nodes->next) {
+            node<E> *copied = acquire_node(old_nodes->datum);
+            if (head == nullptr) head = copied;
+            else tail->next = copied;
+            tail = copied;
         }
     }
 
     //==============================================================================
     // --------- insert()
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     void
-    PSLL<E>::insert(E element, int position) {
+    PSLL<E, TrimPolicy, Allocator>::insert(E element, int position) {
         if (position > length() || position < 0) throw std::runtime_error("Sorry but that position is outside the current list boundaries");
         else if (position == 0) push_front(element);
         else if (position == length()) push_back(element);
@@ -303,27 +989,149 @@ namespace cop3530 {
                 pre = cur;
                 cur = cur->next;
             }
-            if (poolcount == 0) { //If there are no free nodes, we need to add a new node before we can push a node to the list
-                node<E> *t = new node <E>;
-                poolhead = t;
-                pooltail = t;
-                poolcount++;
-            }
-            node<E> *to_be_inserted = poolhead;
-            poolhead = poolhead->next;
-            poolcount--;
-            to_be_inserted->datum = element;
+            COP3530_COUNT(node_hops, position);
+            node<E> *to_be_inserted = acquire_node(element);
             pre->next = to_be_inserted; //link node position-1 to new node	
             to_be_inserted->next = cur; //link new node to position+1 
+            this->psll_rules_check();
         }
     }
 
     //==============================================================================
+    // --------- require_splice_source()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::require_splice_source(const PSLL& other) const {
+        if (&other == this || (is_shared_pool<TrimPolicy>::value && allocator == other.allocator)) return;
+        throw std::runtime_error("Sorry, but only lists on the shared pool can splice nodes from one another"); //A private pool's nodes live in its own slabs
+    }
 
+    //==============================================================================
+    // --------- position_node()
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
+    node<E> *
+    PSLL<E, TrimPolicy, Allocator>::position_node(const iterator& position) const {
+        if (position.here == nullptr && position.head_link != &head) throw std::runtime_error("Sorry, but nothing can come after that position");
+        return position.here;
+    }
+
+    //==============================================================================
+    // --------- insert_after()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    typename PSLL<E, TrimPolicy, Allocator>::iterator
+    PSLL<E, TrimPolicy, Allocator>::insert_after(iterator position, E element) {
+        return emplace_after(position, std::move(element));
+    }
+
+    //==============================================================================
+    // --------- emplace_after()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    template <typename... Args>
+    typename PSLL<E, TrimPolicy, Allocator>::iterator
+    PSLL<E, TrimPolicy, Allocator>::emplace_after(iterator position, Args&&... args) {
+        node<E> *previous = position_node(position); //nullptr is before_begin()
+        node<E> *t = acquire_node(std::forward<Args>(args)...);
+        t->next = previous == nullptr ? head : previous->next;
+        if (previous == nullptr) head = t;
+        else previous->next = t;
+        if (t->next == nullptr) tail = t; //We inserted after the tail
+        this->psll_rules_check();
+        return iterator(t);
+    }
+
+    //==============================================================================
+    // --------- erase_after()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    typename PSLL<E, TrimPolicy, Allocator>::iterator
+    PSLL<E, TrimPolicy, Allocator>::erase_after(iterator position) {
+        node<E> *previous = position_node(position);
+        node<E> *erased = previous == nullptr ? head : previous->next;
+        if (erased == nullptr) throw std::runtime_error("Sorry, but there is no element after that position");
+        if (previous == nullptr) head = erased->next;
+        else previous->next = erased->next;
+        if (erased == tail) tail = previous; //nullptr if the list is now empty
+        release_node(erased);
+        this->psll_rules_check();
+        return iterator(previous == nullptr ? head : previous->next);
+    }
+
+    //==============================================================================
+    // --------- splice_after()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::splice_after(iterator position, PSLL& other) {
+        node<E> *previous = position_node(position);
+        require_splice_source(other);
+        if (&other == this || other.head == nullptr) return;
+        node<E> *first = other.head;
+        node<E> *last = other.tail;
+        size_t const moved = other.length();
+        other.head = nullptr;
+        other.tail = nullptr;
+        link_after(previous, first, last, moved, other);
+    }
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::splice_after(iterator position, PSLL& other, iterator before) {
+        node<E> *previous = position_node(position);
+        require_splice_source(other);
+        node<E> *before_node = other.position_node(before);
+        node<E> *first = before_node == nullptr ? other.head : before_node->next;
+        if (first == nullptr) throw std::runtime_error("Sorry, but there is no element after that position");
+        if (&other == this && (previous == before_node || previous == first)) return; //The element is already right after position
+        splice_after(position, other, before, iterator(first->next));
+    }
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::splice_after(iterator position, PSLL& other, iterator before_first, iterator last) {
+        node<E> *previous = position_node(position);
+        require_splice_source(other);
+        node<E> *before = other.position_node(before_first);
+        node<E> *first = before == nullptr ? other.head : before->next;
+        if (first == last.here) return; //Nothing in between
+        node<E> *final_node = first;
+        size_t moved = 1;
+        while (final_node->next != last.here) { //Find the last node to move, counting them on the way
+            final_node = final_node->next;
+            moved++;
+        }
+        COP3530_COUNT(node_hops, moved - 1);
+        if (before == nullptr) other.head = last.here;
+        else before->next = last.here;
+        if (final_node == other.tail) other.tail = before;
+        link_after(previous, first, final_node, moved, other);
+    }
+
+    //==============================================================================
+    // --------- link_after()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::link_after(node<E> *previous, node<E> *first, node<E> *last, size_t moved, PSLL& other) {
+        last->next = previous == nullptr ? head : previous->next;
+        if (previous == nullptr) head = first;
+        else previous->next = first;
+        if (last->next == nullptr) tail = last;
+        if (&other != this) { //On the shared pool, a list's capacity is the nodes it holds
+            capacity += moved;
+            other.capacity -= moved;
+        }
+    }
+
+    //==============================================================================
+
+
+    template <typename E, typename TrimPolicy, typename Allocator>
     E * const
-    PSLL<E>::contents() {
+    PSLL<E, TrimPolicy, Allocator>::contents() {
         size_t const len = length(); //Get the length of the list so that we can now what size array is needed
         E * const contents = new E[len]; //Initialize the array of contents
         node<E> *current = head;
@@ -331,91 +1139,77 @@ namespace cop3530 {
             contents[i] = current->datum;
             current = current->next;
         }
+        COP3530_COUNT(node_hops, len);
         return contents;
     }
 
 
     //==============================================================================
-    // --------- push_back() ------------------------------------------------------------------------------------ IT WORKS
+    // --------- copy_to()
 
-    template <typename E>
-    void
-    PSLL<E>::push_back(E element) {
-        if (poolcount > 0 && head == nullptr) push_front(element);
-        else if (poolcount > 0 && head != nullptr) {
-            node<E> *ptr = poolhead;
-            poolhead = poolhead->next;
-            tail ->next = ptr;
-            tail = ptr;
-            tail->datum = element;
-            tail->next = nullptr;
-            poolcount--;
-            this->psll_rules_check();
-        } else if (poolcount == 0) { //If there are no free nodes, we need to add a new node before we can push a node to the list
-            node<E> *t = new node <E>;
-            poolhead = t;
-            pooltail = t;
-            poolcount++;
-            push_back(element);
+    template <typename E, typename TrimPolicy, typename Allocator>
+    template <typename OutputIt>
+    OutputIt
+    PSLL<E, TrimPolicy, Allocator>::copy_to(OutputIt out) {
+        node<E> *current = head;
+        for (size_t i = length(); i > 0; i--) {
+            *out++ = current->datum;
+            current = current->next;
         }
+        COP3530_COUNT(node_hops, length());
+        return out;
     }
 
     //==============================================================================
-    // --------- push_front() ------------------------------------------------------------------------------------ IT WORKS
+    // --------- push_back() ------------------------------------------------------------------------------------ IT WORKS
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     void
-    PSLL<E>::push_front(E element) {
-        if (poolcount > 0 && head == nullptr) { //This is the case in which the pool has free nodes and the list is empty
-
-            node<E> *ptr = poolhead; //We point at the pool head
-            head = tail = ptr; //We point the had and the tail of the list to our element
-            poolhead = poolhead->next;
-            head->datum = element; //We make its datum to be element 
-            tail->next = nullptr;
-            poolcount--;
-
-        } else if (poolcount > 0 && head != nullptr) {
-            node<E> *ptr = poolhead; //Temporary pointer created to facilitate the operation
-            poolhead = poolhead->next; //New pool head had been assigned
-            ptr->datum = element; //Element allocated to free node
-            ptr->next = head; //Previously free node being allocated to the front of the list
-            head = ptr;
-            poolcount--;
-            this->psll_rules_check();
-        } else if (poolcount == 0) { //If there are no free nodes, we need to add a new node before we can push a node to the list
+    PSLL<E, TrimPolicy, Allocator>::push_back(E element) {
+        node<E> *ptr = acquire_node(element);
+        if (head == nullptr) head = ptr;
+        else tail->next = ptr;
+        tail = ptr;
+        this->psll_rules_check();
+    }
 
-            node<E> *t = new node <E>;
-            poolhead = t;
-            pooltail = t;
+    //==============================================================================
+    // --------- push_front() ------------------------------------------------------------------------------------ IT WORKS
 
-            poolcount++;
-            push_front(element);
-        }
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::push_front(E element) {
+        node<E> *ptr = acquire_node(element); //Take a free node and put the element in it
+        ptr->next = head; //Link it in front of the list
+        head = ptr;
+        if (tail == nullptr) tail = ptr; //The list was empty
+        this->psll_rules_check();
     }
 
     //==============================================================================
     // --------- replace()  --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     E
-    PSLL<E>::replace(E element, int position) {
-        if (position > length() - 1 || position < 0) throw std::runtime_error("Sorry but that position is outside the current list boundaries");
+    PSLL<E, TrimPolicy, Allocator>::replace(E element, int position) {
+        if (position >= length() || position < 0) throw std::runtime_error("Sorry but that position is outside the current list boundaries");
         node<E> *current = head;
         for (int i = 0; i < position; i++)
             current = current->next;
+        COP3530_COUNT(node_hops, position);
         E replaced_datum = current->datum;
         current->datum = element;
+        COP3530_COUNT(copies, 1);
         return replaced_datum;
     }
 
     //==============================================================================
     // --------- remove() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     E
-    PSLL<E>::remove(int position) {
-        if (position > length() - 1 || position < 0) throw std::runtime_error("Sorry but that position is outside the current list boundaries");
+    PSLL<E, TrimPolicy, Allocator>::remove(int position) {
+        if (position >= length() || position < 0) throw std::runtime_error("Sorry but that position is outside the current list boundaries");
         if (position == 0) return pop_front();
         node<E> *previous;
         node<E> *current = head;
@@ -423,43 +1217,37 @@ namespace cop3530 {
             previous = current;
             current = current->next;
         }
+        COP3530_COUNT(node_hops, position);
         previous->next = current->next; //Link the node at position-1 to that at position+1
-        E deleted_datum = current->datum;
-        current->next = poolhead;
-        poolhead = current;
+        if (current == tail) tail = previous;
+        E deleted_datum = std::move(current->datum);
+        release_node(current);
+        this->psll_rules_check();
         return deleted_datum;
     }
 
     //==============================================================================
     // --------- pop_back() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     E
-    PSLL<E>::pop_back() {
+    PSLL<E, TrimPolicy, Allocator>::pop_back() {
         //First we need to find the last node and the second to last node of our list
         if (is_empty()) throw std::runtime_error("Error from pop_back method: the list is empty");
-        if (length() == 1) {
-            E deleted_datum = head->datum;
-            head->next = poolhead;
-            poolhead = head;
+        node<E> *eliminate = tail;
+        if (head == tail) {
             head = nullptr;
             tail = nullptr;
-            poolcount++;
-            this->psll_rules_check();
-            return deleted_datum;
+        } else {
+            node<E> *previous = head;
+            while (previous->next != tail) //Iterate to the node before the tail
+                previous = previous->next;
+            COP3530_COUNT(node_hops, length() - 1);
+            tail = previous; //Turn the node before the old tail into the new tail
+            tail->next = nullptr;
         }
-        node<E> *eliminate = head;
-        node<E> *previous;
-        while (eliminate->next != nullptr) { //Iterate to to the end of the list
-            previous = eliminate;
-            eliminate = eliminate->next;
-        }
-        tail = previous; //Turn the node before the old tail into the new tail
-        tail->next = nullptr;
-        E deleted_datum = eliminate->datum;
-        eliminate->next = poolhead;
-        poolhead = eliminate;
-        poolcount++;
+        E deleted_datum = std::move(eliminate->datum);
+        release_node(eliminate);
         this->psll_rules_check();
         return deleted_datum;
     }
@@ -467,16 +1255,15 @@ namespace cop3530 {
     //==============================================================================
     // --------- pop_front() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     E
-    PSLL<E>::pop_front() {
+    PSLL<E, TrimPolicy, Allocator>::pop_front() {
         if (this->is_empty()) throw std::runtime_error("Error: the list is empty");
         node<E> *eliminate = head;
-        E deleted_datum = eliminate->datum;
         head = head->next;
-        eliminate->next = poolhead;
-        poolhead = eliminate;
-        poolcount++;
+        if (head == nullptr) tail = nullptr;
+        E deleted_datum = std::move(eliminate->datum);
+        release_node(eliminate);
         this->psll_rules_check();
         return deleted_datum;
     }
@@ -484,22 +1271,23 @@ namespace cop3530 {
     //==============================================================================
     // --------- item_at() --------------------------------------------------------------------------------- IT WORKc
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     E
-    PSLL<E>::item_at(int position) {
-        if (position > length() - 1 || position < 0) throw std::runtime_error("Sorry but that position is outside the current list boundaries");
+    PSLL<E, TrimPolicy, Allocator>::item_at(int position) {
+        if (position >= length() || position < 0) throw std::runtime_error("Sorry but that position is outside the current list boundaries");
         node<E> *current = head;
         for (int i = 0; i < position; i++) //Iterate though the list until we reach the desired position
             current = current->next;
+        COP3530_COUNT(node_hops, position);
         return current->datum; //Return the datum at that position    
     }
 
     //==============================================================================
     // --------- peek_back() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     E
-    PSLL<E>::peek_back() {
+    PSLL<E, TrimPolicy, Allocator>::peek_back() {
         if (this->is_empty()) throw std::runtime_error("Error: the list is empty");
         return tail->datum; //Return the tail's datum
     }
@@ -507,9 +1295,9 @@ namespace cop3530 {
     //==============================================================================
     // --------- peek_front() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     E
-    PSLL<E>::peek_front() {
+    PSLL<E, TrimPolicy, Allocator>::peek_front() {
         if (this->is_empty()) throw std::runtime_error("Error: the list is empty");
         return head->datum; //Return the head's datum
     }
@@ -517,9 +1305,9 @@ namespace cop3530 {
     //==============================================================================
     // --------- is_empty() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     bool
-    PSLL<E>::is_empty() {
+    PSLL<E, TrimPolicy, Allocator>::is_empty() {
         if (head == nullptr) return true; //If we don't have a head we don't have anything in the list
         return false;
     }
@@ -527,45 +1315,36 @@ namespace cop3530 {
     //==============================================================================
     // --------- is_full() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     bool
-    PSLL<E>::is_full(void) {
+    PSLL<E, TrimPolicy, Allocator>::is_full(void) {
         return false; //This list can have an infinite amount of nodes and therefore it always returns false 
     }
 
     //==============================================================================
     // --------- length() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     size_t
-    PSLL<E>::length() {
-        node<E> *current = head;
-        size_t count = 0;
-        if (head == nullptr) return count; //If the list is empty the count is zero
-        while (current->next != nullptr) { //If the list is not empty we will count the nodes
-            count++;
-            current = current->next;
-        }
-        return ++count;
+    PSLL<E, TrimPolicy, Allocator>::length() {
+        return capacity - poolcount; //Every node in the slabs is either in the list or in the pool
     }
 
     //==============================================================================
     // --------- clear() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     void
-    PSLL<E>::clear() {
+    PSLL<E, TrimPolicy, Allocator>::clear() {
 
         if (this->is_empty()) return;
 
-        while (head != nullptr) //This deletes every element of the list except for the tail
+        COP3530_COUNT(node_hops, length());
+        while (head != nullptr) //Every node goes back to the pool
         {
             node<E> *pass_to_pool = head;
             head = head->next;
-            pass_to_pool->next = poolhead;
-            poolhead = pass_to_pool;
-            poolcount++;
-            this->psll_rules_check();
+            release_node(pass_to_pool);
         }
 
         head = nullptr;
@@ -577,24 +1356,54 @@ namespace cop3530 {
     //==============================================================================
     // --------- contains() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     bool
-    PSLL<E>::contains(E element, bool (*equals_function)(const E&, const E&)) {
-        node<E> *current = head;
-        if (equals_function(tail->datum, element)) return true; //This checks whether the object we are looking for is in the tail
-        while (current->next != nullptr) {//This checks whether the object we are looking for is anywhere else in the list
-            if (equals_function(current->datum, element)) return true;
-            current = current->next;
-        }
-        return false;
+    PSLL<E, TrimPolicy, Allocator>::contains(E element, bool (*equals_function)(const E&, const E&)) {
+        return find_if([&](const E& datum) { return equals_function(datum, element); }) != -1;
+    }
+
+    //==============================================================================
+    // --------- find_if()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    template <typename Predicate>
+    int
+    PSLL<E, TrimPolicy, Allocator>::find_if(Predicate predicate) {
+        int position = 0;
+        for (node<E> *current = head; current != nullptr; current = current->next, position++)
+            if (predicate(current->datum)) {
+                COP3530_COUNT(node_hops, position);
+                return position;
+            }
+        COP3530_COUNT(node_hops, length());
+        return -1;
+    }
+
+    //==============================================================================
+    // --------- contains() with ==
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    bool
+    PSLL<E, TrimPolicy, Allocator>::contains(const E& element) {
+        return find_if([&](const E& datum) { return datum == element; }) != -1;
+    }
+
+    //==============================================================================
+    // --------- contains() with any callable
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    template <typename Equals>
+    bool
+    PSLL<E, TrimPolicy, Allocator>::contains(const E& element, Equals equals) {
+        return find_if([&](const E& datum) { return equals(datum, element); }) != -1;
     }
 
     //==============================================================================
     // --------- print() ------------------------------------------------------------------------------------ IT WORKS
 
-    template <typename E>
+    template <typename E, typename TrimPolicy, typename Allocator>
     void
-    PSLL<E>::print(std::ostream& o) {
+    PSLL<E, TrimPolicy, Allocator>::print(std::ostream& o) {
         if (is_empty()) {
             o << "<empty list>" << std::endl;
             return;
@@ -607,8 +1416,98 @@ namespace cop3530 {
             o << t->datum << ",";
             t = t->next;
         }
+        COP3530_COUNT(node_hops, i);
         o << t->datum << "]";
     }
+
+    //==============================================================================
+    // --------- stats()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    typename PSLL<E, TrimPolicy, Allocator>::pool_stats
+    PSLL<E, TrimPolicy, Allocator>::stats() const {
+        pool_stats result;
+#ifdef COP3530_INSTRUMENT
+        static_cast<list_stats&>(result) = instrumentation;
+#endif
+        if (is_shared_pool<TrimPolicy>::value) { //Report the calling thread's segment of the shared pool
+            typename shared_node_pool<E>::segment_stats shared = shared_node_pool<E>::stats();
+            result.slabs = shared.slabs;
+            result.capacity = shared.capacity;
+            result.pooled = shared.pooled;
+            result.acquired = shared.acquired;
+            result.recycled = shared.recycled;
+            result.slab_allocations = shared.slab_allocations;
+            return result;
+        }
+        result.slabs = slab_count;
+        result.capacity = capacity;
+        result.pooled = poolcount;
+        result.acquired = acquired;
+        result.recycled = recycled;
+        result.slab_allocations = slab_allocations;
+        return result;
+    }
+
+    //==============================================================================
+    // --------- reserve()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::reserve(size_t n) {
+        if (is_shared_pool<TrimPolicy>::value) {
+            shared_node_pool<E>::reserve(n > length() ? n - length() : 0);
+            return;
+        }
+        while (capacity < n)
+            add_slab(n - capacity);
+        if (n > reserved) reserved = n;
+    }
+
+    //==============================================================================
+    // --------- swap()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::swap(PSLL& other) {
+        swap_allocator(allocator, other.allocator, typename node_traits::propagate_on_container_swap());
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(poolhead, other.poolhead);
+        std::swap(poolcount, other.poolcount);
+        std::swap(next_trim, other.next_trim);
+        std::swap(slabs, other.slabs);
+        std::swap(slab_count, other.slab_count);
+        std::swap(capacity, other.capacity);
+        std::swap(reserved, other.reserved);
+        std::swap(acquired, other.acquired);
+        std::swap(recycled, other.recycled);
+        std::swap(slab_allocations, other.slab_allocations);
+    }
+
+    //==============================================================================
+    // --------- get_allocator()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    typename PSLL<E, TrimPolicy, Allocator>::allocator_type
+    PSLL<E, TrimPolicy, Allocator>::get_allocator() const {
+        return allocator_type(allocator);
+    }
+
+    //==============================================================================
+    // --------- shrink_pool()
+
+    template <typename E, typename TrimPolicy, typename Allocator>
+    void
+    PSLL<E, TrimPolicy, Allocator>::shrink_pool() {
+        if (is_shared_pool<TrimPolicy>::value) {
+            shared_node_pool<E>::shrink();
+            return;
+        }
+        reserved = 0;
+        release_free_slabs(0);
+        next_trim = 0;
+    }
 }
 #endif /* PSLL_H */
 
@@ -0,0 +1,132 @@
+//Pool-using Singly-Linked List (PSLL) benchmark
+// - Counts calls to the global allocator and times building and walking a list, for the PSLL's slab pool
+//   and for std::forward_list, which allocates one node at a time like the PSLL used to.
+//   Two lists are built in alternation, so one-node-at-a-time allocation interleaves their nodes on the heap.
+// - Also runs a bursty workload (grow to a burst, drain back to a few items, repeat) under each trim policy.
+//
+// by Iago Patiño López
+// Build from this directory with: g++ -std=c++11 -O2 -I .. psll_bench.cpp -o psll_bench
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <forward_list>
+#include <iostream>
+#include <new>
+
+//List ADTs included below:
+#include "PSLL.h"
+
+using namespace cop3530;
+
+static long allocations = 0; //Calls to the global operator new
+
+void * operator new(std::size_t size) {
+    allocations++;
+    if (void *memory = std::malloc(size)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+double nanoseconds_since(std::chrono::steady_clock::time_point start, long operations) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / operations;
+}
+
+void psll(long length, int walks) {
+    volatile long sink = 0; //Keeps the compiler from discarding the measured calls
+    long before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    {
+        PSLL<long> list, other;
+        for (long i = 0; i < length; i++) {
+            list.push_back(i);
+            other.push_back(i);
+        }
+        double build = nanoseconds_since(start, length);
+
+        start = std::chrono::steady_clock::now();
+        for (int w = 0; w < walks; w++)
+            for (PSLL<long>::iterator it = list.begin(); it != list.end(); ++it)
+                sink = sink + *it;
+        double walk = nanoseconds_since(start, length * walks);
+
+        for (long i = 0; i < length; i++) { //Churn: every pop is followed by a push that reuses the node
+            list.pop_front();
+            list.push_back(i);
+        }
+        PSLL<long>::pool_stats stats = list.stats();
+        std::cout << "psll," << length << "," << build << "," << walk << "," << allocations - before << "," << stats.slabs << "," << stats.hit_rate() << std::endl;
+    }
+}
+
+void forward_list(long length, int walks) {
+    volatile long sink = 0;
+    long before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::forward_list<long> list, other;
+        std::forward_list<long>::iterator list_tail = list.before_begin(), other_tail = other.before_begin();
+        for (long i = 0; i < length; i++) {
+            list_tail = list.insert_after(list_tail, i);
+            other_tail = other.insert_after(other_tail, i);
+        }
+        double build = nanoseconds_since(start, length);
+
+        start = std::chrono::steady_clock::now();
+        for (int w = 0; w < walks; w++)
+            for (std::forward_list<long>::iterator it = list.begin(); it != list.end(); ++it)
+                sink = sink + *it;
+        double walk = nanoseconds_since(start, length * walks);
+
+        for (long i = 0; i < length; i++) {
+            list.pop_front();
+            list_tail = list.insert_after(list_tail, i);
+        }
+        std::cout << "forward_list," << length << "," << build << "," << walk << "," << allocations - before << ",," << std::endl;
+    }
+}
+
+//The list swings between a handful of items and a burst of them. A policy that trims on the way down allocates again on the way up.
+
+template <typename TrimPolicy>
+void bursty(const char *policy_name, long burst, int rounds, bool prewarm) {
+    volatile long sink = 0;
+    long before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    {
+        PSLL<long, TrimPolicy> list;
+        if (prewarm) list.reserve(burst);
+        for (int r = 0; r < rounds; r++) {
+            for (long i = 0; i < burst; i++)
+                list.push_back(i);
+            while (list.length() > 8)
+                sink = sink + list.pop_front();
+        }
+        std::cout << policy_name << "," << burst << "," << prewarm << "," << nanoseconds_since(start, burst * rounds) << "," << allocations - before << "," << list.stats().capacity << std::endl;
+    }
+}
+
+int main() {
+    //The bursty runs go first: once millions of small nodes have been freed, the allocator's slow paths would swamp the trim policies' differences
+    std::cout << "trim_policy,burst,reserved,ns_per_element,allocations,capacity_at_end" << std::endl;
+    for (long burst = 1000; burst <= 100000; burst *= 10) {
+        bursty<half_length_trim>("half_length", burst, 100, false);
+        bursty<fixed_cap_trim<64> >("fixed_cap_64", burst, 100, false);
+        bursty<watermark_trim<131072, 1024> >("watermark_128k_1k", burst, 100, false);
+        bursty<never_trim>("never", burst, 100, false);
+        bursty<fixed_cap_trim<64> >("fixed_cap_64", burst, 100, true);
+    }
+
+    std::cout << "list,length,build_ns_per_element,walk_ns_per_element,allocations,slabs,pool_hit_rate" << std::endl;
+    for (long length = 1000; length <= 1000000; length *= 10) {
+        psll(length, 10);
+        forward_list(length, 10);
+    }
+    return 0;
+}
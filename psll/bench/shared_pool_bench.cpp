@@ -0,0 +1,105 @@
+//Shared node pool benchmark
+// - Counts calls to the global operator new and operator delete, and times them, while many short-lived PSLLs are built and destroyed:
+//   with a pool per list (the default) and with the process-wide shared_pool.
+//   In the cross-thread run, one thread builds the lists and another destroys them, so every node goes back over the lock-free return path.
+//
+// by Iago Patiño López
+// Build from this directory with: g++ -std=c++11 -O2 -pthread -I .. shared_pool_bench.cpp -o shared_pool_bench
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <thread>
+
+//List ADTs included below:
+#include "PSLL.h"
+
+using namespace cop3530;
+
+static std::atomic<long> allocations(0), deallocations(0); //Calls to the global operator new and operator delete
+
+void * operator new(std::size_t size) {
+    allocations++;
+    if (void *memory = std::malloc(size)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept {
+    if (memory != nullptr) deallocations++;
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept {
+    if (memory != nullptr) deallocations++;
+    std::free(memory);
+}
+
+double nanoseconds_since(std::chrono::steady_clock::time_point start, long operations) {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / operations;
+}
+
+void report(const char *pool, const char *threads, long lists, int length, double nanoseconds, long news, long deletes) {
+    std::cout << pool << "," << threads << "," << lists << "," << length << "," << nanoseconds << "," << news << "," << deletes << std::endl;
+}
+
+//Every list lives just long enough to be filled and emptied once
+
+template <typename TrimPolicy>
+void same_thread(const char *pool, long lists, int length) {
+    volatile long sink = 0; //Keeps the compiler from discarding the measured calls
+    long const news = allocations, deletes = deallocations;
+    auto start = std::chrono::steady_clock::now();
+    for (long l = 0; l < lists; l++) {
+        PSLL<long, TrimPolicy> list;
+        for (int i = 0; i < length; i++)
+            list.push_back(i);
+        sink = sink + list.pop_front();
+    }
+    report(pool, "1", lists, length, nanoseconds_since(start, lists * length), allocations - news, deallocations - deletes);
+}
+
+//A producer fills lists and a consumer destroys them, a batch of lists at a time
+
+template <typename TrimPolicy>
+void cross_thread(const char *pool, long lists, int length) {
+    int const batch = 64;
+    PSLL<long, TrimPolicy> *slots[batch];
+    std::atomic<int> ready(0); //0: the producer fills the batch, 1: the consumer destroys it
+    long const news = allocations, deletes = deallocations;
+    auto start = std::chrono::steady_clock::now();
+    std::thread consumer([&]() {
+        for (long done = 0; done < lists; done += batch) {
+            while (ready.load(std::memory_order_acquire) != 1)
+                std::this_thread::yield();
+            for (int b = 0; b < batch; b++)
+                delete slots[b];
+            ready.store(0, std::memory_order_release);
+        }
+    });
+    for (long done = 0; done < lists; done += batch) {
+        while (ready.load(std::memory_order_acquire) != 0)
+            std::this_thread::yield();
+        for (int b = 0; b < batch; b++) {
+            slots[b] = new PSLL<long, TrimPolicy>;
+            for (int i = 0; i < length; i++)
+                slots[b]->push_back(i);
+        }
+        ready.store(1, std::memory_order_release);
+    }
+    consumer.join();
+    report(pool, "2", lists, length, nanoseconds_since(start, lists * length), allocations - news, deallocations - deletes);
+}
+
+int main() {
+    long const lists = 100032; //A multiple of the cross-thread batch
+    std::cout << "pool,threads,lists,length,ns_per_element,operator_new_calls,operator_delete_calls" << std::endl;
+    for (int length = 4; length <= 256; length *= 8) {
+        same_thread<half_length_trim>("per_list", lists, length);
+        same_thread<shared_pool>("shared", lists, length);
+        cross_thread<half_length_trim>("per_list", lists, length);
+        cross_thread<shared_pool>("shared", lists, length);
+    }
+    return 0;
+}
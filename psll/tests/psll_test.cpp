@@ -4,9 +4,13 @@
 // by Iago Patiño López
 // with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
 #include <iostream>
+#include <vector>
+#include <iterator>
 #include <valarray>
 #include <string>
 #include <sstream>
+#include <type_traits>
+#include <thread>
 #define DEBUG
 
 //List ADTs included below:
@@ -17,6 +21,7 @@
 //Catch testing file included below:
 #define CATCH_CONFIG_MAIN
 #include "catch.h"
+#include "counting_allocator.h"
 
 using namespace cop3530;
 
@@ -26,6 +31,14 @@ bool equals_function(const int& a, const int& b) {
     return a == b;
 }
 
+//A list on the shared pool that is destroyed after the main thread's segment has been parked
+PSLL<long, shared_pool> outlives_the_thread;
+
+//The list the shared allocator checks in counting_allocator.h run on.
+
+template <typename Allocator>
+using psll_with = PSLL<int, half_length_trim, Allocator>;
+
 class person {
 public:
     int age;
@@ -53,6 +66,35 @@ public:
     }
 };
 
+//An element whose copies can be made to fail, for the exception safety tests
+
+class fragile {
+public:
+    static bool failing; //While set, every copy throws
+    int value;
+
+    fragile(int value) : value(value) {
+    }
+
+    fragile(const fragile& other) : value(other.value) {
+        if (failing) throw std::runtime_error("Sorry, but this copy failed");
+    }
+
+    fragile & operator=(const fragile&) = default;
+};
+
+bool fragile::failing = false;
+
+//Generic code written against the static interface. The calls resolve to the concrete list at compile time.
+//clear() gives the nodes back to the pool, so filling the list again takes them from there.
+
+template <typename Derived>
+void refill(static_list<Derived, int>& list, int length) {
+    list.clear();
+    for (int i = 0; i < length; i++)
+        list.push_back(i);
+}
+
 TEST_CASE("Testing each method of the PSLL", "[PSLL]") {
 
     //Basic Functions
@@ -649,4 +691,426 @@ TEST_CASE("Testing each method of the PSLL", "[PSLL]") {
         delete test_psll_32;
     }
 
+    SECTION("Testing the slab node pool") {
+        PSLL<int, fixed_cap_trim<50> > *test_psll_34 = new PSLL<int, fixed_cap_trim<50> >;
+        REQUIRE(test_psll_34->stats().slabs == 0);
+        for (int i = 0; i < 64; i++) test_psll_34->push_back(i);
+        REQUIRE(test_psll_34->stats().slabs == 1); //The first 64 nodes come from a single slab
+        REQUIRE(test_psll_34->stats().pooled == 0);
+        test_psll_34->push_back(64);
+        REQUIRE(test_psll_34->stats().slabs == 2);
+        REQUIRE(test_psll_34->stats().capacity == 128);
+
+        for (int i = 0; i < 10; i++) REQUIRE(test_psll_34->pop_front() == i);
+        for (int i = 0; i < 10; i++) test_psll_34->push_front(i);
+        REQUIRE(test_psll_34->stats().recycled == 10); //The popped nodes were reused
+        REQUIRE(test_psll_34->stats().slab_allocations == 2);
+        REQUIRE(test_psll_34->stats().hit_rate() > 0.9);
+        REQUIRE(test_psll_34->remove(64) == 64); //Removing the tail
+        test_psll_34->push_back(99);
+        REQUIRE(test_psll_34->peek_back() == 99);
+        REQUIRE(test_psll_34->length() == 65);
+
+        test_psll_34->clear(); //Every slab is free, so all but 50 nodes' worth are released
+        REQUIRE(test_psll_34->stats().slabs == 1);
+        REQUIRE(test_psll_34->stats().pooled == 64);
+
+        PSLL<std::string> *test_psll_35 = new PSLL<std::string>;
+        for (int i = 0; i < 1000; i++) test_psll_35->push_back(std::string(40, 'a' + i % 26));
+        PSLL<std::string> *test_psll_36 = new PSLL<std::string>(*test_psll_35);
+        for (int i = 0; i < 500; i++) test_psll_35->pop_front(); //Give the half_length_trim rule a list of ≥ 100 items to act on
+        for (int i = 0; i < 390; i++) test_psll_35->pop_back();
+        REQUIRE(test_psll_35->length() == 110);
+        REQUIRE(test_psll_35->stats().capacity < 1000); //Slabs emptied by the pops were released
+        REQUIRE(test_psll_36->item_at(999) == std::string(40, 'a' + 999 % 26));
+        *test_psll_36 = std::move(*test_psll_35);
+        REQUIRE(test_psll_36->length() == 110);
+        REQUIRE(test_psll_35->stats().slabs == 0);
+
+        delete test_psll_36;
+        delete test_psll_35;
+        delete test_psll_34;
+
+        PSLL<fragile> test_psll_66; //An element that throws while it is copied into its node leaves the node in the pool
+        test_psll_66.push_back(fragile(1));
+        test_psll_66.push_back(fragile(2));
+        fragile::failing = true;
+        REQUIRE_THROWS(test_psll_66.push_back(fragile(3))); //A node that would have been carved from the slab
+        fragile::failing = false;
+        REQUIRE(test_psll_66.length() == 2);
+        REQUIRE(test_psll_66.stats().pooled == 62);
+        test_psll_66.pop_back();
+        fragile::failing = true;
+        REQUIRE_THROWS(test_psll_66.push_front(fragile(3))); //And one that would have been reused
+        REQUIRE_THROWS(test_psll_66.insert(fragile(3), 1));
+        fragile::failing = false;
+        REQUIRE(test_psll_66.length() == 1);
+        REQUIRE(test_psll_66.stats().recycled == 0);
+        test_psll_66.push_back(fragile(4));
+        REQUIRE(test_psll_66.stats().recycled == 1);
+        int sum = 0;
+        for (PSLL<fragile>::iterator it = test_psll_66.begin(); it != test_psll_66.end(); ++it) sum += it->value;
+        REQUIRE(sum == 5);
+        test_psll_66.pop_front();
+        test_psll_66.pop_front();
+        REQUIRE(test_psll_66.length() == 0);
+        REQUIRE_THROWS(test_psll_66.item_at(0));
+    }
+
+    SECTION("Testing the pool trim policies, reserve() and shrink_pool()") {
+        PSLL<int> *test_psll_37 = new PSLL<int>; //half_length_trim: nothing is trimmed below 100 items
+        for (int i = 0; i < 99; i++) test_psll_37->push_back(i);
+        test_psll_37->clear();
+        REQUIRE(test_psll_37->stats().capacity == 128);
+        REQUIRE(test_psll_37->stats().pooled == 128);
+        test_psll_37->shrink_pool();
+        REQUIRE(test_psll_37->stats().slabs == 0);
+        REQUIRE(test_psll_37->length() == 0);
+
+        PSLL<int, never_trim> *test_psll_38 = new PSLL<int, never_trim>;
+        for (int i = 0; i < 5000; i++) test_psll_38->push_back(i);
+        test_psll_38->clear();
+        REQUIRE(test_psll_38->stats().pooled == test_psll_38->stats().capacity);
+        REQUIRE(test_psll_38->stats().capacity >= 5000);
+
+        PSLL<int, watermark_trim<1000, 100> > *test_psll_39 = new PSLL<int, watermark_trim<1000, 100> >;
+        for (int i = 0; i < 2000; i++) test_psll_39->push_back(i);
+        for (int i = 0; i < 900; i++) test_psll_39->pop_back();
+        size_t const slabs = test_psll_39->stats().slabs;
+        REQUIRE(test_psll_39->stats().pooled > 800); //Below the high watermark, nothing is released
+        for (int i = 0; i < 1100; i++) test_psll_39->pop_back();
+        REQUIRE(test_psll_39->is_empty());
+        REQUIRE(test_psll_39->stats().slabs < slabs); //Past it, free slabs go
+        REQUIRE(test_psll_39->stats().pooled >= 100);
+
+        PSLL<int, fixed_cap_trim<0> > *test_psll_40 = new PSLL<int, fixed_cap_trim<0> >;
+        test_psll_40->reserve(10000);
+        REQUIRE(test_psll_40->stats().capacity >= 10000);
+        size_t const allocations = test_psll_40->stats().slab_allocations;
+        for (int i = 0; i < 10000; i++) test_psll_40->push_back(i);
+        test_psll_40->clear(); //The reserved nodes survive trimming
+        for (int i = 0; i < 10000; i++) test_psll_40->push_front(i);
+        REQUIRE(test_psll_40->stats().slab_allocations == allocations);
+        REQUIRE(test_psll_40->length() == 10000);
+        REQUIRE(test_psll_40->peek_back() == 0);
+        test_psll_40->clear();
+        test_psll_40->shrink_pool();
+        REQUIRE(test_psll_40->stats().capacity == 0);
+
+        delete test_psll_40;
+        delete test_psll_39;
+        delete test_psll_38;
+        delete test_psll_37;
+    }
+
+    SECTION("Testing the shared node pool") {
+        size_t const slabs = shared_node_pool<long>::stats().slab_allocations;
+        PSLL<long, shared_pool> *test_psll_41 = new PSLL<long, shared_pool>;
+        for (long i = 0; i < 100; i++) test_psll_41->push_back(i);
+        delete test_psll_41;
+        for (int round = 0; round < 100; round++) { //Short-lived lists reuse the nodes of the ones before them
+            PSLL<long, shared_pool> short_lived;
+            for (long i = 0; i < 100; i++) short_lived.push_front(i);
+            REQUIRE(short_lived.length() == 100);
+            REQUIRE(short_lived.pop_back() == 0);
+        }
+        REQUIRE(shared_node_pool<long>::stats().slab_allocations <= slabs + 1);
+
+        PSLL<long, shared_pool> *test_psll_42 = new PSLL<long, shared_pool>;
+        for (long i = 0; i < 1000; i++) test_psll_42->push_back(i);
+        PSLL<long, shared_pool> test_psll_43(*test_psll_42);
+        REQUIRE(test_psll_43.remove(500) == 500);
+        REQUIRE(test_psll_43.length() == 999);
+        std::thread other([&]() { //Nodes freed on another thread go back to this thread's segment
+            delete test_psll_42;
+        });
+        other.join();
+        size_t const remote = shared_node_pool<long>::stats().remote_returns;
+        REQUIRE(remote >= 1000);
+        size_t moved_length = 0;
+        std::thread builder([&]() { //And nodes taken on another thread come from that thread's segment
+            PSLL<long, shared_pool> moved(std::move(test_psll_43));
+            moved.push_back(1000);
+            moved_length = moved.length();
+        });
+        builder.join();
+        REQUIRE(moved_length == 1000);
+        REQUIRE(shared_node_pool<long>::stats().remote_returns == remote + 999); //All but the node the builder pushed came home
+
+        PSLL<long, shared_pool> test_psll_62;
+        for (long i = 0; i < 10; i++) test_psll_62.push_back(i);
+        test_psll_62.shrink_pool(); //Every slab of this thread's segment but the one test_psll_62 uses is idle
+        REQUIRE(test_psll_62.stats().slabs == 1);
+        test_psll_62.clear();
+        test_psll_62.shrink_pool();
+        REQUIRE(test_psll_62.stats().slabs == 0);
+        REQUIRE(test_psll_62.stats().pooled == 0);
+        test_psll_62.push_back(1); //And a new slab after that
+        REQUIRE(test_psll_62.stats().slabs == 1);
+
+        shared_node_pool<long>::segment_stats reclaimed;
+        std::thread reclaimer([&]() { //Takes over the segment the builder parked, whose slabs are idle by now
+            reclaimed = shared_node_pool<long>::stats();
+        });
+        reclaimer.join();
+        REQUIRE(reclaimed.slab_allocations >= 1);
+        REQUIRE(reclaimed.slabs == 0);
+
+        for (long i = 0; i < 3; i++) outlives_the_thread.push_back(i); //Destroyed at exit, after this thread's handle
+
+        PSLL<fragile, shared_pool> test_psll_67; //An element that throws while it is copied gives its node back to the segment
+        test_psll_67.push_back(fragile(1));
+        fragile::failing = true;
+        REQUIRE_THROWS(test_psll_67.push_back(fragile(2)));
+        REQUIRE_THROWS(test_psll_67.push_front(fragile(2)));
+        fragile::failing = false;
+        REQUIRE(test_psll_67.length() == 1);
+        test_psll_67.push_back(fragile(3));
+        int sum = 0;
+        for (PSLL<fragile, shared_pool>::iterator it = test_psll_67.begin(); it != test_psll_67.end(); ++it) sum += it->value;
+        REQUIRE(sum == 4);
+        test_psll_67.clear();
+        REQUIRE(test_psll_67.length() == 0);
+        test_psll_67.shrink_pool(); //No node is left in use, so the slab is idle and goes back
+        REQUIRE(test_psll_67.stats().slabs == 0);
+    }
+
+    SECTION("Testing the allocator") {
+        require_allocator_propagation<psll_with>();
+
+        allocation_log log;
+        typedef counting_allocator<int, true> propagating;
+        {
+            PSLL<int, never_trim, propagating> test_psll_44(propagating(1, &log));
+            test_psll_44.push_back(0);
+            REQUIRE(log.allocations == 2); //A slab header and a slab of 64 nodes, through two allocators rebound from ours
+            REQUIRE(log.last_allocation == 64 * sizeof (node<int>));
+            REQUIRE(log.bytes > long(64 * sizeof (node<int>)));
+            REQUIRE(log.constructions == 1); //Raw storage: only the nodes that hold an element are constructed
+            for (int i = 1; i < 64; i++) test_psll_44.push_back(i);
+            REQUIRE(log.allocations == 2);
+            test_psll_44.push_back(64);
+            REQUIRE(log.allocations == 4); //The next slab
+            REQUIRE(log.last_allocation == 64 * sizeof (node<int>));
+            REQUIRE(log.constructions == 65);
+
+            test_psll_44.clear(); //The nodes go back to the pool, not to the allocator
+            for (int i = 0; i < 65; i++) test_psll_44.push_back(i);
+            REQUIRE(log.allocations == 4);
+            REQUIRE(log.deallocations == 0);
+            REQUIRE(test_psll_44.item_at(64) == 64);
+
+            test_psll_44.clear();
+            test_psll_44.shrink_pool(); //Every slab goes back, and so does the table of slabs shrink_pool() sorts them in
+            REQUIRE(log.bytes == 0);
+            REQUIRE(log.allocations == 5);
+            REQUIRE(log.deallocations == 5);
+            test_psll_44.push_back(1);
+            REQUIRE(log.allocations == 7);
+        }
+        REQUIRE(log.bytes == 0);
+    }
+
+    SECTION("Testing the static interface and the virtual adapter") {
+        REQUIRE(is_static_list<PSLL<int> >::value);
+        PSLL<int> test_psll_50;
+        refill(test_psll_50, 100);
+        size_t const slabs = test_psll_50.stats().slab_allocations;
+        refill(test_psll_50, 100);
+        REQUIRE(test_psll_50.stats().slab_allocations == slabs); //Every node came back from the pool
+        REQUIRE(test_psll_50.stats().recycled >= 100);
+        REQUIRE(test_psll_50.peek_back() == 99);
+
+        virtual_list<PSLL<int> > test_psll_51;
+        List<int>& dynamic = test_psll_51; //Only the adapter is a List<int>
+        PSLL<int>& concrete = test_psll_51.get(); //The PSLL's own members work on the list behind the adapter
+        concrete.reserve(64);
+        size_t const reserved = concrete.stats().slab_allocations;
+        refill(concrete, 64);
+        REQUIRE(concrete.stats().slab_allocations == reserved);
+        REQUIRE(dynamic.length() == 64);
+        REQUIRE(dynamic.item_at(10) == 10);
+        dynamic.clear();
+        REQUIRE(dynamic.is_empty());
+        REQUIRE(concrete.stats().pooled >= 64);
+    }
+
+    SECTION("Testing find_if and contains on pooled nodes") {
+        PSLL<int, never_trim> test_psll_52; //Removed nodes go to the pool and come back out last in, first out
+        for (int i = 0; i < 100; i++) test_psll_52.push_back(i);
+        for (int i = 0; i < 60; i++) test_psll_52.pop_back();
+        for (int i = 0; i < 30; i++) test_psll_52.push_front(100 + i); //Taken from the pool, not carved in list order
+        REQUIRE(test_psll_52.stats().recycled >= 30);
+        REQUIRE(test_psll_52.find_if([](const int& x) { return x < 100; }) == 30); //Positions follow the links
+        REQUIRE(test_psll_52.find_if([](const int& x) { return x == 100; }) == 29);
+        REQUIRE(test_psll_52.find_if([](const int& x) { return x >= 40 && x < 100; }) == -1); //Popped values still sit in pooled nodes
+        REQUIRE(!test_psll_52.contains(99));
+        REQUIRE(test_psll_52.contains(39));
+        REQUIRE(test_psll_52.contains(129, [](const int& datum, const int& element) { return datum == element; }));
+        REQUIRE(test_psll_52.contains(115, equals_function));
+
+        PSLL<int, shared_pool> test_psll_53; //On the shared pool, the nodes another list let go of are reused
+        REQUIRE(test_psll_53.find_if([](const int&) { return true; }) == -1);
+        REQUIRE(!test_psll_53.contains(0));
+        {
+            PSLL<int, shared_pool> released;
+            for (int i = 0; i < 10; i++) released.push_back(1000 + i);
+        }
+        for (int i = 0; i < 10; i++) test_psll_53.push_back(i);
+        REQUIRE(!test_psll_53.contains(1000));
+        REQUIRE(test_psll_53.find_if([](const int& x) { return x == 9; }) == 9);
+    }
+
+    SECTION("Testing copy_to") {
+        allocation_log log;
+        typedef counting_allocator<int, false> sticky;
+        PSLL<int, never_trim, sticky> test_psll_54(sticky(1, &log));
+        int buffer[5] = {-1, -1, -1, -1, -1};
+        REQUIRE(test_psll_54.copy_to(buffer) == buffer); //An empty list writes nothing
+        for (int i = 0; i < 100; i++) test_psll_54.push_back(i);
+        while (!test_psll_54.is_empty()) test_psll_54.pop_front(); //Every node goes back to the pool
+        for (int i = 0; i < 4; i++) test_psll_54.push_back(i * i); //And comes back out with an old value overwritten
+        REQUIRE(test_psll_54.stats().recycled >= 4);
+        long const allocations = log.allocations;
+        REQUIRE(test_psll_54.copy_to(buffer) == buffer + 4);
+        for (int i = 0; i < 4; i++) REQUIRE(buffer[i] == i * i);
+        REQUIRE(buffer[4] == -1);
+        REQUIRE(log.allocations == allocations); //Nothing is allocated
+
+        std::vector<int> appended(1, 7);
+        static_list<PSLL<int, never_trim, sticky>, int>& interface = test_psll_54;
+        test_psll_54.remove(1); //Its node goes back to the pool, and the list skips it
+        test_psll_54.push_front(-1); //Then it is reused at the front
+        interface.copy_to(std::back_inserter(appended));
+        REQUIRE(appended == std::vector<int>({7, -1, 0, 4, 9}));
+    }
+
+    SECTION("Testing insert_after, emplace_after, erase_after and splice_after") {
+        PSLL<int> test_psll_55;
+        PSLL<int>::iterator it = test_psll_55.insert_after(test_psll_55.before_begin(), 2); //Works on an empty list
+        it = test_psll_55.insert_after(it, 4);
+        test_psll_55.insert_after(test_psll_55.before_begin(), 0);
+        test_psll_55.push_back(6); //The tail followed the insertions
+        REQUIRE(test_psll_55.length() == 4);
+        REQUIRE(test_psll_55.peek_back() == 6);
+        std::ostringstream before;
+        test_psll_55.print(before);
+        REQUIRE(before.str() == "[0,2,4,6]");
+
+        for (int i = 7; i < 20; i++) test_psll_55.push_back(i);
+        PSLL<int>::iterator previous = test_psll_55.before_begin(); //test_psll_55 filter pass: drop the odd elements in one traversal
+        REQUIRE(previous != test_psll_55.end()); //before_begin() is a position of its own
+        REQUIRE(previous == test_psll_55.before_begin());
+        for (PSLL<int>::iterator current = test_psll_55.begin(); current != test_psll_55.end();) {
+            if (*current % 2 != 0) current = test_psll_55.erase_after(previous);
+            else previous = current++;
+        }
+        REQUIRE(test_psll_55.length() == 10);
+        REQUIRE(test_psll_55.peek_back() == 18);
+        REQUIRE(test_psll_55.item_at(4) == 8);
+        REQUIRE_THROWS(test_psll_55.erase_after(previous)); //previous is the tail
+        test_psll_55.erase_after(test_psll_55.before_begin());
+        REQUIRE(test_psll_55.peek_front() == 2);
+
+        PSLL<std::string> test_psll_57;
+        PSLL<std::string>::iterator word = test_psll_57.emplace_after(test_psll_57.before_begin(), 3, 'x');
+        test_psll_57.emplace_after(word, "yz");
+        REQUIRE(test_psll_57.peek_front() == "xxx");
+        REQUIRE(test_psll_57.peek_back() == "yz");
+        test_psll_57.erase_after(word);
+        test_psll_57.erase_after(test_psll_57.before_begin());
+        REQUIRE(test_psll_57.is_empty());
+
+        PSLL<int> test_psll_63; //A filter pass that removes every element: end() throws on an empty list, so emptiness is checked first
+        for (int i = 0; i < 5; i++) test_psll_63.push_back(2 * i + 1);
+        previous = test_psll_63.before_begin();
+        PSLL<int>::iterator current = test_psll_63.begin();
+        while (!test_psll_63.is_empty() && current != test_psll_63.end()) {
+            if (*current % 2 != 0) current = test_psll_63.erase_after(previous);
+            else previous = current++;
+        }
+        REQUIRE(test_psll_63.is_empty());
+        REQUIRE(previous == test_psll_63.before_begin());
+        REQUIRE_THROWS(test_psll_63.erase_after(previous));
+        REQUIRE_THROWS(test_psll_63.insert_after(current, 1)); //current is end(), after which nothing can go
+        REQUIRE(test_psll_63.is_empty());
+        test_psll_63.insert_after(previous, 1);
+        test_psll_63.push_back(3);
+        current = test_psll_63.erase_after(test_psll_63.begin()); //Erasing the tail returns end()
+        REQUIRE(current == test_psll_63.end());
+        REQUIRE_THROWS(test_psll_63.insert_after(current, 5)); //Not the front of the list
+        REQUIRE_THROWS(test_psll_63.insert_after(test_psll_55.before_begin(), 5)); //Nor another list's before_begin()
+        REQUIRE(test_psll_63.length() == 1);
+        REQUIRE(test_psll_63.peek_front() == 1);
+
+        PSLL<int> test_psll_56;
+        for (int i = 0; i < 3; i++) test_psll_56.push_back(100 + i);
+        REQUIRE_THROWS(test_psll_55.splice_after(test_psll_55.before_begin(), test_psll_56)); //The nodes are in the other list's slabs, so two private pools do not splice
+        REQUIRE_THROWS(test_psll_55.splice_after(test_psll_55.before_begin(), test_psll_56, test_psll_56.before_begin()));
+        REQUIRE_THROWS(test_psll_55.splice_after(test_psll_55.before_begin(), test_psll_56, test_psll_56.before_begin(), test_psll_56.end()));
+        REQUIRE(test_psll_56.length() == 3); //And nothing was moved
+        REQUIRE(test_psll_56.peek_front() == 100);
+        REQUIRE(test_psll_55.length() == 9);
+        for (int i = 2; i >= 0; i--) test_psll_55.push_front(100 + i);
+
+        test_psll_55.splice_after(test_psll_55.before_begin(), test_psll_55, ++test_psll_55.begin()); //The third element to the front, within the same list
+        REQUIRE(test_psll_55.peek_front() == 102);
+        REQUIRE(test_psll_55.item_at(1) == 100);
+        REQUIRE(test_psll_55.item_at(2) == 101);
+        test_psll_55.splice_after(test_psll_55.begin(), test_psll_55, test_psll_55.begin()); //Already in place
+        REQUIRE(test_psll_55.peek_front() == 102);
+        REQUIRE(test_psll_55.item_at(1) == 100);
+        PSLL<int>::iterator third = ++++test_psll_55.begin();
+        test_psll_55.splice_after(test_psll_55.before_begin(), test_psll_55, third, test_psll_55.end()); //Everything after the third element to the front
+        REQUIRE(test_psll_55.length() == 12);
+        REQUIRE(test_psll_55.peek_front() == 2);
+        REQUIRE(test_psll_55.peek_back() == 101);
+        test_psll_55.push_back(7); //The tail followed
+        REQUIRE(test_psll_55.item_at(12) == 7);
+
+        PSLL<int, shared_pool> test_psll_58, test_psll_59; //On the shared pool the nodes themselves change lists
+        for (int i = 0; i < 5; i++) test_psll_58.push_back(i);
+        int *kept = &*test_psll_58.begin();
+        test_psll_59.splice_after(test_psll_59.before_begin(), test_psll_58, test_psll_58.before_begin(), test_psll_58.end());
+        REQUIRE(test_psll_58.is_empty());
+        REQUIRE(test_psll_59.length() == 5);
+        REQUIRE(&*test_psll_59.begin() == kept);
+        REQUIRE(test_psll_58.length() == 0);
+        test_psll_58.push_back(9);
+        test_psll_58.splice_after(test_psll_58.begin(), test_psll_59, test_psll_59.before_begin()); //A single node
+        REQUIRE(&*++test_psll_58.begin() == kept);
+        test_psll_58.splice_after(test_psll_58.before_begin(), test_psll_59); //And a whole list
+        REQUIRE(test_psll_59.is_empty());
+        REQUIRE(test_psll_58.length() == 6);
+        REQUIRE(test_psll_58.peek_front() == 1);
+        REQUIRE(test_psll_58.peek_back() == 0);
+
+        allocation_log log;
+        typedef counting_allocator<int, false> sticky;
+        PSLL<int, shared_pool, sticky> test_psll_64(sticky(1, &log)), test_psll_65(sticky(2, &log));
+        test_psll_65.push_back(1);
+        REQUIRE_THROWS(test_psll_64.splice_after(test_psll_64.before_begin(), test_psll_65)); //Elements from an unequal allocator cannot be relinked either
+        REQUIRE(test_psll_65.length() == 1);
+    }
+
+    SECTION("Testing the instrumentation counters") {
+        PSLL<int> test_psll_60;
+        for (int i = 0; i < 3; i++) test_psll_60.push_back(i); //The first push allocates a slab
+        test_psll_60.pop_front();
+        test_psll_60.push_back(3); //Back from the pool
+        test_psll_60.item_at(2);
+        PSLL<int>::pool_stats counted = test_psll_60.stats();
+        REQUIRE(counted.acquired == 4); //The pool counters are kept either way
+#ifdef COP3530_INSTRUMENT
+        REQUIRE(counted.pool_misses == 1);
+        REQUIRE(counted.pool_hits == 3);
+        REQUIRE(counted.allocations == 2); //The slab's header and its nodes
+        REQUIRE(counted.copies == 4);
+        REQUIRE(counted.node_hops == 2);
+#else
+        REQUIRE(counted.pool_misses == 0); //Not counted at all
+        REQUIRE(counted.node_hops == 0);
+#endif
+    }
+
 }
@@ -1,19 +1,37 @@
 //Simple Dynamic Array-based List (SDAL)
 //A basic implementation: the initial array size is passed as a parameter to the constructor; if no value is passed then default to a backing array with 50 slots. Whenever an item is added and the backing array is full, allocate a new array 150% the size of the original, copy the items over to the new array, and deallocate the original one.
 //Because we don't want the list to waste too much memory, whenever the array's size is ≥ twice the starting capacity and fewer than half the slots are used, allocate a new array 75% the size of the current array, copy the items over to the new array, and deallocate the current array, and use the new array as the backing store.
+//The backing array is raw, uninitialized storage: only the slots before tail hold constructed elements. When the array is replaced the elements are moved (or, for trivially copyable types, memcpy'd) into the new one instead of being copied.
+//The storage, and the elements in it, go through the Allocator template parameter following std::allocator_traits.
+//view() hands out the elements in place as a span, and copy_to() copies them into a caller's buffer without allocating.
+//find(), count(), min(), max() and sum() run over the array with the SIMD kernels of Kernels.h.
+//With incremental_growth as the third template parameter, a full array is not replaced in one go: push_back allocates the larger array and that push and
+//the following ones (and pop_back) move a few elements each, so push_back is O(1) in the worst case. item_at(), replace(), peek_back() and peek_front()
+//look in whichever array holds the position; every other operation that reads the elements, and any insert() or remove() but at the end, first moves what is left.
+//That includes the const begin(), end() and view(), so, while the list is growing, concurrent const readers need a lock like any writer would.
+//on_resize() reports every grow and shrink of the array, with its wall time, to a callback.
+//Built with COP3530_INSTRUMENT, stats() reports the elements written and shifted, the calls to the allocator and every resize with the bytes it moved.
 // by Iago Patiño López
 // with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
 
 #ifndef SDAL_H
 #define SDAL_H
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
 #include <stdexcept>
 #include <iostream>
+#include <iterator>
+#include <type_traits>
+#include <utility>
 #include "List.h"
+#include "Kernels.h"
 
 namespace cop3530 {
 
-    template <typename E>
-    class SDAL : public List<E> { //We need to create the list class
+    template <typename E, typename Allocator = std::allocator<E>, typename Growth = all_at_once_growth>
+    class SDAL : public static_list<SDAL<E, Allocator, Growth>, E> { //We need to create the list class
 
     public:
 
@@ -21,27 +39,37 @@ namespace cop3530 {
         class SDAL_Iter {
         public:
             // type aliases required for C++ iterator compatibility
-            using value_type = T;
+            using value_type = typename std::remove_const<T>::type;
             using reference = T&;
             using pointer = T*;
             using difference_type = std::ptrdiff_t;
-            using iterator_category = std::forward_iterator_tag;
+            using iterator_category = std::random_access_iterator_tag; //The elements are contiguous, so this is a plain pointer underneath
+#if __cplusplus > 201703L
+            using iterator_concept = std::contiguous_iterator_tag;
+#endif
 
             // type aliases for prettier code
             using self_type = SDAL_Iter;
             using self_reference = SDAL_Iter&;
 
         private:
-            E* here; //This is the pointer the the list member the iterator is pointing at
+            T* here; //This is the pointer the the list member the iterator is pointing at
+
+            template <typename U>
+            friend class SDAL_Iter;
 
         public:
 
-            explicit SDAL_Iter(E *start = nullptr) : here(start) { //This is the explicit constructor for the iterator class. It does not allow implicit conversions or copy-initialization.
+            explicit SDAL_Iter(T *start = nullptr) : here(start) { //This is the explicit constructor for the iterator class. It does not allow implicit conversions or copy-initialization.
             }
 
             SDAL_Iter(const SDAL_Iter& src) : here(src.here) { //This is the regular constructor for the iterator class
             }
 
+            template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+            SDAL_Iter(const SDAL_Iter<U>& src) : here(src.here) { //An iterator converts to a const_iterator
+            }
+
             reference operator*() const {
                 return *here; //temporary line
             }
@@ -51,6 +79,10 @@ namespace cop3530 {
                 return temp;
             }
 
+            reference operator[](difference_type n) const {
+                return here[n];
+            }
+
             self_reference operator=(SDAL_Iter<T> const& src) {
                 here = SDAL_Iter(src).here;
                 return *this; //temporary line
@@ -67,6 +99,43 @@ namespace cop3530 {
                 return temp;
             } // postincrement
 
+            self_reference operator--() {
+                here = here - 1;
+                return *this;
+            } // predecrement
+
+            self_type operator--(int) {
+                SDAL_Iter temp(*this);
+                here = here - 1;
+                return temp;
+            } // postdecrement
+
+            self_reference operator+=(difference_type n) {
+                here += n;
+                return *this;
+            }
+
+            self_reference operator-=(difference_type n) {
+                here -= n;
+                return *this;
+            }
+
+            self_type operator+(difference_type n) const {
+                return SDAL_Iter(here + n);
+            }
+
+            friend self_type operator+(difference_type n, SDAL_Iter const& it) {
+                return SDAL_Iter(it.here + n);
+            }
+
+            self_type operator-(difference_type n) const {
+                return SDAL_Iter(here - n);
+            }
+
+            difference_type operator-(SDAL_Iter<T> const& rhs) const {
+                return here - rhs.here;
+            }
+
             bool operator==(SDAL_Iter<T> const& rhs) const {
                 if (here == rhs.here)
                     return true;
@@ -81,6 +150,22 @@ namespace cop3530 {
                     return false;
             }
 
+            bool operator<(SDAL_Iter<T> const& rhs) const {
+                return here < rhs.here;
+            }
+
+            bool operator>(SDAL_Iter<T> const& rhs) const {
+                return here > rhs.here;
+            }
+
+            bool operator<=(SDAL_Iter<T> const& rhs) const {
+                return here <= rhs.here;
+            }
+
+            bool operator>=(SDAL_Iter<T> const& rhs) const {
+                return here >= rhs.here;
+            }
+
         }; // end SDAL_Iter        
 
         using size_t = std::size_t; // you may comment out this line if your compiler complains
@@ -89,30 +174,37 @@ namespace cop3530 {
         using const_iterator = SDAL_Iter<E const>;
 
         //operations
-        SDAL(int); //This is the constructor method with input 
+        using allocator_type = Allocator;
+
+        SDAL(int, const Allocator& allocator = Allocator()); //This is the constructor method with input 
         SDAL(); //This is the constructor method without input
+        explicit SDAL(const Allocator& allocator); //Constructs an empty list with the default 50 slots, taken from the given allocator
         SDAL(const SDAL& other); //copy constructor
         SDAL(SDAL&& other); //move constructor
         ~SDAL(); //This is the destructor method of the singly linked list
 
         iterator begin() {
             if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
+            finish_migration();
             return SDAL_Iter<E>(array);
         }
 
         iterator end() {
             if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
-            return SDAL_Iter<E>(&array[tail]);
+            finish_migration();
+            return SDAL_Iter<E>(array + tail);
         }
 
         const_iterator begin() const {
-            if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
-            return SDAL_Iter<E>(array);
+            if (tail == 0) throw std::runtime_error("Sorry, but the list is empty");
+            finish_migration(); //Moving elements between the arrays leaves the list itself unchanged
+            return const_iterator(array);
         }
 
         const_iterator end() const {
-            if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
-            return SDAL_Iter<E>(array[tail]);
+            if (tail == 0) throw std::runtime_error("Sorry, but the list is empty");
+            finish_migration();
+            return const_iterator(array + tail);
         }
         SDAL & operator=(const SDAL & other);
         SDAL & operator=(SDAL&& other);
@@ -131,186 +223,372 @@ namespace cop3530 {
         size_t length(void); //Returns the number of elements in the list as a size_t
         void clear(void); //removes all elements from the list
         bool contains(E element, bool (*equals_function)(const E&, const E&)); //returns true IFF at least one of the elements of the list matches the specified element
+        template <typename Predicate>
+        int find_if(Predicate predicate); //Returns the position of the first element for which predicate(element) is true, or -1 if there is none
+        bool contains(const E& element); //returns true IFF at least one of the elements of the list is == to the specified element
+        template <typename Equals>
+        bool contains(const E& element, Equals equals); //returns true IFF equals(list element, element) holds for at least one of the elements. Any callable works, and the compiler can inline it.
+        int find(const E& element); //Returns the position of the first element == to the specified element, or -1. These five use the SIMD kernels of Kernels.h.
+        size_t count(const E& element); //Returns how many elements are == to the specified element
+        E min(void); //Returns the smallest element
+        E max(void); //Returns the largest element
+        typename sum_type<E>::type sum(void); //Returns the sum of the elements, added up in a wider type
         void print(std::ostream& o); //If the list is empty, inserts "<empty list>" into the ostream; otherwise, inserts, enclosed in square brackets, the list's elements, separated by commas, in sequential order 
 
         E * const contents(); //Allocates, initializes, and returns an array containing a copy of the list's elements in sequential order
+        template <typename OutputIt>
+        OutputIt copy_to(OutputIt out); //Writes the elements, in sequential order, through out (a caller's buffer, a back_inserter...) and returns it past the last one. Allocates nothing.
+        span<E> view(); //Returns the elements in place, as one contiguous span, without copying them. Adding or removing elements invalidates the view.
+        span<const E> view() const;
+
+        void swap(SDAL& other); //Exchanges the contents of the two lists. The allocators are exchanged too if they propagate on swap; otherwise they must compare equal.
+        allocator_type get_allocator() const; //Returns a copy of the allocator
+        list_stats stats() const; //What the list's operations have done so far. All zeros unless built with COP3530_INSTRUMENT.
+        void on_resize(resize_listener listener, void *context = nullptr); //Calls listener(event, context) after every resize, see resize_event. nullptr stops it.
 
     private:
+        using traits = std::allocator_traits<Allocator>;
+        static constexpr bool incremental = std::is_same<Growth, incremental_growth>::value;
+        static constexpr size_t migration_step = 4; //Elements moved per operation while growing incrementally: enough to empty the old array before the new one fills
+
+        size_t grown_size(void) const; //The size of the array upsize() or start_migration() replaces the current one with
         void upsize(void);
         void adjust_size(void);
+        void resize(size_t new_size); //Moves the elements into a new backing array with room for new_size elements
+        E *allocate(size_t slots); //Returns uninitialized storage for the given number of elements
+        void relocate(E *from, size_t count, E *to) const; //Moves count elements into uninitialized storage and destroys the originals
+        void destroy(E *first, E *last); //Destroys the elements in [first, last)
+        void take_array(SDAL& other); //Takes over the other list's array, which must have come from an equal allocator, and gives it a new empty one
+        void start_migration(void); //Incremental growth: replaces the array with a larger one but leaves the elements in the old one, for migrate() to move
+        void migrate(size_t steps) const; //Moves up to steps elements out of the old array, and deallocates it once it is empty
+        void finish_migration(void) const; //Moves whatever is left in the old array, so that every element is in array
+        E& slot(size_t position); //Returns the element at the given position, in whichever array it is
+        const E& slot(size_t position) const;
         //variables
+        mutable Allocator allocator; //mutable, like the migration state below, so that the const begin(), end() and view() can finish a migration
         size_t size;
         size_t starting_size;
         E *array;
         //E *tail;
         int tail;
+        mutable E *old_array; //Incremental growth: the array the elements are being moved out of, or nullptr
+        size_t old_size;
+        mutable size_t migrated; //Positions [migrated, old_end) are still in old_array, at the same index. Every other position is in array.
+        size_t old_end;
+        resize_notifier notifier; //See on_resize()
+#ifdef COP3530_INSTRUMENT
+        mutable list_stats instrumentation;
+#endif
     };
 
     //==============================================================================
     // ------- constructor  
 
-    template <typename E>
-    SDAL<E>::SDAL(int input) {
+    template <typename E, typename Allocator, typename Growth>
+    SDAL<E, Allocator, Growth>::SDAL(int input, const Allocator& allocator) : allocator(allocator) {
         size = input;
         starting_size = size;
-        array = new E[size];
+        array = allocate(size);
         tail = 0;
+        old_array = nullptr;
     }
 
     //==============================================================================
     // ------- constructor 2 
 
-    template <typename E>
-    SDAL<E>::SDAL() {
-        size = 50;
-        starting_size = size;
-        array = new E[size];
-        tail = 0;
+    template <typename E, typename Allocator, typename Growth>
+    SDAL<E, Allocator, Growth>::SDAL() : SDAL(50) {
+    }
+
+    template <typename E, typename Allocator, typename Growth>
+    SDAL<E, Allocator, Growth>::SDAL(const Allocator& allocator) : SDAL(50, allocator) {
     }
 
     //==============================================================================
     // ------- copy constructor 
 
-    template <typename E>
-    SDAL<E>::SDAL(const SDAL& other) {
+    template <typename E, typename Allocator, typename Growth>
+    SDAL<E, Allocator, Growth>::SDAL(const SDAL& other) : allocator(traits::select_on_container_copy_construction(other.allocator)) {
         size = other.size; //Copy the size of the array
         starting_size = other.starting_size; //Copy the starting size
-        array = new E[size];
+        array = allocate(size);
+        old_array = nullptr;
         
-        for (int i = 0; i<other.tail; i++){
-            array[i] = other.array[i];
-            tail = i;
-        }
-        tail++;
+        for (tail = 0; tail < other.tail; tail++)
+            traits::construct(allocator, &array[tail], other.slot(tail)); //other may still be moving elements out of its old array
+        COP3530_COUNT(copies, tail);
     }
 
     // ------- copy-assignment operator 
 
-    template <typename E>
-    SDAL<E> &
-    SDAL<E>::operator=(const SDAL & other) {
-        
+    template <typename E, typename Allocator, typename Growth>
+    SDAL<E, Allocator, Growth> &
+    SDAL<E, Allocator, Growth>::operator=(const SDAL & other) {
+        if (this == &other) return *this;
+        finish_migration();
+        destroy(array, array + tail);
+        traits::deallocate(allocator, array, size); //With the allocator it came from, before that may be replaced
+        COP3530_COUNT(frees, 1);
+        assign_allocator(allocator, other.allocator, typename traits::propagate_on_container_copy_assignment());
+
         size = other.size; //Copy the size of the array
         starting_size = other.starting_size; //Copy the starting size
-        array = new E[size];
-                for (int i = 0; i<other.tail; i++){
-            array[i] = other.array[i];
-            tail = i;
-        }
-        tail++;
+        array = allocate(size);
+        for (tail = 0; tail < other.tail; tail++)
+            traits::construct(allocator, &array[tail], other.slot(tail));
+        COP3530_COUNT(copies, tail);
         return *this;
     }
 
     // ------  move constructor
 
-    template <typename E>
-    SDAL<E>::SDAL(SDAL&& other) {
-        //Soft copy old list
+    template <typename E, typename Allocator, typename Growth>
+    SDAL<E, Allocator, Growth>::SDAL(SDAL&& other) : allocator(other.allocator) {
+        other.finish_migration();
+        take_array(other);
+    }
+    // ------- move assignment operator 
+
+    template <typename E, typename Allocator, typename Growth>
+    SDAL<E, Allocator, Growth> &
+    SDAL<E, Allocator, Growth>::operator=(SDAL&& other) {
+        
+        if (this != &other) {
+            finish_migration();
+            other.finish_migration();
+            if (traits::propagate_on_container_move_assignment::value || allocator == other.allocator) {
+                destroy(array, array + tail);
+                traits::deallocate(allocator, array, size);
+                COP3530_COUNT(frees, 1);
+                move_allocator(allocator, other.allocator, typename traits::propagate_on_container_move_assignment());
+                take_array(other);
+            } else { //Our allocator cannot free the other list's array, so the elements are moved into an array of our own
+                clear();
+                for (int i = 0; i < other.tail; i++)
+                    push_back(std::move(other.array[i]));
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    // ------  destructor 
+
+    template <typename E, typename Allocator, typename Growth>
+    SDAL<E, Allocator, Growth>::~SDAL() {
+        finish_migration();
+        destroy(array, array + tail);
+        traits::deallocate(allocator, array, size);
+    }
+
+    //==============================================================================
+    // --------- take_array()
+
+    template <typename E, typename Allocator, typename Growth>
+    void
+    SDAL<E, Allocator, Growth>::take_array(SDAL& other) {
+        //Soft copy old list, which must not be in the middle of a migration
         array = other.array;
+        old_array = nullptr;
         tail = other.tail;
         size = other.size;
         starting_size = other.starting_size;
 
         //Reset old list
-        other.array = new E[size];
-        other.tail = 0;
         other.size = 50;
         other.starting_size = 50;
+        other.array = other.allocate(other.size);
+        other.tail = 0;
+    }
+
+    //==============================================================================
+    // operations
+
+    //==============================================================================
+    // --------- allocate()
 
+    template <typename E, typename Allocator, typename Growth>
+    E *
+    SDAL<E, Allocator, Growth>::allocate(size_t slots) {
+        COP3530_COUNT(allocations, 1);
+        return traits::allocate(allocator, slots); //Unlike new E[slots], this does not construct anything
     }
-    // ------- move assignment operator 
 
-    template <typename E>
-    SDAL<E> &
-    SDAL<E>::operator=(SDAL&& other) {
-        
-        if (this != &other) {
-            this->clear();
-            //Soft copy old list
-            array = other.array;
-            tail = other.tail;
-            size = other.size;
-            starting_size = other.starting_size;
-
-            //Reset old list
-            other.array = new E[size];
-            other.tail = 0;
-            other.size = 50;
-            other.starting_size = 50;
+    //==============================================================================
+    // --------- relocate()
+
+    template <typename E, typename Allocator, typename Growth>
+    void
+    SDAL<E, Allocator, Growth>::relocate(E *from, size_t count, E *to) const {
+        if (std::is_trivially_copyable<E>::value) { //A trivially copyable element is just bytes, so one memcpy moves them all
+            if (count > 0) std::memcpy(static_cast<void *>(to), static_cast<const void *>(from), count * sizeof (E));
+            return;
+        }
+        for (size_t i = 0; i < count; i++) {
+            traits::construct(allocator, &to[i], std::move_if_noexcept(from[i])); //Move unless moving could throw halfway through
+            traits::destroy(allocator, &from[i]);
         }
-        return *this;
     }
 
-    // ------  destructor 
+    //==============================================================================
+    // --------- destroy()
 
-    template <typename E>
-    SDAL<E>::~SDAL() {
-        delete [] array;
+    template <typename E, typename Allocator, typename Growth>
+    void
+    SDAL<E, Allocator, Growth>::destroy(E *first, E *last) {
+        if (std::is_trivially_destructible<E>::value) return;
+        for (; first != last; ++first)
+            traits::destroy(allocator, first);
     }
 
     //==============================================================================
-    // operations
+    // --------- resize()
+
+    template <typename E, typename Allocator, typename Growth>
+    void
+    SDAL<E, Allocator, Growth>::resize(size_t new_size) {
+        resize_notifier::clock::time_point const started = notifier.start();
+        size_t const old_size = size;
+        E *temp_array = allocate(new_size);
+        relocate(array, tail, temp_array);
+        traits::deallocate(allocator, array, size);
+        array = temp_array;
+        size = new_size;
+        notifier.finish(started, old_size, new_size, tail, tail * sizeof (E));
+        COP3530_COUNT(frees, 1);
+        COP3530_COUNT(resizes, 1);
+        COP3530_COUNT(moves, tail);
+        COP3530_COUNT(resize_bytes, tail * sizeof (E));
+    }
 
     //==============================================================================
     // --------- upsize() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     void
-    SDAL<E>::upsize() {
-        size_t previous_size = size;
-        size = size * 1.5;
-        E *temp_array = new E[size];
-        for (int i = 0; i < previous_size; i++) {
-            temp_array[i] = array[i];
+    SDAL<E, Allocator, Growth>::upsize() {
+        resize(grown_size());
+    }
+
+    //==============================================================================
+    // --------- grown_size()
+
+    template <typename E, typename Allocator, typename Growth>
+    size_t
+    SDAL<E, Allocator, Growth>::grown_size() const {
+        size_t new_size = size * 1.5;
+        if (new_size <= size) new_size = size + 1; //Tiny arrays would not grow at all otherwise
+        return new_size;
+    }
+
+    //==============================================================================
+    // --------- start_migration()
+
+    template <typename E, typename Allocator, typename Growth>
+    void
+    SDAL<E, Allocator, Growth>::start_migration() {
+        finish_migration(); //Only if the new array filled up before the old one was emptied, which migration_step is chosen to prevent
+        resize_notifier::clock::time_point const started = notifier.start();
+        size_t const new_size = grown_size();
+        old_array = array;
+        old_size = size;
+        migrated = 0;
+        old_end = tail;
+        array = allocate(new_size); //Uninitialized storage, so this takes about as long whatever the length
+        size = new_size;
+        COP3530_COUNT(resizes, 1);
+        notifier.finish(started, old_size, new_size, tail, 0); //Nothing has moved yet: migrate() moves the elements a few at a time
+    }
+
+    //==============================================================================
+    // --------- migrate()
+
+    template <typename E, typename Allocator, typename Growth>
+    void
+    SDAL<E, Allocator, Growth>::migrate(size_t steps) const {
+        size_t const last = old_end - migrated > steps ? migrated + steps : old_end;
+        relocate(old_array + migrated, last - migrated, array + migrated); //Same index in both arrays
+        COP3530_COUNT(moves, last - migrated);
+        COP3530_COUNT(resize_bytes, (last - migrated) * sizeof (E));
+        migrated = last;
+        if (migrated == old_end) {
+            traits::deallocate(allocator, old_array, old_size);
+            COP3530_COUNT(frees, 1);
+            old_array = nullptr;
         }
-        delete [] array;
-        array = &temp_array[0];
-        tail = previous_size;
+    }
+
+    //==============================================================================
+    // --------- finish_migration()
+
+    template <typename E, typename Allocator, typename Growth>
+    void
+    SDAL<E, Allocator, Growth>::finish_migration() const {
+        if (incremental && old_array != nullptr) migrate(old_end - migrated);
+    }
+
+    //==============================================================================
+    // --------- slot()
+
+    template <typename E, typename Allocator, typename Growth>
+    E&
+    SDAL<E, Allocator, Growth>::slot(size_t position) {
+        if (incremental && old_array != nullptr && position >= migrated && position < old_end) return old_array[position];
+        return array[position];
+    }
+
+    template <typename E, typename Allocator, typename Growth>
+    const E&
+    SDAL<E, Allocator, Growth>::slot(size_t position) const {
+        if (incremental && old_array != nullptr && position >= migrated && position < old_end) return old_array[position];
+        return array[position];
     }
 
     //==============================================================================
     // --------- adjust_size() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     void
-    SDAL<E>::adjust_size() {
-        if (size >= 2 * starting_size && length() < size / 2) {
-            size_t previous_size = size;
-            size = size * 0.75;
-            E *temp_array = new E[size];
-            for (int i = 0; i < previous_size; i++) {
-                temp_array[i] = array[i];
-            }
-            delete [] array;
-            array = &temp_array[0];
-            tail = previous_size;
-        }
+    SDAL<E, Allocator, Growth>::adjust_size() {
+        if (incremental && old_array != nullptr) return; //Not halfway through growing
+        if (size >= 2 * starting_size && length() < size / 2)
+            resize(size * 0.75);
     }
 
     //==============================================================================
     // --------- insert() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     void
-    SDAL<E>::insert(E element, int position) {
+    SDAL<E, Allocator, Growth>::insert(E element, int position) {
         if (position > length() || position < 0) throw std::runtime_error("Sorry, you cannot insert outside the list boundaries");
-        if (tail != size){    
-            tail++;
-            for (int i = length(); i > position; i--)
-                array[i] = array[i - 1];
-            array[position] = element;
-        } else if (tail == size){    
+        if (incremental && position == tail) { //Nothing needs to be shifted, so it can grow like push_back
+            push_back(std::move(element));
+            return;
+        }
+        finish_migration();
+        if (tail == size)
             upsize();
-            insert(element, position);
+        COP3530_COUNT(copies, 1);
+        if (position == tail) { //Nothing needs to be shifted
+            traits::construct(allocator, &array[tail++], std::move(element));
+            return;
         }
+        COP3530_COUNT(moves, tail - position);
+        traits::construct(allocator, &array[tail], std::move(array[tail - 1])); //The slot after the last element is uninitialized, so it is constructed rather than assigned
+        for (int i = tail - 1; i > position; i--)
+            array[i] = std::move(array[i - 1]);
+        array[position] = std::move(element);
+        tail++;
     }
 
     //==============================================================================
 
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     E * const
-    SDAL<E>::contents() {
+    SDAL<E, Allocator, Growth>::contents() {
+        finish_migration();
         E * const newarray = new E[length()];
         int index_array = 0;
         int index_new_array = 0;
@@ -320,61 +598,87 @@ namespace cop3530 {
     }
 
 
+    //==============================================================================
+    // --------- copy_to()
+
+    template <typename E, typename Allocator, typename Growth>
+    template <typename OutputIt>
+    OutputIt
+    SDAL<E, Allocator, Growth>::copy_to(OutputIt out) {
+        finish_migration();
+        return std::copy(array, array + tail, out); //Becomes a memmove for trivially copyable elements written into a pointer
+    }
+
+    //==============================================================================
+    // --------- view()
+
+    template <typename E, typename Allocator, typename Growth>
+    span<E>
+    SDAL<E, Allocator, Growth>::view() {
+        finish_migration();
+        return span<E>(array, tail);
+    }
+
+    template <typename E, typename Allocator, typename Growth>
+    span<const E>
+    SDAL<E, Allocator, Growth>::view() const {
+        finish_migration(); //Moving elements between the arrays leaves the list itself unchanged
+        return span<const E>(array, tail);
+    }
+
     //==============================================================================
     // --------- push_back() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     void
-    SDAL<E>::push_back(E element) {
-        if (tail != size){    
-            array[tail++] = element;
-        }else if (tail == size) {    
-            upsize();
-            push_back(element);
+    SDAL<E, Allocator, Growth>::push_back(E element) {
+        if (tail == size) {
+            if (incremental) start_migration();
+            else upsize();
         }
+        traits::construct(allocator, &array[tail++], std::move(element)); //Past old_end, so always in array
+        COP3530_COUNT(copies, 1);
+        if (incremental && old_array != nullptr) migrate(migration_step);
     }
 
     //==============================================================================
     // --------- push_front() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     void
-    SDAL<E>::push_front(E element) {
-         if (tail != size){    
-            for (int i = length(); i > 0; i--)
-                array[i] = array[i - 1];
-            array[0] = element;
-            tail++;
-         }else if (tail == size){    
-            upsize();
-            push_front(element);
-        }
+    SDAL<E, Allocator, Growth>::push_front(E element) {
+        insert(std::move(element), 0);
     }
 
     //==============================================================================
     // --------- replace() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     E
-    SDAL<E>::replace(E element, int position) {
+    SDAL<E, Allocator, Growth>::replace(E element, int position) {
         if (position > length() - 1 || position < 0) throw std::runtime_error("Error from replace method: the position chosen is not in the list");
-        E displaced = array[position];
-        array[position] = element;
+        E& replaced = slot(position);
+        E displaced = std::move(replaced);
+        replaced = std::move(element);
+        COP3530_COUNT(copies, 1);
         return displaced;
     }
 
     //==============================================================================
     // --------- remove() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     E
-    SDAL<E>::remove(int position) {
+    SDAL<E, Allocator, Growth>::remove(int position) {
         if (position > length() - 1 || position < 0)
             throw std::runtime_error("Error from remove method: the position chosen is not in the list");
-        E removed = array[position];
-        for (int i = position; i < length(); i++)
-            array[i] = array[i + 1];
-        tail--;
+        if (incremental && position == tail - 1) return pop_back(); //Nothing needs to be shifted
+        finish_migration();
+        E removed = std::move(array[position]);
+        for (int i = position; i < tail - 1; i++)
+            array[i] = std::move(array[i + 1]);
+        COP3530_COUNT(moves, tail - 1 - position);
+        traits::destroy(allocator, &array[--tail]); //The last slot is now unused
         adjust_size();
         return removed;
     }
@@ -382,13 +686,19 @@ namespace cop3530 {
     //==============================================================================
     // --------- pop_back() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     E
-    SDAL<E>::pop_back() {
+    SDAL<E, Allocator, Growth>::pop_back() {
         if (is_empty())
             throw std::runtime_error("Error in the pop back method, the list is empty");
-        E removed = array[tail-1];
+        E& last = slot(tail - 1);
+        E removed = std::move(last);
+        traits::destroy(allocator, &last);
         tail--;
+        if (incremental && old_array != nullptr) {
+            if (old_end > size_t(tail)) old_end = tail; //It came out of the old array
+            migrate(migration_step);
+        }
         adjust_size();
         return removed;
     }
@@ -396,81 +706,78 @@ namespace cop3530 {
     //==============================================================================
     // --------- pop_front() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     E
-    SDAL<E>::pop_front() {
+    SDAL<E, Allocator, Growth>::pop_front() {
         if (is_empty()) throw std::runtime_error("Error in the pop front method, the list is empty");
-        E removed = array[0];
-        for (int i = 0; i < length(); i++)
-            array[i] = array[i + 1];
-        tail--;
-        adjust_size();
-        return removed;
+        return remove(0);
     }
 
     //==============================================================================
     // --------- item_at() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     E
-    SDAL<E>::item_at(int position) {
+    SDAL<E, Allocator, Growth>::item_at(int position) {
         if (position > length() - 1 || position < 0) throw std::runtime_error("Error from item at method: the position chosen is not in the list");
-        return array[position];
+        return slot(position);
     }
 
     //==============================================================================
     // --------- peek_back() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     E
-    SDAL<E>::peek_back() {
+    SDAL<E, Allocator, Growth>::peek_back() {
         if (is_empty()) throw std::runtime_error("Error in the peek back method, the list is empty");
-        return array[tail-1];
+        return slot(tail - 1);
     }
 
     //==============================================================================
     // --------- peek_front() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     E
-    SDAL<E>::peek_front() {
+    SDAL<E, Allocator, Growth>::peek_front() {
         if (is_empty()) throw std::runtime_error("Error in the peek front method, the list is empty");
-        return array[0];
+        return slot(0);
     }
 
     //==============================================================================
     // --------- is_empty() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     bool
-    SDAL<E>::is_empty() {
+    SDAL<E, Allocator, Growth>::is_empty() {
         return tail == 0;
     }
 
     //==============================================================================
     // --------- is_full() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     bool
-    SDAL<E>::is_full(void) {
+    SDAL<E, Allocator, Growth>::is_full(void) {
         return false; //This list can have an infinite amount of nodes and therefore it always returns false 
     }
 
     //==============================================================================
     // --------- length() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     size_t
-    SDAL<E>::length() {
+    SDAL<E, Allocator, Growth>::length() {
         return tail;
     }
 
     //==============================================================================
     // --------- clear() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     void
-    SDAL<E>::clear() {
+    SDAL<E, Allocator, Growth>::clear() {
+        finish_migration();
+        destroy(array, array + tail);
         tail = 0;
         adjust_size();
     }
@@ -478,32 +785,161 @@ namespace cop3530 {
     //==============================================================================
     // --------- contains() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
+    bool
+    SDAL<E, Allocator, Growth>::contains(E element, bool (*equals_function)(const E&, const E&)) {
+        return find_if([&](const E& datum) { return equals_function(datum, element); }) != -1;
+    }
+
+    //==============================================================================
+    // --------- find_if()
+
+    template <typename E, typename Allocator, typename Growth>
+    template <typename Predicate>
+    int
+    SDAL<E, Allocator, Growth>::find_if(Predicate predicate) {
+        finish_migration();
+        for (int i = 0; i < tail; i++)
+            if (predicate(array[i])) return i;
+        return -1;
+    }
+
+    //==============================================================================
+    // --------- contains() with ==
+
+    template <typename E, typename Allocator, typename Growth>
+    bool
+    SDAL<E, Allocator, Growth>::contains(const E& element) {
+        return find(element) != -1;
+    }
+
+    //==============================================================================
+    // --------- contains() with any callable
+
+    template <typename E, typename Allocator, typename Growth>
+    template <typename Equals>
     bool
-    SDAL<E>::contains(E element, bool (*equals_function)(const E&, const E&)) {
-        if (is_empty()) return false;
-        for (int i = 0; i<tail; i++)
-              if (equals_function(array[i], element)) return true;
-        return false;
+    SDAL<E, Allocator, Growth>::contains(const E& element, Equals equals) {
+        return find_if([&](const E& datum) { return equals(datum, element); }) != -1;
+    }
+
+    //==============================================================================
+    // --------- find()
+
+    template <typename E, typename Allocator, typename Growth>
+    int
+    SDAL<E, Allocator, Growth>::find(const E& element) {
+        finish_migration();
+        E const *found = simd_find<E>(array, array + tail, element);
+        return found == array + tail ? -1 : int(found - array);
+    }
+
+    //==============================================================================
+    // --------- count()
+
+    template <typename E, typename Allocator, typename Growth>
+    size_t
+    SDAL<E, Allocator, Growth>::count(const E& element) {
+        finish_migration();
+        return simd_count<E>(array, array + tail, element);
+    }
+
+    //==============================================================================
+    // --------- min()
+
+    template <typename E, typename Allocator, typename Growth>
+    E
+    SDAL<E, Allocator, Growth>::min() {
+        if (is_empty()) throw std::runtime_error("Sorry, the list is empty");
+        finish_migration();
+        return simd_min<E>(array, array + tail);
+    }
+
+    //==============================================================================
+    // --------- max()
+
+    template <typename E, typename Allocator, typename Growth>
+    E
+    SDAL<E, Allocator, Growth>::max() {
+        if (is_empty()) throw std::runtime_error("Sorry, the list is empty");
+        finish_migration();
+        return simd_max<E>(array, array + tail);
+    }
+
+    //==============================================================================
+    // --------- sum()
+
+    template <typename E, typename Allocator, typename Growth>
+    typename sum_type<E>::type
+    SDAL<E, Allocator, Growth>::sum() {
+        finish_migration();
+        return simd_sum<E>(array, array + tail);
     }
 
     //==============================================================================
     // --------- print() --------------------------------------------------------------------------------- IT WORKS
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Growth>
     void
-    SDAL<E>::print(std::ostream& o) {
+    SDAL<E, Allocator, Growth>::print(std::ostream& o) {
         if (is_empty()) {
             o << "<empty list>" << std::endl;
             return;
         }
         
+        finish_migration();
         o << "[";
         for (int i = 0; i<tail-1; i++){
           o << array[i]<<",";
         }
         o << array[tail-1]<< "]";
     }
+
+    //==============================================================================
+    // --------- swap()
+
+    template <typename E, typename Allocator, typename Growth>
+    void
+    SDAL<E, Allocator, Growth>::swap(SDAL& other) {
+        finish_migration();
+        other.finish_migration();
+        swap_allocator(allocator, other.allocator, typename traits::propagate_on_container_swap());
+        std::swap(array, other.array);
+        std::swap(tail, other.tail);
+        std::swap(size, other.size);
+        std::swap(starting_size, other.starting_size);
+    }
+
+    //==============================================================================
+    // --------- get_allocator()
+
+    template <typename E, typename Allocator, typename Growth>
+    typename SDAL<E, Allocator, Growth>::allocator_type
+    SDAL<E, Allocator, Growth>::get_allocator() const {
+        return allocator;
+    }
+
+    //==============================================================================
+    // --------- stats()
+
+    template <typename E, typename Allocator, typename Growth>
+    list_stats
+    SDAL<E, Allocator, Growth>::stats() const {
+#ifdef COP3530_INSTRUMENT
+        return instrumentation;
+#else
+        return list_stats();
+#endif
+    }
+
+    //==============================================================================
+    // --------- on_resize()
+
+    template <typename E, typename Allocator, typename Growth>
+    void
+    SDAL<E, Allocator, Growth>::on_resize(resize_listener listener, void *context) {
+        notifier.listen(listener, context);
+    }
 }
 #endif /* SDAL_H */
 
@@ -0,0 +1,68 @@
+//contains() benchmark
+// - Compares the three ways of asking whether a list holds an element: the original contains() with a function pointer,
+//   contains() with a callable the compiler can inline, and contains() with ==, which compares arithmetic elements with SIMD.
+//   Runs on an SDAL and on a wrapped CBL of ints and floats. The probe is never in the list, so every element is examined.
+//
+// by Iago Patiño López
+// Build from this directory with: g++ -std=c++11 -O2 -I .. contains_bench.cpp -o contains_bench
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+//List ADTs included below:
+#include "SDAL.h"
+#include "../../cbl/CBL.h"
+
+using namespace cop3530;
+
+template <typename E>
+bool equals_function(const E& a, const E& b) {
+    return a == b;
+}
+
+template <typename Op>
+double nanoseconds_per_element(long elements, int repetitions, Op op) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++)
+        op();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (double(elements) * repetitions);
+}
+
+template <typename List, typename E>
+void compare(const char *name, const char *element, List& list, long size) {
+    volatile int sink = 0; //Keeps the compiler from discarding the measured calls
+    E const absent = E(-1);
+    int const repetitions = int(100000000 / size) + 1;
+    double pointer = nanoseconds_per_element(size, repetitions, [&]() { sink = sink + list.contains(absent, equals_function<E>); });
+    double callable = nanoseconds_per_element(size, repetitions, [&]() { sink = sink + list.contains(absent, [](const E& a, const E& b) { return a == b; }); });
+    double equals = nanoseconds_per_element(size, repetitions, [&]() { sink = sink + list.contains(absent); });
+    std::cout << name << "," << element << "," << size << "," << pointer << "," << callable << "," << equals << std::endl;
+}
+
+template <typename E>
+void run(const char *element, long size) {
+    SDAL<E> sdal(int(size) + 1);
+    for (long i = 0; i < size; i++)
+        sdal.push_back(E(i % 1000));
+    compare<SDAL<E>, E>("sdal", element, sdal, size);
+
+    CBL<E> cbl(int(size) + 1); //Half of the elements wrap around the end of the array
+    for (long i = 0; i < size / 2; i++)
+        cbl.push_back(E(0));
+    for (long i = 0; i < size / 2; i++) {
+        cbl.pop_front();
+        cbl.push_back(E(i % 1000));
+    }
+    for (long i = size / 2; i < size; i++)
+        cbl.push_back(E(i % 1000));
+    compare<CBL<E>, E>("cbl", element, cbl, size);
+}
+
+int main() {
+    std::cout << "list,element,size,function_pointer_ns,callable_ns,equals_ns" << std::endl;
+    for (long size = 1000; size <= 1000000; size *= 10) {
+        run<int>("int", size);
+        run<float>("float", size);
+    }
+    return 0;
+}
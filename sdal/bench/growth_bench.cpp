@@ -0,0 +1,79 @@
+//Growth benchmark
+// - Times every push_back while an SDAL and a CBL grow from their default 50 slots to millions of elements, once with all_at_once_growth and
+//   once with incremental_growth (see List.h), with int and std::string elements.
+// - Prints, as a JSON array, a latency histogram summary per list, growth mode and element: pushes, resizes, total ms, mean, p50, p99, p99.9 and max in ns.
+//   Every latency includes reading the clock once, a few tens of ns. The all-at-once pushes that copy the array set the max. Incremental growth
+//   spreads that copy over the following pushes, which touch the new array's pages for the first time, so it raises the p99.9 a little and its max
+//   is the push that allocates or frees a large array, which the kernel maps or unmaps in time proportional to its pages.
+// - Usage: growth_bench [elements]
+//
+// by Iago Patiño López
+// Build from this directory with: g++ -std=c++11 -O2 -I .. growth_bench.cpp -o growth_bench
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+//List ADTs included below:
+#include "SDAL.h"
+#include "Trace.h"
+#include "../../cbl/CBL.h"
+
+using namespace cop3530;
+
+bool first_record = true;
+
+template <typename E>
+E make_element(long i) {
+    return E(i);
+}
+
+template <>
+std::string make_element<std::string>(long i) {
+    return std::string(32, char('a' + i % 26)); //Long enough to live on the heap
+}
+
+void count_resize(const resize_event&, void *resizes) {
+    ++*static_cast<unsigned long *>(resizes);
+}
+
+template <typename List, typename E>
+void run(const char *name, const char *growth, const char *element, long elements) {
+    latency_histogram latencies;
+    unsigned long resizes = 0;
+    List *list = new List;
+    list->on_resize(count_resize, &resizes);
+    E const value = make_element<E>(7); //Built once, so only the push is timed
+    auto const first = std::chrono::steady_clock::now();
+    for (long i = 0; i < elements; i++) {
+        auto start = std::chrono::steady_clock::now();
+        list->push_back(value);
+        latencies.record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+    double const total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - first).count();
+    delete list;
+
+    std::printf("%s  {\"list\": \"%s\", \"growth\": \"%s\", \"element\": \"%s\", \"pushes\": %llu, \"resizes\": %lu, \"total_ms\": %.1f, \"mean_ns\": %.1f, \"p50_ns\": %llu, \"p99_ns\": %llu, \"p999_ns\": %llu, \"max_ns\": %llu}",
+            first_record ? "" : ",\n", name, growth, element, (unsigned long long) latencies.count(), resizes, total_ms, latencies.mean(),
+            (unsigned long long) latencies.percentile(50), (unsigned long long) latencies.percentile(99),
+            (unsigned long long) latencies.percentile(99.9), (unsigned long long) latencies.max());
+    std::fflush(stdout);
+    first_record = false;
+}
+
+template <typename E>
+void run_all(const char *element, long elements) {
+    run<SDAL<E, std::allocator<E>, all_at_once_growth>, E>("sdal", "all_at_once", element, elements);
+    run<SDAL<E, std::allocator<E>, incremental_growth>, E>("sdal", "incremental", element, elements);
+    run<CBL<E, half_growth_policy, std::allocator<E>, all_at_once_growth>, E>("cbl", "all_at_once", element, elements);
+    run<CBL<E, half_growth_policy, std::allocator<E>, incremental_growth>, E>("cbl", "incremental", element, elements);
+}
+
+int main(int argc, char **argv) {
+    long const elements = argc > 1 ? std::atol(argv[1]) : 10000000;
+    std::printf("[\n");
+    run_all<int>("int", elements);
+    run_all<std::string>("string", elements / 10); //32 bytes plus a heap block each
+    std::printf("\n]\n");
+    return 0;
+}
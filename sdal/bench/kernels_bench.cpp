@@ -0,0 +1,87 @@
+//SIMD kernels benchmark
+// - Times find, count, min, max and sum over int and float arrays at every instruction set level this CPU supports, from scalar up,
+//   and then through the SDAL and (wrapped) CBL members, which use the level picked at run time. find() looks for an absent key, so it reads every element.
+//
+// by Iago Patiño López
+// Build from this directory with: g++ -std=c++11 -O2 -I .. kernels_bench.cpp -o kernels_bench
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+//List ADTs included below:
+#include "SDAL.h"
+#include "../../cbl/CBL.h"
+
+using namespace cop3530;
+
+char const *const level_names[] = {"scalar", "sse2", "avx2", "avx512"};
+
+template <typename Op>
+double nanoseconds_per_element(std::size_t elements, Op op) {
+    int const repetitions = int(200000000 / elements) + 1;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++)
+        op();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (double(elements) * repetitions);
+}
+
+template <typename E>
+void kernels(const char *element, std::size_t size) {
+    volatile double sink = 0; //Keeps the compiler from discarding the measured calls
+    std::vector<E> values(size);
+    for (std::size_t i = 0; i < size; i++)
+        values[i] = E(i % 1000);
+    E const *first = values.data(), *last = first + size;
+    E const absent = E(-1);
+
+    for (int l = 0; l <= int(cpu_simd_level()); l++) {
+        simd_level const level = simd_level(l);
+        double find = nanoseconds_per_element(size, [&]() { sink = sink + (simd_find(first, last, absent, level) - first); });
+        double count = nanoseconds_per_element(size, [&]() { sink = sink + simd_count(first, last, E(7), level); });
+        double min = nanoseconds_per_element(size, [&]() { sink = sink + simd_min(first, last, level); });
+        double max = nanoseconds_per_element(size, [&]() { sink = sink + simd_max(first, last, level); });
+        double sum = nanoseconds_per_element(size, [&]() { sink = sink + simd_sum(first, last, level); });
+        std::cout << "kernel," << level_names[l] << "," << element << "," << size << "," << find << "," << count << "," << min << "," << max << "," << sum << std::endl;
+    }
+}
+
+template <typename List, typename E>
+void members(const char *name, const char *element, List& list, std::size_t size) {
+    volatile double sink = 0;
+    E const absent = E(-1);
+    double find = nanoseconds_per_element(size, [&]() { sink = sink + list.find(absent); });
+    double count = nanoseconds_per_element(size, [&]() { sink = sink + list.count(E(7)); });
+    double min = nanoseconds_per_element(size, [&]() { sink = sink + list.min(); });
+    double max = nanoseconds_per_element(size, [&]() { sink = sink + list.max(); });
+    double sum = nanoseconds_per_element(size, [&]() { sink = sink + list.sum(); });
+    std::cout << name << "," << level_names[int(cpu_simd_level())] << "," << element << "," << size << "," << find << "," << count << "," << min << "," << max << "," << sum << std::endl;
+}
+
+template <typename E>
+void lists(const char *element, std::size_t size) {
+    SDAL<E> sdal(int(size) + 1);
+    for (std::size_t i = 0; i < size; i++)
+        sdal.push_back(E(i % 1000));
+    members<SDAL<E>, E>("sdal", element, sdal, size);
+
+    CBL<E> cbl(int(size) + 1); //Half of the elements wrap around the end of the array
+    for (std::size_t i = 0; i < size / 2; i++)
+        cbl.push_back(E(0));
+    for (std::size_t i = 0; i < size; i++) {
+        if (i < size / 2) cbl.pop_front();
+        cbl.push_back(E(i % 1000));
+    }
+    members<CBL<E>, E>("cbl", element, cbl, size);
+}
+
+int main() {
+    std::cout << "source,level,element,size,find_ns,count_ns,min_ns,max_ns,sum_ns" << std::endl;
+    for (std::size_t size = 1000; size <= 10000000; size *= 100) {
+        kernels<int>("int", size);
+        kernels<float>("float", size);
+        lists<int>("int", size);
+        lists<float>("float", size);
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+//Simple Dynamic Array-based List (SDAL) benchmark
+// - Times how much growing the backing array costs for element types that relocate differently:
+//   trivially copyable ones are memcpy'd, ones with a cheap noexcept move are moved, and ones that can only be copied are copied.
+//
+// by Iago Patiño López
+// Build from this directory with: g++ -std=c++11 -O2 -I .. sdal_bench.cpp -o sdal_bench
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+//List ADTs included below:
+#include "SDAL.h"
+
+using namespace cop3530;
+
+//A 64 byte plain-old-data element, relocated with memcpy
+
+struct line {
+    long values[8];
+
+    line(long value = 0) {
+        for (int i = 0; i < 8; i++)
+            values[i] = value;
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, const line& l) { //Every List must be printable
+        return stream << l.values[0];
+    }
+};
+
+//Counts how often elements are copied and moved, so that the benchmark can report both per push_back
+
+struct counters {
+    static long copies;
+    static long moves;
+};
+
+long counters::copies = 0;
+long counters::moves = 0;
+
+//A heap-owning element with a cheap noexcept move
+
+struct movable {
+    std::string text;
+
+    movable(long value = 0) : text(48, 'a' + value % 26) {
+    }
+
+    movable(const movable& other) : text(other.text) {
+        counters::copies++;
+    }
+
+    movable(movable&& other) noexcept : text(std::move(other.text)) {
+        counters::moves++;
+    }
+
+    movable& operator=(const movable& other) {
+        counters::copies++;
+        text = other.text;
+        return *this;
+    }
+
+    movable& operator=(movable&& other) noexcept {
+        counters::moves++;
+        text = std::move(other.text);
+        return *this;
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, const movable& m) {
+        return stream << m.text;
+    }
+};
+
+//A heap-owning element without a move constructor, so every relocation is a deep copy
+
+struct copy_only {
+    std::string text;
+
+    copy_only(long value = 0) : text(48, 'a' + value % 26) {
+    }
+
+    copy_only(const copy_only& other) : text(other.text) {
+        counters::copies++;
+    }
+
+    copy_only& operator=(const copy_only& other) {
+        counters::copies++;
+        text = other.text;
+        return *this;
+    }
+
+    friend std::ostream& operator<<(std::ostream& stream, const copy_only& c) {
+        return stream << c.text;
+    }
+};
+
+//Appends size elements to a list that starts at the default 50 slots, so that it grows many times
+
+template <typename E>
+void grow(const char *type_name, int size) {
+    E const prototype(1);
+    counters::copies = 0;
+    counters::moves = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        SDAL<E> list;
+        for (int i = 0; i < size; i++)
+            list.push_back(prototype);
+    }
+    double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << type_name << "," << size << "," << nanoseconds / size << ","
+            << double(counters::copies) / size << "," << double(counters::moves) / size << std::endl;
+}
+
+int main() {
+    std::cout << "type,size,push_back_ns,copies_per_push,moves_per_push" << std::endl;
+    for (int size = 1000; size <= 1000000; size *= 10) {
+        grow<int>("int", size);
+        grow<line>("line64", size);
+        grow<movable>("movable_string", size);
+        grow<copy_only>("copy_only_string", size);
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+//Snapshot benchmark
+// - Compares three ways of taking a snapshot of a list of ints: contents() (a fresh heap array, freed after each call),
+//   copy_to() into a buffer the caller reuses, and memcpy() of each span of view() into that same buffer. Runs on an SDAL, a wrapped CBL and a CDAL.
+//
+// by Iago Patiño López
+// Build from this directory with: g++ -std=c++11 -O2 -I .. snapshot_bench.cpp -o snapshot_bench
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+//List ADTs included below:
+#include "SDAL.h"
+#include "../../cbl/CBL.h"
+#include "../../cdal/CDAL.h"
+
+using namespace cop3530;
+
+template <typename Op>
+double nanoseconds_per_element(long elements, Op op) {
+    int const repetitions = int(100000000 / elements) + 1;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++)
+        op();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / (double(elements) * repetitions);
+}
+
+//Serialises through the view the way a writer would: one memcpy (or writev() entry) per contiguous span
+
+int *write_span(span<int> elements, int *out) {
+    std::memcpy(out, elements.data(), elements.size_bytes());
+    return out + elements.size();
+}
+
+int *write_view(SDAL<int>& list, int *out) {
+    return write_span(list.view(), out);
+}
+
+int *write_view(CBL<int>& list, int *out) {
+    ring_view<int> segments = list.view();
+    return write_span(segments.second, write_span(segments.first, out));
+}
+
+int *write_view(CDAL<int>& list, int *out) {
+    for (span<int> chunk : list.view())
+        out = write_span(chunk, out);
+    return out;
+}
+
+template <typename List>
+void compare(const char *name, List& list, long size) {
+    volatile long sink = 0; //Keeps the compiler from discarding the measured calls
+    std::vector<int> buffer(size);
+    double contents = nanoseconds_per_element(size, [&]() {
+        int *copy = list.contents();
+        sink = sink + copy[size - 1];
+        delete[] copy;
+    });
+    double copy_to = nanoseconds_per_element(size, [&]() {
+        list.copy_to(buffer.data());
+        sink = sink + buffer[size - 1];
+    });
+    double view = nanoseconds_per_element(size, [&]() {
+        write_view(list, buffer.data());
+        sink = sink + buffer[size - 1];
+    });
+    std::cout << name << "," << size << "," << contents << "," << copy_to << "," << view << std::endl;
+}
+
+int main() {
+    std::cout << "list,size,contents_ns,copy_to_ns,view_ns" << std::endl;
+    for (long size = 1000; size <= 1000000; size *= 10) {
+        SDAL<int> sdal(int(size) + 1);
+        for (long i = 0; i < size; i++)
+            sdal.push_back(int(i));
+        compare("sdal", sdal, size);
+
+        CBL<int> cbl(int(size) + 1); //Half of the elements wrap around the end of the array
+        for (long i = 0; i < size / 2; i++)
+            cbl.push_back(0);
+        for (long i = 0; i < size; i++) {
+            if (i < size / 2) cbl.pop_front();
+            cbl.push_back(int(i));
+        }
+        compare("cbl", cbl, size);
+
+        CDAL<int> cdal;
+        for (long i = 0; i < size; i++)
+            cdal.push_back(int(i));
+        compare("cdal", cdal, size);
+    }
+    return 0;
+}
@@ -3,10 +3,14 @@
 //
 // by Iago Patiño López
 // with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
+#include <algorithm>
 #include <iostream>
+#include <vector>
+#include <iterator>
 #include <valarray>
 #include <string>
 #include <sstream>
+#include <type_traits>
 #define DEBUG
 
 //List ADTs included below:
@@ -16,6 +20,7 @@
 //Catch testing file included below:
 #define CATCH_CONFIG_MAIN
 #include "catch.h"
+#include "counting_allocator.h"
 
 using namespace cop3530;
 
@@ -25,6 +30,11 @@ bool equals_function(const int& a, const int& b) {
     return a == b;
 }
 
+//The list the shared allocator checks in counting_allocator.h run on.
+
+template <typename Allocator>
+using sdal_with = SDAL<int, Allocator>;
+
 class person {
 public:
     int age;
@@ -52,6 +62,22 @@ public:
     }
 };
 
+//Generic code written against the static interface. The calls resolve to the concrete list at compile time.
+//It reads every position with item_at(), which an array answers in O(1).
+
+template <typename Derived>
+int sum_by_position(static_list<Derived, int>& list) {
+    int sum = 0;
+    for (int i = 0; i < int(list.length()); i++)
+        sum += list.item_at(i);
+    return sum;
+}
+
+//Collects the resize events of the on_resize() tests
+void collect_resize(const resize_event& event, void *events) {
+    static_cast<std::vector<resize_event> *>(events)->push_back(event);
+}
+
 TEST_CASE("Testing each method of the SDAL", "[SDAL]") {
 
     //Basic Functions
@@ -448,6 +474,31 @@ TEST_CASE("Testing each method of the SDAL", "[SDAL]") {
 
     //OTHER
 
+    SECTION("Testing growing and shrinking with heap-owning elements") {
+        SDAL<std::string> *test_sdal_34 = new SDAL<std::string>(4);
+
+        for (int i = 0; i < 200; i++)
+            test_sdal_34->push_back(std::string(40, 'a') + std::to_string(i)); //Long enough to live on the heap
+        test_sdal_34->insert("inserted", 100);
+        test_sdal_34->push_front("front");
+
+        REQUIRE(test_sdal_34->length() == 202);
+        REQUIRE(test_sdal_34->item_at(101) == "inserted");
+        REQUIRE(test_sdal_34->item_at(201) == std::string(40, 'a') + "199");
+        REQUIRE(test_sdal_34->pop_front() == "front");
+        REQUIRE(test_sdal_34->remove(100) == "inserted");
+        while (test_sdal_34->length() > 10) //This shrinks the backing array several times
+            test_sdal_34->pop_back();
+        REQUIRE(test_sdal_34->peek_back() == std::string(40, 'a') + "9");
+
+        SDAL<std::string> test_sdal_35(*test_sdal_34);
+        test_sdal_34->clear();
+        REQUIRE(test_sdal_34->is_empty());
+        REQUIRE(test_sdal_35.peek_front() == std::string(40, 'a') + "0");
+
+        delete test_sdal_34;
+    }
+
     SECTION("Complex multi-function test") {
         SDAL<int> *test_sdal_25 = new SDAL<int>;
         REQUIRE(test_sdal_25->is_empty());
@@ -648,4 +699,312 @@ TEST_CASE("Testing each method of the SDAL", "[SDAL]") {
         delete test_sdal_32;
     }
 
+    SECTION("Testing the allocator") {
+        require_allocator_propagation<sdal_with>();
+
+        allocation_log log;
+        typedef counting_allocator<int, true> propagating;
+        {
+            SDAL<int, propagating> test_sdal_36(10, propagating(1, &log));
+            REQUIRE(log.allocations == 1); //One array of exactly the slots asked for
+            REQUIRE(log.bytes == long(10 * sizeof (int)));
+            REQUIRE(log.constructions == 0); //Raw storage: nothing is constructed until an element is pushed into its slot
+            for (int i = 0; i < 10; i++) test_sdal_36.push_back(i);
+            REQUIRE(log.constructions == 10);
+            REQUIRE(log.allocations == 1);
+            test_sdal_36.push_back(10);
+            REQUIRE(log.allocations == 2); //A full array is replaced by one half as large again
+            REQUIRE(log.deallocations == 1);
+            REQUIRE(log.bytes == long(15 * sizeof (int)));
+            REQUIRE(log.constructions == 11); //Trivially copyable elements are copied over as bytes, not constructed again
+            REQUIRE(test_sdal_36.item_at(9) == 9);
+        }
+        REQUIRE(log.bytes == 0);
+
+        allocation_log strings;
+        typedef counting_allocator<std::string, true> string_allocator;
+        {
+            SDAL<std::string, string_allocator, incremental_growth> test_sdal_37(8, string_allocator(2, &strings));
+            for (int i = 0; i < 8; i++) test_sdal_37.push_back(std::string(1, 'a' + i));
+            test_sdal_37.push_back("i");
+            REQUIRE(strings.allocations == 2); //The old array stays until its elements have moved over, a few per push
+            REQUIRE(strings.bytes == long((8 + 12) * sizeof (std::string)));
+            REQUIRE(strings.constructions == 8 + 1 + 4); //Each moved element is constructed in its new slot
+            test_sdal_37.push_back("j");
+            REQUIRE(strings.deallocations == 1);
+            REQUIRE(strings.bytes == long(12 * sizeof (std::string)));
+            REQUIRE(strings.constructions == 8 + 2 + 8);
+            REQUIRE(test_sdal_37.item_at(3) == "d");
+        }
+        REQUIRE(strings.bytes == 0);
+    }
+
+    SECTION("Testing the static interface and the virtual adapter") {
+        REQUIRE(is_static_list<SDAL<int> >::value);
+        SDAL<int> test_sdal_42;
+        for (int i = 0; i < 100; i++) test_sdal_42.push_back(i);
+        REQUIRE(sum_by_position(test_sdal_42) == 4950);
+        REQUIRE(test_sdal_42.length() == 100); //Nothing was removed
+
+        virtual_list<SDAL<int> > test_sdal_43;
+        List<int>& dynamic = test_sdal_43; //Only the adapter is a List<int>
+        for (int i = 0; i < 60; i++) dynamic.push_front(i); //Past the 50 slots, so the array grows behind the adapter
+        span<int> elements = test_sdal_43.get().view(); //The SDAL's own members work on the list behind the adapter
+        REQUIRE(elements.size() == 60);
+        REQUIRE(elements[0] == 59);
+        REQUIRE(elements[59] == 0);
+        REQUIRE(dynamic.item_at(1) == 58);
+        REQUIRE(sum_by_position(test_sdal_43.get()) == 1770);
+        dynamic.clear();
+        REQUIRE(test_sdal_43.get().view().empty());
+    }
+
+    SECTION("Testing find and contains around find_equal's blocks") {
+        //Elements without SIMD kernels are searched by find_equal, which compares 16 longs at a time and the remainder one by one.
+        //So every position is looked for in lists one short of, exactly and one past a whole number of blocks.
+        int const lengths[] = {1, 15, 16, 17, 31, 32, 33, 47, 48, 49};
+        for (int length : lengths) {
+            SDAL<long> test_sdal_44(length);
+            for (int i = 0; i < length; i++) test_sdal_44.push_back(i);
+            for (int i = 0; i < length; i++) REQUIRE(test_sdal_44.find(i) == i);
+            REQUIRE(test_sdal_44.find(length) == -1);
+            REQUIRE(test_sdal_44.contains(long(length - 1)));
+            REQUIRE(!test_sdal_44.contains(-1L));
+            test_sdal_44.replace(length - 1, 0); //The last value is now in the first block too, and the first match wins
+            REQUIRE(test_sdal_44.find(length - 1) == 0);
+        }
+
+        SDAL<long> test_sdal_45(16);
+        REQUIRE(test_sdal_45.find(0) == -1);
+        REQUIRE(!test_sdal_45.contains(0L));
+        for (int i = 0; i < 16; i++) test_sdal_45.push_back(i);
+        test_sdal_45.pop_back(); //Only [0, tail) is searched, not the slots past it
+        REQUIRE(test_sdal_45.find(15) == -1);
+        REQUIRE(!test_sdal_45.contains(15L, [](const long& datum, const long& element) { return datum == element; }));
+    }
+
+    SECTION("Testing the SIMD kernels") {
+        SDAL<int> test_sdal_46;
+        for (int i = 0; i < 1000; i++) test_sdal_46.push_back(i % 100 - 50);
+        REQUIRE(test_sdal_46.find(49) == 99);
+        REQUIRE(test_sdal_46.find(50) == -1);
+        REQUIRE(test_sdal_46.count(-7) == 10);
+        REQUIRE(test_sdal_46.min() == -50);
+        REQUIRE(test_sdal_46.max() == 49);
+        REQUIRE(test_sdal_46.sum() == -500);
+        REQUIRE(test_sdal_46.contains(0));
+
+        SDAL<float> test_sdal_47;
+        for (int i = 0; i < 37; i++) test_sdal_47.push_back(i * 0.5f);
+        REQUIRE(test_sdal_47.find(3.5f) == 7);
+        REQUIRE(test_sdal_47.count(18.0f) == 1);
+        REQUIRE(test_sdal_47.max() == 18.0f);
+        REQUIRE(test_sdal_47.sum() == 333.0);
+
+        SDAL<int> test_sdal_48;
+        REQUIRE(test_sdal_48.find(0) == -1);
+        REQUIRE(test_sdal_48.count(0) == 0);
+        REQUIRE(test_sdal_48.sum() == 0);
+        REQUIRE_THROWS(test_sdal_48.min());
+        REQUIRE_THROWS(test_sdal_48.max());
+
+        int values[203]; //Every level this CPU has must agree with the scalar kernels, at every length and offset
+        for (int i = 0; i < 203; i++) values[i] = (i * 37) % 101 - 50;
+        for (int level = int(simd_level::sse2); level <= int(cpu_simd_level()); level++) {
+            for (int length = 1; length <= 200; length += 7) {
+                const int *first = values + length % 3, *last = first + length;
+                REQUIRE(simd_find(first, last, 7, simd_level(level)) == simd_find(first, last, 7, simd_level::scalar));
+                REQUIRE(simd_count(first, last, -50, simd_level(level)) == simd_count(first, last, -50, simd_level::scalar));
+                REQUIRE(simd_min(first, last, simd_level(level)) == simd_min(first, last, simd_level::scalar));
+                REQUIRE(simd_max(first, last, simd_level(level)) == simd_max(first, last, simd_level::scalar));
+                REQUIRE(simd_sum(first, last, simd_level(level)) == simd_sum(first, last, simd_level::scalar));
+            }
+        }
+    }
+
+    SECTION("Testing the random-access iterator") {
+        SDAL<int> test_sdal_49;
+        for (int i = 0; i < 100; i++) test_sdal_49.push_back((i * 37) % 100);
+        SDAL<int>::iterator first = test_sdal_49.begin(), last = test_sdal_49.end();
+        REQUIRE(last - first == 100);
+        REQUIRE(first[1] == 37);
+        REQUIRE(*(first + 2) == 74);
+        REQUIRE(*(2 + first) == 74);
+        REQUIRE(*(last - 1) == 63);
+        REQUIRE(first < last);
+        std::nth_element(first, first + 50, last);
+        REQUIRE(first[50] == 50);
+        std::sort(first, last);
+        for (int i = 0; i < 100; i++) REQUIRE(test_sdal_49.item_at(i) == i);
+        REQUIRE(*std::lower_bound(first, last, 42) == 42);
+        SDAL<int>::iterator it = last;
+        it -= 10;
+        REQUIRE(*it-- == 90);
+        REQUIRE(*--it == 88);
+
+        const SDAL<int>& test_sdal_50 = test_sdal_49; //const begin() and end() give const iterators over the same elements
+        SDAL<int>::const_iterator const_first = test_sdal_50.begin();
+        REQUIRE(test_sdal_50.end() - const_first == 100);
+        SDAL<int>::const_iterator converted = first; //And an iterator converts to a const_iterator
+        REQUIRE(converted == const_first);
+        REQUIRE(&*converted == &*first);
+    }
+
+    SECTION("Testing the span view and copy_to") {
+        SDAL<int> test_sdal_51(10);
+        REQUIRE(test_sdal_51.view().empty());
+        for (int i = 0; i < 30; i++) test_sdal_51.push_back(i);
+        span<int> contents = test_sdal_51.view();
+        REQUIRE(contents.size() == 30);
+        REQUIRE(contents.size_bytes() == 30 * sizeof (int));
+        for (int i = 0; i < 30; i++) REQUIRE(contents[i] == i);
+        contents[3] = -3; //The view is the list itself, not a copy
+        REQUIRE(test_sdal_51.item_at(3) == -3);
+        const SDAL<int>& test_sdal_52 = test_sdal_51;
+        span<const int> read_only = test_sdal_52.view();
+        REQUIRE(read_only.data() == contents.data());
+
+        int buffer[31];
+        buffer[30] = 99;
+        REQUIRE(test_sdal_51.copy_to(buffer) == buffer + 30);
+        REQUIRE(buffer[3] == -3);
+        REQUIRE(buffer[29] == 29);
+        REQUIRE(buffer[30] == 99);
+        std::vector<std::string> strings;
+        SDAL<std::string> test_sdal_53;
+        test_sdal_53.push_back("a");
+        test_sdal_53.push_back("b");
+        test_sdal_53.copy_to(std::back_inserter(strings));
+        REQUIRE(strings.size() == 2);
+        REQUIRE(strings[1] == "b");
+    }
+
+    SECTION("Testing the instrumentation counters") {
+        SDAL<int> test_sdal_54(10);
+        for (int i = 0; i < 11; i++) test_sdal_54.push_back(i); //The eleventh push grows the array
+        test_sdal_54.insert(-1, 0); //Shifts all eleven
+        list_stats counted = test_sdal_54.stats();
+#ifdef COP3530_INSTRUMENT
+        REQUIRE(counted.copies == 12);
+        REQUIRE(counted.moves == 10 + 11);
+        REQUIRE(counted.resizes == 1);
+        REQUIRE(counted.resize_bytes == 10 * sizeof (int));
+        REQUIRE(counted.allocations == 2);
+        REQUIRE(counted.frees == 1);
+#else
+        REQUIRE(counted.copies == 0); //Not counted at all
+        REQUIRE(counted.resizes == 0);
+#endif
+    }
+
+    SECTION("Testing the resize events") {
+        SDAL<int> test_sdal_55(10);
+        std::vector<resize_event> events;
+        test_sdal_55.on_resize(collect_resize, &events);
+        for (int i = 0; i < 23; i++) test_sdal_55.push_back(i); //10 -> 15 -> 22 -> 33
+        REQUIRE(events.size() == 3);
+        REQUIRE(events[0].grew);
+        REQUIRE(events[0].old_capacity == 10);
+        REQUIRE(events[0].new_capacity == 15);
+        REQUIRE(events[0].elements == 10);
+        REQUIRE(events[0].bytes_moved == 10 * sizeof (int));
+        REQUIRE(events[2].new_capacity == 33);
+        while (test_sdal_55.length() > 15) test_sdal_55.pop_back(); //Fewer than half of the 33 slots used
+        REQUIRE(events.size() == 4);
+        REQUIRE_FALSE(events[3].grew);
+        REQUIRE(events[3].old_capacity == 33);
+        REQUIRE(events[3].new_capacity == 24);
+        REQUIRE(events[3].bytes_moved == 15 * sizeof (int));
+
+        test_sdal_55.on_resize(nullptr);
+        for (int i = 0; i < 100; i++) test_sdal_55.push_back(i);
+        REQUIRE(events.size() == 4);
+    }
+
+    SECTION("Testing incremental growth") {
+        SDAL<int, std::allocator<int>, incremental_growth> test_sdal_56(4);
+        std::vector<resize_event> events;
+        test_sdal_56.on_resize(collect_resize, &events);
+        for (int i = 0; i < 1000; i++) {
+            test_sdal_56.push_back(i);
+            REQUIRE(test_sdal_56.peek_back() == i);
+            REQUIRE(test_sdal_56.item_at(i / 2) == i / 2); //Often still in the old array
+        }
+        REQUIRE(events.size() > 5);
+        REQUIRE(events[0].grew);
+        REQUIRE(events[0].bytes_moved == 0); //The elements follow a few at a time
+        REQUIRE(test_sdal_56.view().size() == 1000); //Contiguous again
+        for (int i = 0; i < 1000; i++) REQUIRE(test_sdal_56.view()[i] == i);
+
+        //A const list halfway through a migration finishes it to hand out its iterators or its view
+        typedef SDAL<std::string, std::allocator<std::string>, incremental_growth> growing;
+        growing test_sdal_58(20), test_sdal_59(20);
+        events.clear();
+        test_sdal_58.on_resize(collect_resize, &events);
+        for (int i = 0; i < 21; i++) {
+            test_sdal_58.push_back(std::string(20, char('a' + i)));
+            test_sdal_59.push_back(std::string(20, char('a' + i)));
+        }
+        REQUIRE(events.size() == 1); //The 21st push started the migration and moved only the first few elements
+        growing const& test_sdal_60 = test_sdal_58;
+        int visited = 0;
+        for (growing::const_iterator it = test_sdal_60.begin(); it != test_sdal_60.end(); ++it, visited++)
+            REQUIRE(*it == std::string(20, char('a' + visited)));
+        REQUIRE(visited == 21);
+        span<const std::string> const elements = static_cast<growing const&> (test_sdal_59).view();
+        REQUIRE(elements.size() == 21);
+        for (int i = 0; i < 21; i++) REQUIRE(elements[i] == std::string(20, char('a' + i)));
+        test_sdal_58.push_back("v");
+        REQUIRE(test_sdal_58.item_at(21) == "v");
+        REQUIRE(test_sdal_58.item_at(20) == std::string(20, 'u'));
+
+        //Every operation, halfway through a migration or not, against a std::vector
+        SDAL<std::string, std::allocator<std::string>, incremental_growth> test_sdal_57(3);
+        std::vector<std::string> expected;
+        unsigned state = 2463534242u;
+        for (int i = 0; i < 4000; i++) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            std::string const element(20, char('a' + i % 26)); //Long enough to live on the heap
+            int const position = expected.empty() ? 0 : int(state / 16 % expected.size());
+            switch (state % 16) {
+                case 0: test_sdal_57.insert(element, position);
+                    expected.insert(expected.begin() + position, element);
+                    break;
+                case 1: if (!expected.empty()) {
+                        REQUIRE(test_sdal_57.remove(position) == expected[position]);
+                        expected.erase(expected.begin() + position);
+                    }
+                    break;
+                case 2: case 3: case 4: if (!expected.empty()) {
+                        REQUIRE(test_sdal_57.pop_back() == expected.back());
+                        expected.pop_back();
+                    }
+                    break;
+                case 5: if (!expected.empty()) {
+                        REQUIRE(test_sdal_57.replace(element, position) == expected[position]);
+                        expected[position] = element;
+                    }
+                    break;
+                case 6: {
+                    SDAL<std::string, std::allocator<std::string>, incremental_growth> copy(test_sdal_57);
+                    REQUIRE(copy.length() == expected.size());
+                    if (!expected.empty()) REQUIRE(copy.item_at(position) == expected[position]);
+                    break;
+                }
+                default: test_sdal_57.push_back(element);
+                    expected.push_back(element);
+            }
+            REQUIRE(test_sdal_57.length() == expected.size());
+            if (!expected.empty()) {
+                REQUIRE(test_sdal_57.item_at(position % expected.size()) == expected[position % expected.size()]);
+                REQUIRE(test_sdal_57.peek_front() == expected.front());
+            }
+        }
+        std::vector<std::string> contents;
+        test_sdal_57.copy_to(std::back_inserter(contents));
+        REQUIRE(contents == expected);
+    }
+
 }
@@ -1,5 +1,13 @@
 //Simple Singly-Linked List (SSLL)
 // - A basic implementation: whenever an item is added to the list, a new node is allocated to hold it; whenever an item is removed, the node that held it is deallocated.
+// - Nodes are allocated through the Allocator template parameter (rebound to node<E>), following std::allocator_traits.
+// - How nodes are obtained comes from the storage mode (the third template parameter). node_by_node is the behaviour above. With monotonic_arena,
+//   nodes are carved in order out of blocks of 64 to 4096 nodes that are only given back when the list is destroyed, so clear() does not free
+//   the nodes one at a time: it destroys the elements (nothing at all for trivially destructible ones) and rewinds the arena in O(1).
+// - insert_after(), emplace_after(), erase_after() and splice_after() edit the list in O(1) right after an iterator, as std::forward_list does.
+//   Splicing from another list relinks the nodes, so both lists must allocate node by node with equal allocators: nodes in the other list's arena,
+//   or from an allocator that cannot free them here, stay where they are and splice_after() throws rather than copy them.
+// - Built with COP3530_INSTRUMENT, stats() reports the links followed, the elements written and the calls to the allocator (per node, or per arena block).
 //
 // by Iago Patiño López
 // with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
@@ -7,15 +15,181 @@
 #ifndef SSLL_H
 #define SSLL_H
 
+#include <cstddef>
 #include <stdexcept>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
 #include "List.h"
 
 namespace cop3530 {
 
-    template <typename E>
-    class SSLL : public List<E> { //We need to create the list class
+    //==============================================================================
+    // storage modes
+
+    //Every node is allocated when its element is added and deallocated when it is removed.
+
+    struct node_by_node {
+    };
+
+    //Nodes come from a per-list bump arena that clear() rewinds as a whole.
+
+    struct monotonic_arena {
+    };
+
+    //How a list obtains and returns its nodes. This one asks the allocator for every node.
+
+    template <typename Node, typename NodeAllocator, typename Storage>
+    class node_storage {
+    public:
+        using node_traits = std::allocator_traits<NodeAllocator>;
+        static constexpr bool bulk_reset = false; //Whether reset() takes back every node by itself
+
+        Node *allocate(NodeAllocator& allocator) {
+            return node_traits::allocate(allocator, 1);
+        }
+
+        void deallocate(NodeAllocator& allocator, Node *t) {
+            node_traits::deallocate(allocator, t, 1);
+        }
+
+        void reset() {
+        }
+
+        void release(NodeAllocator&) {
+        }
+
+        void swap(node_storage&) {
+        }
+
+        void add_stats(list_stats&) const { //The list counts each node it allocates itself
+        }
+    };
+
+    //The arena: blocks of 64, 128, ... up to 4096 nodes, carved in order. A node removed from the list is kept for the next insertion,
+    //reset() forgets every node and starts carving the first block again, and only release() gives the blocks back to the allocator.
+
+    template <typename Node, typename NodeAllocator>
+    class node_storage<Node, NodeAllocator, monotonic_arena> {
+    public:
+        using size_t = std::size_t;
+        using node_traits = std::allocator_traits<NodeAllocator>;
+        static constexpr bool bulk_reset = true;
+
+        node_storage() : blocks(nullptr), block_count(0), block_slots(0), used_blocks(0), next_free(nullptr), block_end(nullptr), recycled(nullptr) {
+        }
+
+        node_storage(const node_storage&) = delete; //Each list has its own arena
+        node_storage & operator=(const node_storage&) = delete;
+
+        Node *allocate(NodeAllocator& allocator) {
+            if (recycled != nullptr) {
+                Node *t = recycled;
+                recycled = recycled->next;
+                return t;
+            }
+            if (next_free == block_end) next_block(allocator);
+            return next_free++;
+        }
+
+        void deallocate(NodeAllocator&, Node *t) {
+            t->next = recycled;
+            recycled = t;
+        }
+
+        void reset() { //O(1): the blocks stay allocated and are carved again from the first one
+            used_blocks = 0;
+            next_free = nullptr;
+            block_end = nullptr;
+            recycled = nullptr;
+        }
+
+        void release(NodeAllocator& allocator) { //Gives every block back. The arena must have been reset.
+            for (size_t i = 0; i < block_count; i++)
+                node_traits::deallocate(allocator, blocks[i], block_size(i));
+            COP3530_COUNT(frees, block_count);
+            if (blocks != nullptr) {
+                pointer_allocator pointers(allocator);
+                pointer_traits::deallocate(pointers, blocks, block_slots);
+                COP3530_COUNT(frees, 1);
+            }
+            blocks = nullptr;
+            block_count = 0;
+            block_slots = 0;
+            reset();
+        }
+
+        void swap(node_storage& other) {
+            std::swap(blocks, other.blocks);
+            std::swap(block_count, other.block_count);
+            std::swap(block_slots, other.block_slots);
+            std::swap(used_blocks, other.used_blocks);
+            std::swap(next_free, other.next_free);
+            std::swap(block_end, other.block_end);
+            std::swap(recycled, other.recycled);
+        }
+
+        void add_stats(list_stats& stats) const { //Adds the calls the arena made to the allocator
+#ifdef COP3530_INSTRUMENT
+            stats.allocations += instrumentation.allocations;
+            stats.frees += instrumentation.frees;
+#else
+            (void) stats;
+#endif
+        }
+
+    private:
+        using pointer_allocator = typename node_traits::template rebind_alloc<Node *>;
+        using pointer_traits = std::allocator_traits<pointer_allocator>;
+
+        static size_t block_size(size_t index) {
+            return index < 6 ? size_t(64) << index : 4096;
+        }
+
+        void next_block(NodeAllocator& allocator) { //Moves on to the next block, allocating it if the arena has never been this large
+            if (used_blocks == block_count) {
+                if (block_count == block_slots) { //The table of blocks is full, so double it
+                    pointer_allocator pointers(allocator);
+                    size_t const slots = block_slots == 0 ? 8 : block_slots * 2;
+                    Node **table = pointer_traits::allocate(pointers, slots);
+                    COP3530_COUNT(allocations, 1);
+                    for (size_t i = 0; i < block_count; i++)
+                        table[i] = blocks[i];
+                    if (blocks != nullptr) {
+                        pointer_traits::deallocate(pointers, blocks, block_slots);
+                        COP3530_COUNT(frees, 1);
+                    }
+                    blocks = table;
+                    block_slots = slots;
+                }
+                blocks[block_count] = node_traits::allocate(allocator, block_size(block_count));
+                COP3530_COUNT(allocations, 1);
+                block_count++;
+            }
+            next_free = blocks[used_blocks];
+            block_end = next_free + block_size(used_blocks);
+            used_blocks++;
+        }
+
+        Node **blocks; //Every block the arena owns, in the order they are carved
+        size_t block_count;
+        size_t block_slots; //Capacity of the blocks table
+        size_t used_blocks; //Blocks carved since the last reset
+        Node *next_free; //Next uncarved node of the current block
+        Node *block_end;
+        Node *recycled; //Nodes removed from the list since the last reset
+#ifdef COP3530_INSTRUMENT
+        list_stats instrumentation; //Only allocations and frees
+#endif
+    };
+
+    //==============================================================================
+    // SSLL
+
+    template <typename E, typename Allocator = std::allocator<E>, typename Storage = node_by_node>
+    class SSLL : public static_list<SSLL<E, Allocator, Storage>, E> { //We need to create the list class
     public:
 
         template <typename T>
@@ -34,13 +208,18 @@ namespace cop3530 {
 
         private:
             node<T>* here; //This is the pointer the the list member the iterator is pointing at
+            node<T>* const* head_link; //Only set by before_begin(), which points at no node: the list's head pointer tells it apart from end()
+            friend class SSLL; //The _after operations relink the node the iterator points at
+
+            SSLL_Iter(node<T>* start, node<T>* const* head_link) : here(start), head_link(head_link) {
+            }
 
         public:
 
-            explicit SSLL_Iter(node<T>* start = nullptr) : here(start) { //This is the explicit constructor for the iterator class. It does not allow implicit conversions or copy-initialization.
+            explicit SSLL_Iter(node<T>* start = nullptr) : here(start), head_link(nullptr) { //This is the explicit constructor for the iterator class. It does not allow implicit conversions or copy-initialization.
             }
 
-            SSLL_Iter(const SSLL_Iter& src) : here(src.here) { //This is the regular constructor for the iterator class
+            SSLL_Iter(const SSLL_Iter& src) : here(src.here), head_link(src.head_link) { //This is the regular constructor for the iterator class
             }
 
             reference operator*() const {
@@ -52,7 +231,8 @@ namespace cop3530 {
             }
 
             self_reference operator=(SSLL_Iter<T> const& src) {
-                here = SSLL_Iter(src).here;
+                here = src.here;
+                head_link = src.head_link;
                 return *this; //temporary line
             }
 
@@ -68,14 +248,14 @@ namespace cop3530 {
             } // postincrement
 
             bool operator==(SSLL_Iter<T> const& rhs) const {
-                if (here == rhs.here)
+                if (here == rhs.here && head_link == rhs.head_link)
                     return true;
                 else
                     return false;
             }
 
             bool operator!=(SSLL_Iter<T> const& rhs) const {
-                if (here != rhs.here)
+                if (here != rhs.here || head_link != rhs.head_link)
                     return true;
                 else
                     return false;
@@ -88,8 +268,11 @@ namespace cop3530 {
         using iterator = SSLL_Iter<E>; //When we use the word iterator, we mean the iterator class
         using const_iterator = SSLL_Iter<E const>;
 
+        using allocator_type = Allocator;
+
         //operations
         SSLL(); //This is the constructor method of the singly linked list
+        explicit SSLL(const Allocator& allocator); //Constructs an empty list whose nodes come from the given allocator
         SSLL(const SSLL& other); //copy constructor
         SSLL(SSLL&& other); //move constructor
         ~SSLL(); //This is the destructor method of the singly linked list
@@ -113,6 +296,10 @@ namespace cop3530 {
             if (is_empty()) throw std::runtime_error("Sorry, but the list is empty");
             return SSLL_Iter<E>(tail->next);
         }
+
+        iterator before_begin() { //The position before the first element, to pass to the _after operations (it also works on an empty list, and never equals end()). It cannot be dereferenced or incremented.
+            return SSLL_Iter<E>(nullptr, &head);
+        }
         SSLL & operator=(const SSLL & other);
         SSLL & operator=(SSLL&& other);
         void insert(E element, int); //Adds the specific element to the list at the specified position, shifting the element originally at that and those in subsequent positions one position to the "right"
@@ -130,14 +317,53 @@ namespace cop3530 {
         size_t length(void); //Returns the number of elements in the list as a size_t
         void clear(void); //removes all elements from the list
         bool contains(E element, bool (*equals_function)(const E&, const E&)); //returns true IFF at least one of the elements of the list matches the specified element
+        template <typename Predicate>
+        int find_if(Predicate predicate); //Returns the position of the first element for which predicate(element) is true, or -1 if there is none
+        bool contains(const E& element); //returns true IFF at least one of the elements of the list is == to the specified element
+        template <typename Equals>
+        bool contains(const E& element, Equals equals); //returns true IFF equals(list element, element) holds for at least one of the elements. Any callable works, and the compiler can inline it.
         void print(std::ostream& o); //If the list is empty, inserts "<empty list>" into the ostream; otherwise, inserts, enclosed in square brackets, the list's elements, separated by commas, in sequential order 
 
+        //In the style of std::forward_list: O(1) edits right after a position the caller already holds, so a filter or merge pass is a single traversal
+        iterator insert_after(iterator position, E element); //Inserts the element right after position and returns an iterator to it
+        template <typename... Args>
+        iterator emplace_after(iterator position, Args&&... args); //Same, but constructs the element in place from args
+        iterator erase_after(iterator position); //Removes the element right after position and returns an iterator to the element that followed it (or end())
+        void splice_after(iterator position, SSLL& other); //Moves every element of other, in order, right after position. other must be this list or, node by node, a list with an equal allocator.
+        void splice_after(iterator position, SSLL& other, iterator before); //Moves the element right after before (in other) right after position
+        void splice_after(iterator position, SSLL& other, iterator before_first, iterator last); //Moves the elements strictly between before_first and last (in other) right after position
+
         E * const contents(); //Allocates, initializes, and returns an array containing a copy of the list's elements in sequential order
+        template <typename OutputIt>
+        OutputIt copy_to(OutputIt out); //Writes the elements, in sequential order, through out (a caller's buffer, a back_inserter...) and returns it past the last one. Allocates nothing.
+
+        void swap(SSLL& other); //Exchanges the contents of the two lists. The allocators are exchanged too if they propagate on swap; otherwise they must compare equal.
+        allocator_type get_allocator() const; //Returns a copy of the allocator
+        list_stats stats() const; //What the list's operations have done so far. All zeros unless built with COP3530_INSTRUMENT.
 
     private:
+        using node_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<node<E> >;
+        using node_traits = std::allocator_traits<node_allocator>;
+        using storage_type = node_storage<node<E>, node_allocator, Storage>;
+
+        template <typename... Args>
+        node<E> *make_node(node<E> *next, Args&&... args); //Allocates a node and constructs the element in it from args
+        void require_splice_source(const SSLL& other) const; //Throws unless other's nodes can be relinked into this list
+        node<E> *position_node(const iterator& position) const; //The node an _after operation works right after, or nullptr for before_begin(). Throws for end(), after which nothing can go.
+        void link_after(node<E> *previous, node<E> *first, node<E> *last, size_t moved, SSLL& other); //Puts the chain first..last of moved nodes, already unlinked from other, right after previous
+        void destroy_node(node<E> *t); //Destroys the node's element and deallocates the node
+        void copy_from(const SSLL& other); //Appends copies of the other list's elements
+        void take_nodes(SSLL& other); //Takes over the other list's nodes, which must have come from an equal allocator
+
         //variables
+        node_allocator allocator;
+        storage_type storage;
         node<E> *head;
         node<E> *tail;
+        size_t count; //This is the number of nodes in the list, kept up to date by every operation so that length() does not need to traverse the list
+#ifdef COP3530_INSTRUMENT
+        list_stats instrumentation;
+#endif
     }; //End of SSLL class
 
     //============================================================================================================================================================
@@ -146,96 +372,127 @@ namespace cop3530 {
     //==============================================================================
     // ------- constructor  
 
-    template <typename E>
-    SSLL<E>::SSLL() {
+    template <typename E, typename Allocator, typename Storage>
+    SSLL<E, Allocator, Storage>::SSLL() : SSLL(Allocator()) {
+    }
+
+    template <typename E, typename Allocator, typename Storage>
+    SSLL<E, Allocator, Storage>::SSLL(const Allocator& allocator) : allocator(allocator) {
         head = nullptr;
         tail = nullptr;
+        count = 0;
     }
 
     // ------- copy constructor 
 
-    template <typename E>
-    SSLL<E>::SSLL(const SSLL& other) {
-        //First copy the head
-        head = new node<E>;
-        head->datum = other.head->datum;
-
-        //Traversal pointers
-        node<E> *new_nodes = head;
-        node<E> *old_nodes = other.head;
-
-        //Deep copy
-        while (old_nodes->next) { //While we have not finished traversing the "old" chain
-            new_nodes->next = new node<E>;
-            new_nodes = new_nodes->next;
-            old_nodes = old_nodes->next;
-            new_nodes->datum = old_nodes->datum;
-        }
-
-        //Last, copy the tail
-        tail = new_nodes;
-        tail->next = nullptr;
-
+    template <typename E, typename Allocator, typename Storage>
+    SSLL<E, Allocator, Storage>::SSLL(const SSLL& other) : SSLL(node_traits::select_on_container_copy_construction(other.allocator)) {
+        copy_from(other);
     }
 
     // ------- copy-assignment operator 
 
-    template <typename E>
-    SSLL<E> &
-    SSLL<E>::operator=(const SSLL & other) {
-        //First copy the head
-        head = new node<E>;
-        head->datum = other.head->datum;
-
-        //Traversal pointers
-        node<E> *new_nodes = head;
-        node<E> *old_nodes = other.head;
-
-        //Deep copy
-        while (old_nodes->next) { //While we have not finished traversing the "old" chain
-            new_nodes->next = new node<E>;
-            new_nodes = new_nodes->next;
-            old_nodes = old_nodes->next;
-            new_nodes->datum = old_nodes->datum;
-        }
-
-        //Last, copy the tail
-        tail = new_nodes;
-        tail->next = nullptr;
-
+    template <typename E, typename Allocator, typename Storage>
+    SSLL<E, Allocator, Storage> &
+    SSLL<E, Allocator, Storage>::operator=(const SSLL & other) {
+        if (this == &other) return *this;
+        this->clear(); //Release our own nodes, with our own allocator, before taking a copy of the other list
+        if (node_traits::propagate_on_container_copy_assignment::value && allocator != other.allocator)
+            storage.release(allocator); //The arena's blocks too, since the allocator that can free them is about to be replaced
+        assign_allocator(allocator, other.allocator, typename node_traits::propagate_on_container_copy_assignment());
+        copy_from(other);
         return *this;
 
     }
 
     // ------  move constructor
 
-    template <typename E>
-    SSLL<E>::SSLL(SSLL&& other) {
-        head = other.head;
-        tail = other.tail;
-        other.head = nullptr;
-        other.tail = nullptr;
+    template <typename E, typename Allocator, typename Storage>
+    SSLL<E, Allocator, Storage>::SSLL(SSLL&& other) : SSLL(std::move(other.allocator)) {
+        take_nodes(other);
     }
 
     // ------- move assignment operator 
 
-    template <typename E>
-    SSLL<E> &
-    SSLL<E>::operator=(SSLL&& other) {
+    template <typename E, typename Allocator, typename Storage>
+    SSLL<E, Allocator, Storage> &
+    SSLL<E, Allocator, Storage>::operator=(SSLL&& other) {
         if (this != &other) {
             this->clear();
-            head = other.head;
-            tail = other.tail;
-            other.head = nullptr;
-            other.tail = nullptr;
+            if (node_traits::propagate_on_container_move_assignment::value || allocator == other.allocator) {
+                storage.release(allocator); //We take over the other list's arena instead
+                move_allocator(allocator, other.allocator, typename node_traits::propagate_on_container_move_assignment());
+                take_nodes(other);
+            } else { //Our allocator cannot free the other list's nodes, so the elements are moved into nodes of our own
+                for (node<E> *current = other.head; current != nullptr; current = current->next)
+                    push_back(std::move(current->datum));
+                other.clear();
+            }
         }
         return *this;
     }
     // ------  destructor 
 
-    template <typename E>
-    SSLL<E>::~SSLL() {
+    template <typename E, typename Allocator, typename Storage>
+    SSLL<E, Allocator, Storage>::~SSLL() {
         clear();
+        storage.release(allocator);
+    }
+
+    //==============================================================================
+    // --------- make_node()
+
+    template <typename E, typename Allocator, typename Storage>
+    template <typename... Args>
+    node<E> *
+    SSLL<E, Allocator, Storage>::make_node(node<E> *next, Args&&... args) {
+        node<E> *t = storage.allocate(allocator);
+        COP3530_COUNT(allocations, storage_type::bulk_reset ? 0 : 1); //The arena counts its own blocks
+        try {
+            node_traits::construct(allocator, &t->datum, std::forward<Args>(args)...);
+        } catch (...) {
+            storage.deallocate(allocator, t);
+            throw;
+        }
+        t->next = next;
+        COP3530_COUNT(copies, 1);
+        return t;
+    }
+
+    //==============================================================================
+    // --------- destroy_node()
+
+    template <typename E, typename Allocator, typename Storage>
+    void
+    SSLL<E, Allocator, Storage>::destroy_node(node<E> *t) {
+        node_traits::destroy(allocator, &t->datum);
+        storage.deallocate(allocator, t);
+        COP3530_COUNT(frees, storage_type::bulk_reset ? 0 : 1);
+    }
+
+    //==============================================================================
+    // --------- copy_from()
+
+    template <typename E, typename Allocator, typename Storage>
+    void
+    SSLL<E, Allocator, Storage>::copy_from(const SSLL& other) {
+        for (node<E> *old_nodes = other.head; old_nodes != nullptr; old_nodes = old_nodes->next) //Deep copy
+            push_back(old_nodes->datum);
+    }
+
+    //==============================================================================
+    // --------- take_nodes()
+
+    template <typename E, typename Allocator, typename Storage>
+    void
+    SSLL<E, Allocator, Storage>::take_nodes(SSLL& other) {
+        head = other.head;
+        tail = other.tail;
+        count = other.count;
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.count = 0;
+        storage.swap(other.storage); //In arena mode the nodes live in the other list's blocks, so the blocks come along. Ours were empty.
     }
 
     //==============================================================================
@@ -244,14 +501,14 @@ namespace cop3530 {
     //==============================================================================
     // --------- insert()
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     void
-    SSLL<E>::insert(E element, int position) {
-        if (position > length() || position < 0)
+    SSLL<E, Allocator, Storage>::insert(E element, int position) {
+        if (position < 0 || position > count)
             throw std::runtime_error("Sorry but that position is outside the current list boundaries");
         else if (position == 0)
             push_front(element);
-        else if (position == length())
+        else if (position == count)
             push_back(element);
         else {
             node<E> *pre;
@@ -260,40 +517,179 @@ namespace cop3530 {
                 pre = cur;
                 cur = cur->next;
             }
-            node<E> *t = new node<E>; //create node to be inserted
-            t->datum = element; //assign the new node's datum
+            COP3530_COUNT(node_hops, position);
+            node<E> *t = make_node(cur, element); //create node to be inserted, linked to position+1
             pre->next = t; //link node position-1 to new node	
-            t->next = cur; //link new node to position+1 
+            count++;
+        }
+    }
+
+    //==============================================================================
+    // --------- require_splice_source()
+
+    template <typename E, typename Allocator, typename Storage>
+    void
+    SSLL<E, Allocator, Storage>::require_splice_source(const SSLL& other) const {
+        if (&other == this || (std::is_same<Storage, node_by_node>::value && allocator == other.allocator)) return;
+        throw std::runtime_error("Sorry, but only lists that allocate node by node from equal allocators can splice nodes from one another"); //An arena's nodes live in its own blocks
+    }
+
+    //==============================================================================
+    // --------- position_node()
+
+    template <typename E, typename Allocator, typename Storage>
+    node<E> *
+    SSLL<E, Allocator, Storage>::position_node(const iterator& position) const {
+        if (position.here == nullptr && position.head_link != &head) throw std::runtime_error("Sorry, but nothing can come after that position");
+        return position.here;
+    }
+
+    //==============================================================================
+    // --------- insert_after()
+
+    template <typename E, typename Allocator, typename Storage>
+    typename SSLL<E, Allocator, Storage>::iterator
+    SSLL<E, Allocator, Storage>::insert_after(iterator position, E element) {
+        return emplace_after(position, std::move(element));
+    }
+
+    //==============================================================================
+    // --------- emplace_after()
+
+    template <typename E, typename Allocator, typename Storage>
+    template <typename... Args>
+    typename SSLL<E, Allocator, Storage>::iterator
+    SSLL<E, Allocator, Storage>::emplace_after(iterator position, Args&&... args) {
+        node<E> *previous = position_node(position); //nullptr is before_begin()
+        node<E> *t = make_node(previous == nullptr ? head : previous->next, std::forward<Args>(args)...);
+        if (previous == nullptr) head = t;
+        else previous->next = t;
+        if (t->next == nullptr) tail = t; //We inserted after the tail
+        count++;
+        return iterator(t);
+    }
+
+    //==============================================================================
+    // --------- erase_after()
+
+    template <typename E, typename Allocator, typename Storage>
+    typename SSLL<E, Allocator, Storage>::iterator
+    SSLL<E, Allocator, Storage>::erase_after(iterator position) {
+        node<E> *previous = position_node(position);
+        node<E> *erased = previous == nullptr ? head : previous->next;
+        if (erased == nullptr) throw std::runtime_error("Sorry, but there is no element after that position");
+        if (previous == nullptr) head = erased->next;
+        else previous->next = erased->next;
+        if (erased == tail) tail = previous; //nullptr if the list is now empty
+        destroy_node(erased);
+        count--;
+        return iterator(previous == nullptr ? head : previous->next);
+    }
+
+    //==============================================================================
+    // --------- splice_after()
+
+    template <typename E, typename Allocator, typename Storage>
+    void
+    SSLL<E, Allocator, Storage>::splice_after(iterator position, SSLL& other) {
+        node<E> *previous = position_node(position);
+        require_splice_source(other);
+        if (&other == this || other.head == nullptr) return;
+        node<E> *first = other.head;
+        node<E> *last = other.tail;
+        size_t const moved = other.count;
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.count = 0;
+        link_after(previous, first, last, moved, other);
+    }
+
+    template <typename E, typename Allocator, typename Storage>
+    void
+    SSLL<E, Allocator, Storage>::splice_after(iterator position, SSLL& other, iterator before) {
+        node<E> *previous = position_node(position);
+        require_splice_source(other);
+        node<E> *before_node = other.position_node(before);
+        node<E> *first = before_node == nullptr ? other.head : before_node->next;
+        if (first == nullptr) throw std::runtime_error("Sorry, but there is no element after that position");
+        if (&other == this && (previous == before_node || previous == first)) return; //The element is already right after position
+        splice_after(position, other, before, iterator(first->next));
+    }
+
+    template <typename E, typename Allocator, typename Storage>
+    void
+    SSLL<E, Allocator, Storage>::splice_after(iterator position, SSLL& other, iterator before_first, iterator last) {
+        node<E> *previous = position_node(position);
+        require_splice_source(other);
+        node<E> *before = other.position_node(before_first);
+        node<E> *first = before == nullptr ? other.head : before->next;
+        if (first == last.here) return; //Nothing in between
+        node<E> *final_node = first;
+        size_t moved = 1;
+        while (final_node->next != last.here) { //Find the last node to move, counting them on the way
+            final_node = final_node->next;
+            moved++;
         }
+        COP3530_COUNT(node_hops, moved - 1);
+        if (before == nullptr) other.head = last.here;
+        else before->next = last.here;
+        if (final_node == other.tail) other.tail = before;
+        other.count -= moved;
+        link_after(previous, first, final_node, moved, other);
+    }
+
+    //==============================================================================
+    // --------- link_after()
+
+    template <typename E, typename Allocator, typename Storage>
+    void
+    SSLL<E, Allocator, Storage>::link_after(node<E> *previous, node<E> *first, node<E> *last, size_t moved, SSLL& other) {
+        last->next = previous == nullptr ? head : previous->next;
+        if (previous == nullptr) head = first;
+        else previous->next = first;
+        if (last->next == nullptr) tail = last;
+        count += moved;
     }
 
     //==============================================================================
     //-------- contents()
     
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     E * const
-    SSLL<E>::contents() {
-        size_t const len = length(); //Get the length of the list so that we can now what size array is needed
+    SSLL<E, Allocator, Storage>::contents() {
+        size_t const len = count; //Get the length of the list so that we can now what size array is needed
         E * const contents = new E[len]; //Initialize the array of contents
         node<E> *current = head;
         for (int i = 0; i < len; i++) { //This for loop fills our array with all the datums in order
             contents[i] = current->datum;
             current = current->next;
         }
+        COP3530_COUNT(node_hops, len);
         return contents;
     }
 
 
+    //==============================================================================
+    // --------- copy_to()
+
+    template <typename E, typename Allocator, typename Storage>
+    template <typename OutputIt>
+    OutputIt
+    SSLL<E, Allocator, Storage>::copy_to(OutputIt out) {
+        for (node<E> *current = head; current; current = current->next)
+            *out++ = current->datum;
+        COP3530_COUNT(node_hops, count);
+        return out;
+    }
+
     //==============================================================================
     // --------- push_back()
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     void
-    SSLL<E>::push_back(E element) {
+    SSLL<E, Allocator, Storage>::push_back(E element) {
 
-        node<E> *t = new node<E>; //Create new node to be inserted at the back
-        t->datum = element; //Assign datum to new node
-        t->next = nullptr; //The new node is the new tail and therefor must point to null
+        node<E> *t = make_node(nullptr, element); //Create new node to be inserted at the back. The new node is the new tail and therefor must point to null
 
         if (head == nullptr) { //If we have an empty list, the new node will be both the tail and the head
 
@@ -305,44 +701,46 @@ namespace cop3530 {
 
             tail = t; //t becomes the new tail
         }
+        count++;
     }
 
     //==============================================================================
     // --------- push_front()
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     void
-    SSLL<E>::push_front(E element) {
-        node<E> *t = new node<E>; //Create new node to be inserted at the front
-        t->datum = element; //Assign the right datum to the new node
-        t->next = head; //Link the new node to the previous head
+    SSLL<E, Allocator, Storage>::push_front(E element) {
+        node<E> *t = make_node(head, element); //Create new node to be inserted at the front, linked to the previous head
         if (is_empty()) tail = t;
         head = t; //Declare the new node as the new head
+        count++;
 
     }
 
     //==============================================================================
     // --------- replace() 
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     E
-    SSLL<E>::replace(E element, int position) {
-        if (position > length() - 1 || position < 0) throw std::runtime_error("Sorry but that position is outside the current list boundaries");
+    SSLL<E, Allocator, Storage>::replace(E element, int position) {
+        if (position < 0 || position >= count) throw std::runtime_error("Sorry but that position is outside the current list boundaries");
         node<E> *current = head;
         for (int i = 0; i < position; i++)
             current = current->next;
+        COP3530_COUNT(node_hops, position);
         E replaced_datum = current->datum;
         current->datum = element;
+        COP3530_COUNT(copies, 1);
         return replaced_datum;
     }
 
     //==============================================================================
     // --------- remove() 
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     E
-    SSLL<E>::remove(int position) {
-        if (position > length() - 1 || position < 0) throw std::runtime_error("Sorry but that position is outside the current list boundaries");
+    SSLL<E, Allocator, Storage>::remove(int position) {
+        if (position < 0 || position >= count) throw std::runtime_error("Sorry but that position is outside the current list boundaries");
         if (position == 0) return pop_front();
         node<E> *previous;
         node<E> *current = head;
@@ -350,9 +748,12 @@ namespace cop3530 {
             previous = current;
             current = current->next;
         }
+        COP3530_COUNT(node_hops, position);
         previous->next = current->next; //Link the node at position-1 to that at position+1
+        if (current == tail) tail = previous; //If we removed the tail, the previous node becomes the new tail
         E deleted_datum = current->datum;
-        delete current;
+        destroy_node(current);
+        count--;
         return deleted_datum;
 
 
@@ -361,15 +762,16 @@ namespace cop3530 {
     //==============================================================================
     // --------- pop_back()
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     E
-    SSLL<E>::pop_back() {
+    SSLL<E, Allocator, Storage>::pop_back() {
         if (is_empty()) throw std::runtime_error("Sorry, cannot pop an empty list");
         if (head == tail) { //If we have only one element
             E deleted = head->datum;
-            delete head;
+            destroy_node(head);
             head = nullptr;
             tail = nullptr;
+            count = 0;
             return deleted;
         }
         node<E> *current = head;
@@ -378,67 +780,72 @@ namespace cop3530 {
             previous = current;
             current = current->next;
         }
+        COP3530_COUNT(node_hops, count - 1);
         tail = previous; //Turn the node before the old tail into the new tail
         previous->next = nullptr; //Turn the node before the old tail into the new tail
         E deleted_datum = current->datum; //Save the old tail's datum so that it can be returned
-        delete current;
+        destroy_node(current);
+        count--;
         return deleted_datum;
     }
 
     //==============================================================================
     // --------- pop_front() 
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     E
-    SSLL<E>::pop_front() {
+    SSLL<E, Allocator, Storage>::pop_front() {
         if (is_empty()) throw std::runtime_error("Sorry, cannot pop an empty list");
         node<E> *t = head;
         head = head->next; //Make the second element the new head
+        if (head == nullptr) tail = nullptr; //If we popped the only element the list is now empty
         E deleted_datum = t->datum; //Save the old head's data so that it can be returned
-        delete t; //Delete the old head
+        destroy_node(t); //Delete the old head
+        count--;
         return deleted_datum;
     }
 
     //==============================================================================
     // --------- item_at() 
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     E
-    SSLL<E>::item_at(int position) {
-        if (position > length() - 1 || position < 0)
+    SSLL<E, Allocator, Storage>::item_at(int position) {
+        if (position < 0 || position >= count)
             throw std::runtime_error("Sorry but that position is outside the current list boundaries");
         node<E> *current = head;
         for (int i = 0; i < position; i++) //Iterate though the list until we reach the desired position
             current = current->next;
+        COP3530_COUNT(node_hops, position);
         return current->datum; //Return the datum at that position    
     }
 
     //==============================================================================
     // --------- peek_back()
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     E
-    SSLL<E>::peek_back() {
-        if (length() < 1) throw std::runtime_error("Sorry, the list is empty");
+    SSLL<E, Allocator, Storage>::peek_back() {
+        if (count == 0) throw std::runtime_error("Sorry, the list is empty");
         return tail->datum; //Return the tail's datum
     }
 
     //==============================================================================
     // --------- peek_front() 
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     E
-    SSLL<E>::peek_front() {
-        if (length() < 1) throw std::runtime_error("Sorry, the list is empty");
+    SSLL<E, Allocator, Storage>::peek_front() {
+        if (count == 0) throw std::runtime_error("Sorry, the list is empty");
         return head->datum; //Return the head's datum
     }
 
     //==============================================================================
     // --------- is_empty() 
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     bool
-    SSLL<E>::is_empty() {
+    SSLL<E, Allocator, Storage>::is_empty() {
         if (head == nullptr) return true; //If we don't have a head we don't have anything in the list   
         return false;
     }
@@ -446,70 +853,96 @@ namespace cop3530 {
     //==============================================================================
     // --------- is_full()
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     bool
-    SSLL<E>::is_full(void) {
+    SSLL<E, Allocator, Storage>::is_full(void) {
         return false; //This list can have an infinite amount of nodes and therefore it always returns false 
     }
 
     //==============================================================================
     // --------- length()
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     size_t
-    SSLL<E>::length() {
-        node<E> *current = head;
-        size_t count = 0;
-        if (head == nullptr) return count; //If the list is empty the count is zero
-        while (current->next != nullptr) { //If the list is not empty we will count the nodes
-            count++;
-            current = current->next;
-        }
-        return ++count;
+    SSLL<E, Allocator, Storage>::length() {
+        return count; //The count is maintained by every operation, so there is no need to traverse the list
     }
 
     //==============================================================================
     // --------- clear() 
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     void
-    SSLL<E>::clear() {
-        if (head == nullptr){
-            return;
-        }
-        node<E> *current = head;
-        node<E> *previous;
-        while (current->next != nullptr) { //This deletes every element of the list except for the tail
-            previous = current;
-            current = current->next;
-            delete previous;
+    SSLL<E, Allocator, Storage>::clear() {
+        if (!storage_type::bulk_reset) { //Node by node: every node goes back to the allocator
+            node<E> *current = head;
+            while (current != nullptr) {
+                node<E> *next = current->next;
+                destroy_node(current);
+                current = next;
+            }
+            COP3530_COUNT(node_hops, count);
+        } else if (!std::is_trivially_destructible<E>::value) { //Arena: the elements still need destroying, but the nodes go back with the reset below
+            for (node<E> *current = head; current != nullptr; current = current->next)
+                node_traits::destroy(allocator, &current->datum);
         }
-        delete current; //This deletes the tail
+        storage.reset();
         head = nullptr;
         tail = nullptr;
-
+        count = 0;
     }
 
     //==============================================================================
     // --------- contains() 
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     bool
-    SSLL<E>::contains(E element, bool (*equals_function)(const E&, const E&)) {
-        node<E> *current = head;
-        while (current != nullptr) {//This checks whether the object we are looking for is anywhere else in the list
-            if (equals_function(current->datum, element)) return true;
-            current = current->next;
-        }
-        return false;
+    SSLL<E, Allocator, Storage>::contains(E element, bool (*equals_function)(const E&, const E&)) {
+        return find_if([&](const E& datum) { return equals_function(datum, element); }) != -1;
+    }
+
+    //==============================================================================
+    // --------- find_if()
+
+    template <typename E, typename Allocator, typename Storage>
+    template <typename Predicate>
+    int
+    SSLL<E, Allocator, Storage>::find_if(Predicate predicate) {
+        int position = 0;
+        for (node<E> *current = head; current != nullptr; current = current->next, position++)
+            if (predicate(current->datum)) {
+                COP3530_COUNT(node_hops, position);
+                return position;
+            }
+        COP3530_COUNT(node_hops, count);
+        return -1;
+    }
+
+    //==============================================================================
+    // --------- contains() with ==
+
+    template <typename E, typename Allocator, typename Storage>
+    bool
+    SSLL<E, Allocator, Storage>::contains(const E& element) {
+        return find_if([&](const E& datum) { return datum == element; }) != -1;
+    }
+
+    //==============================================================================
+    // --------- contains() with any callable
+
+    template <typename E, typename Allocator, typename Storage>
+    template <typename Equals>
+    bool
+    SSLL<E, Allocator, Storage>::contains(const E& element, Equals equals) {
+        return find_if([&](const E& datum) { return equals(datum, element); }) != -1;
     }
 
     //==============================================================================
     // --------- print() 
 
-    template <typename E>
+    template <typename E, typename Allocator, typename Storage>
     void
-    SSLL<E>::print(std::ostream& o) {
+    SSLL<E, Allocator, Storage>::print(std::ostream& o) {
         if (is_empty()) {
             o << "<empty list>" << std::endl;
             return;
@@ -520,8 +953,46 @@ namespace cop3530 {
             o << t->datum << ",";
             t = t->next;
         }
+        COP3530_COUNT(node_hops, count - 1);
         o << t->datum << "]";
     }
+
+    //==============================================================================
+    // --------- swap()
+
+    template <typename E, typename Allocator, typename Storage>
+    void
+    SSLL<E, Allocator, Storage>::swap(SSLL& other) {
+        swap_allocator(allocator, other.allocator, typename node_traits::propagate_on_container_swap());
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(count, other.count);
+        storage.swap(other.storage);
+    }
+
+    //==============================================================================
+    // --------- get_allocator()
+
+    template <typename E, typename Allocator, typename Storage>
+    typename SSLL<E, Allocator, Storage>::allocator_type
+    SSLL<E, Allocator, Storage>::get_allocator() const {
+        return allocator_type(allocator);
+    }
+
+    //==============================================================================
+    // --------- stats()
+
+    template <typename E, typename Allocator, typename Storage>
+    list_stats
+    SSLL<E, Allocator, Storage>::stats() const {
+#ifdef COP3530_INSTRUMENT
+        list_stats counted = instrumentation;
+        storage.add_stats(counted);
+        return counted;
+#else
+        return list_stats();
+#endif
+    }
 }
 #endif /* SSLL_H */
 
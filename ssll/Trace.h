@@ -0,0 +1,405 @@
+//Trace
+// - Records the calls made on a List (operation, position and time) to a compact binary trace, so that production traffic can be replayed later
+//   against any of the five implementations (see bench/trace_replay.cpp).
+// - recording_list wraps a List<E> and writes one record per call through a trace_writer; trace_reader streams the records back one at a time,
+//   so a trace of millions of calls never has to fit in memory. The elements themselves are not recorded, only the shape of the traffic.
+// - latency_histogram is an HDR-style histogram of nanosecond values: 16 linear sub-buckets per power of two, so any percentile it reports is
+//   within 1/16 of the true value, in a fixed 7.6 KiB whatever the range.
+//   Passed to on_resize() with record_resize_time, it collects the wall time of an SDAL's, CBL's or CDAL's resizes.
+//
+// File format: the 8 bytes "LSTTRC1\n", the length of the list when recording started, then one record per call: the operation in one byte,
+// the position (only for insert, replace, remove and item_at) and the nanoseconds since the previous record. Numbers are LEB128 varints,
+// the position zigzag-encoded so that the out-of-range calls that threw in production replay as such.
+//
+// by Iago Patiño López
+// with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
+
+#ifndef TRACE_H
+#define TRACE_H
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <stdexcept>
+#include <utility>
+#include "List.h"
+
+namespace cop3530 {
+
+    //==============================================================================
+    // operations
+
+    enum class trace_op : unsigned char {
+        insert, push_back, push_front, replace, remove, pop_back, pop_front, item_at, peek_back, peek_front,
+        is_empty, is_full, length, clear, contains, print, contents
+    };
+
+    std::size_t const trace_op_count = 17;
+
+    inline const char *trace_op_name(trace_op op) {
+        static const char *const names[trace_op_count] = {"insert", "push_back", "push_front", "replace", "remove", "pop_back", "pop_front", "item_at",
+            "peek_back", "peek_front", "is_empty", "is_full", "length", "clear", "contains", "print", "contents"};
+        return names[std::size_t(op)];
+    }
+
+    inline bool trace_op_positional(trace_op op) { //The operations whose position is part of the record
+        return op == trace_op::insert || op == trace_op::replace || op == trace_op::remove || op == trace_op::item_at;
+    }
+
+    struct trace_record {
+        trace_op op;
+        int position; //-1 for the operations that take none
+        std::uint64_t timestamp; //Nanoseconds since the trace started
+    };
+
+    static char const trace_magic[8] = {'L', 'S', 'T', 'T', 'R', 'C', '1', '\n'};
+
+    //==============================================================================
+    // trace_writer
+
+    class trace_writer {
+    public:
+
+        explicit trace_writer(const char *path, std::size_t initial_length = 0) : file(std::fopen(path, "wb")), used(0), count(0), last(0),
+        start(std::chrono::steady_clock::now()) {
+            if (file == nullptr) throw std::runtime_error("Sorry, but the trace file could not be opened");
+            put_bytes(trace_magic, sizeof trace_magic);
+            put_varint(initial_length);
+        }
+
+        trace_writer(const trace_writer&) = delete;
+        trace_writer & operator=(const trace_writer&) = delete;
+
+        ~trace_writer() { //A write error can no longer be reported here, so call flush() first to find out about it
+            if (used != 0) std::fwrite(buffer, 1, used, file);
+            std::fclose(file);
+        }
+
+        void record(trace_op op, int position = -1) { //Timestamps the call and buffers its record
+            std::uint64_t const now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+            if (used + max_record > sizeof buffer) flush();
+            buffer[used++] = char(op);
+            if (trace_op_positional(op)) put_varint((std::uint64_t(std::int64_t(position)) << 1) ^ std::uint64_t(std::int64_t(position) >> 63)); //zigzag
+            put_varint(now - last);
+            last = now;
+            count++;
+        }
+
+        void flush() { //Writes the buffered records to the file
+            if (used != 0 && std::fwrite(buffer, 1, used, file) != used) throw std::runtime_error("Sorry, but the trace could not be written");
+            used = 0;
+            std::fflush(file);
+        }
+
+        std::uint64_t records() const { //Calls recorded so far
+            return count;
+        }
+
+    private:
+        static constexpr std::size_t max_record = 1 + 10 + 10; //The operation and two varints of at most 10 bytes each
+
+        void put_bytes(const char *bytes, std::size_t n) {
+            for (std::size_t i = 0; i < n; i++)
+                buffer[used++] = bytes[i];
+        }
+
+        void put_varint(std::uint64_t value) {
+            while (value >= 0x80) {
+                buffer[used++] = char(value | 0x80);
+                value >>= 7;
+            }
+            buffer[used++] = char(value);
+        }
+
+        std::FILE *file;
+        char buffer[65536];
+        std::size_t used; //Bytes of the buffer waiting to be written
+        std::uint64_t count;
+        std::uint64_t last; //Timestamp of the previous record
+        std::chrono::steady_clock::time_point start;
+    };
+
+    //==============================================================================
+    // trace_reader
+
+    class trace_reader {
+    public:
+
+        explicit trace_reader(const char *path) : file(std::fopen(path, "rb")), used(0), filled(0), now(0) {
+            if (file == nullptr) throw std::runtime_error("Sorry, but the trace file could not be opened");
+            for (std::size_t i = 0; i < sizeof trace_magic; i++) {
+                int c = get_byte();
+                if (c != trace_magic[i]) throw std::runtime_error("Sorry, but that is not a list trace");
+            }
+            length = get_varint();
+        }
+
+        trace_reader(const trace_reader&) = delete;
+        trace_reader & operator=(const trace_reader&) = delete;
+
+        ~trace_reader() {
+            std::fclose(file);
+        }
+
+        std::size_t initial_length() const { //The length of the list when recording started
+            return length;
+        }
+
+        bool next(trace_record& record) { //Reads the next record, or returns false at the end of the trace
+            int op = get_byte();
+            if (op < 0) return false;
+            if (std::size_t(op) >= trace_op_count) throw std::runtime_error("Sorry, but the trace is corrupt");
+            record.op = trace_op(op);
+            record.position = -1;
+            if (trace_op_positional(record.op)) {
+                std::uint64_t zigzag = get_varint();
+                record.position = int(std::int64_t(zigzag >> 1) ^ -std::int64_t(zigzag & 1));
+            }
+            now += get_varint();
+            record.timestamp = now;
+            return true;
+        }
+
+    private:
+
+        int get_byte() { //The next byte, or -1 at the end of the file
+            if (used == filled) {
+                filled = std::fread(buffer, 1, sizeof buffer, file);
+                used = 0;
+                if (filled == 0) return -1;
+            }
+            return (unsigned char) buffer[used++];
+        }
+
+        std::uint64_t get_varint() {
+            std::uint64_t value = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                int c = get_byte();
+                if (c < 0) throw std::runtime_error("Sorry, but the trace is truncated");
+                value |= std::uint64_t(c & 0x7f) << shift;
+                if ((c & 0x80) == 0) return value;
+            }
+            throw std::runtime_error("Sorry, but the trace is corrupt");
+        }
+
+        std::FILE *file;
+        char buffer[65536];
+        std::size_t used; //Bytes of the buffer already read
+        std::size_t filled; //Bytes in the buffer
+        std::size_t length;
+        std::uint64_t now; //Timestamp of the last record read
+    };
+
+    //==============================================================================
+    // recording decorator
+    // recording_list<int> wraps any List<int> (a virtual_list<SDAL<int> >, say): every call is recorded and then made on the wrapped list.
+
+    template <typename E>
+    class recording_list : public List<E> {
+    public:
+        using size_t = std::size_t;
+
+        recording_list(List<E>& list, trace_writer& trace) : list(list), trace(trace) {
+        }
+
+        void insert(E element, int position) override {
+            trace.record(trace_op::insert, position);
+            list.insert(std::move(element), position);
+        }
+
+        void push_back(E element) override {
+            trace.record(trace_op::push_back);
+            list.push_back(std::move(element));
+        }
+
+        void push_front(E element) override {
+            trace.record(trace_op::push_front);
+            list.push_front(std::move(element));
+        }
+
+        E replace(E element, int position) override {
+            trace.record(trace_op::replace, position);
+            return list.replace(std::move(element), position);
+        }
+
+        E remove(int position) override {
+            trace.record(trace_op::remove, position);
+            return list.remove(position);
+        }
+
+        E pop_back(void) override {
+            trace.record(trace_op::pop_back);
+            return list.pop_back();
+        }
+
+        E pop_front(void) override {
+            trace.record(trace_op::pop_front);
+            return list.pop_front();
+        }
+
+        E item_at(int position) override {
+            trace.record(trace_op::item_at, position);
+            return list.item_at(position);
+        }
+
+        E peek_back(void) override {
+            trace.record(trace_op::peek_back);
+            return list.peek_back();
+        }
+
+        E peek_front(void) override {
+            trace.record(trace_op::peek_front);
+            return list.peek_front();
+        }
+
+        bool is_empty(void) override {
+            trace.record(trace_op::is_empty);
+            return list.is_empty();
+        }
+
+        bool is_full(void) override {
+            trace.record(trace_op::is_full);
+            return list.is_full();
+        }
+
+        size_t length(void) override {
+            trace.record(trace_op::length);
+            return list.length();
+        }
+
+        void clear(void) override {
+            trace.record(trace_op::clear);
+            list.clear();
+        }
+
+        bool contains(E element, bool (*equals_function)(const E&, const E&)) override {
+            trace.record(trace_op::contains);
+            return list.contains(std::move(element), equals_function);
+        }
+
+        void print(std::ostream& o) override {
+            trace.record(trace_op::print);
+            list.print(o);
+        }
+
+        E * const contents() override {
+            trace.record(trace_op::contents);
+            return list.contents();
+        }
+
+    private:
+        List<E>& list;
+        trace_writer& trace;
+    };
+
+    //==============================================================================
+    // latency_histogram
+
+    class latency_histogram {
+    public:
+        static constexpr int sub_bits = 4;
+        static constexpr std::size_t sub_buckets = std::size_t(1) << sub_bits;
+        static constexpr std::size_t bucket_count = (64 - sub_bits + 1) * sub_buckets; //Enough for any 64-bit value
+
+        latency_histogram() {
+            clear();
+        }
+
+        void record(std::uint64_t value) {
+            counts[index(value)]++;
+            total++;
+            sum += double(value);
+            if (value < smallest) smallest = value;
+            if (value > largest) largest = value;
+        }
+
+        void merge(const latency_histogram& other) {
+            for (std::size_t i = 0; i < bucket_count; i++)
+                counts[i] += other.counts[i];
+            total += other.total;
+            sum += other.sum;
+            if (other.smallest < smallest) smallest = other.smallest;
+            if (other.largest > largest) largest = other.largest;
+        }
+
+        void clear() {
+            for (std::size_t i = 0; i < bucket_count; i++)
+                counts[i] = 0;
+            total = 0;
+            sum = 0;
+            smallest = UINT64_MAX;
+            largest = 0;
+        }
+
+        std::uint64_t count() const {
+            return total;
+        }
+
+        std::uint64_t min() const {
+            return total == 0 ? 0 : smallest;
+        }
+
+        std::uint64_t max() const {
+            return largest;
+        }
+
+        double mean() const {
+            return total == 0 ? 0 : sum / double(total);
+        }
+
+        std::uint64_t percentile(double p) const { //The value below which p percent of the recorded values fall (to within 1/16)
+            if (total == 0) return 0;
+            std::uint64_t rank = std::uint64_t(p / 100 * double(total) + 0.5);
+            if (rank < 1) rank = 1;
+            if (rank > total) rank = total;
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < bucket_count; i++) {
+                seen += counts[i];
+                if (seen >= rank) return highest(i) < largest ? highest(i) : largest;
+            }
+            return largest;
+        }
+
+    private:
+
+        static std::size_t index(std::uint64_t value) { //Values below 16 get a bucket each; above, 16 buckets per power of two
+            if (value < sub_buckets) return std::size_t(value);
+            int const top = 63 - leading_zeros(value);
+            int const shift = top - sub_bits;
+            return std::size_t(shift + 1) * sub_buckets + std::size_t((value >> shift) & (sub_buckets - 1));
+        }
+
+        static std::uint64_t highest(std::size_t i) { //The largest value that falls in bucket i
+            if (i < sub_buckets) return i;
+            int const shift = int(i / sub_buckets) - 1;
+            std::uint64_t const lowest = (sub_buckets + i % sub_buckets) << shift;
+            return lowest + ((std::uint64_t(1) << shift) - 1);
+        }
+
+        static int leading_zeros(std::uint64_t value) { //value is never 0 here
+#if defined(__GNUC__)
+            return __builtin_clzll(value);
+#else
+            int n = 0;
+            for (std::uint64_t bit = std::uint64_t(1) << 63; (value & bit) == 0; bit >>= 1)
+                n++;
+            return n;
+#endif
+        }
+
+        std::uint64_t counts[bucket_count];
+        std::uint64_t total;
+        double sum;
+        std::uint64_t smallest;
+        std::uint64_t largest;
+    };
+
+    //A resize_listener (see List.h) that records each resize's wall time in the latency_histogram given as context:
+    //list.on_resize(record_resize_time, &histogram)
+
+    inline void record_resize_time(const resize_event& event, void *histogram) {
+        static_cast<latency_histogram *>(histogram)->record(event.nanoseconds);
+    }
+}
+
+#endif /* TRACE_H */
@@ -0,0 +1,73 @@
+//Static vs virtual dispatch benchmark
+// - Runs the same push_back/pop_front loop on an SSLL and on a CBL three ways: on the concrete list, through the static interface (static_list),
+//   and through the virtual List interface (virtual_list). The loop also calls is_empty(), length() and peek_front() so there is something to inline.
+//
+// by Iago Patiño López
+// Build from this directory with: g++ -std=c++11 -O2 -I .. dispatch_bench.cpp -o dispatch_bench
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+//List ADTs included below:
+#include "SSLL.h"
+#include "../../cbl/CBL.h"
+
+using namespace cop3530;
+
+//The loop itself. L is the concrete list, a static_list<Derived, long> or a List<long>.
+
+template <typename L>
+long churn(L& list, int rounds, int batch) {
+    long sum = 0;
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < batch; i++)
+            list.push_back(i);
+        while (!list.is_empty()) {
+            sum += list.peek_front() + long(list.length());
+            list.pop_front();
+        }
+    }
+    return sum;
+}
+
+template <typename Derived>
+long churn_static(static_list<Derived, long>& list, int rounds, int batch) {
+    return churn(list, rounds, batch);
+}
+
+long churn_virtual(List<long>& list, int rounds, int batch) {
+    return churn(list, rounds, batch);
+}
+
+template <typename Op>
+double nanoseconds_per_op(long operations, Op op) {
+    auto start = std::chrono::steady_clock::now();
+    op();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / operations;
+}
+
+template <typename Concrete>
+void compare(const char *name, int rounds, int batch) {
+    volatile long sink = 0; //Keeps the compiler from discarding the measured calls
+    long const operations = long(rounds) * batch;
+
+    Concrete concrete;
+    double direct = nanoseconds_per_op(operations, [&]() { sink = sink + churn(concrete, rounds, batch); });
+    double statically = nanoseconds_per_op(operations, [&]() { sink = sink + churn_static(concrete, rounds, batch); });
+
+    virtual_list<Concrete> adapter;
+    List<long> * volatile hidden = &adapter; //Hides the dynamic type so the compiler cannot devirtualise the calls
+    double virtually = nanoseconds_per_op(operations, [&]() { sink = sink + churn_virtual(*hidden, rounds, batch); });
+
+    std::cout << name << "," << batch << "," << direct << "," << statically << "," << virtually << std::endl;
+}
+
+int main() {
+    std::cout << "list,batch,concrete_ns,static_ns,virtual_ns" << std::endl;
+    for (int batch = 16; batch <= 16384; batch *= 32) {
+        int const rounds = 20000000 / batch;
+        compare<SSLL<long> >("ssll", rounds, batch);
+        compare<CBL<long> >("cbl", rounds, batch);
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+//Filter pass benchmark
+// - Removes every odd element of an SSLL and a PSLL two ways: with positional remove(int), which walks from the head on every call,
+//   and with erase_after() in a single traversal. Prints the average nanoseconds per element of the list.
+//
+// by Iago Patiño López
+// Build from this directory with: g++ -std=c++11 -O2 -I .. filter_bench.cpp -o filter_bench
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+//List ADTs included below:
+#include "SSLL.h"
+#include "../../psll/PSLL.h"
+
+using namespace cop3530;
+
+template <typename List>
+void fill(List& list, int size) {
+    list.clear();
+    for (int i = 0; i < size; i++)
+        list.push_back(i);
+}
+
+template <typename List>
+void filter_by_position(List& list) {
+    int position = 0;
+    for (int i = 0, size = int(list.length()); i < size; i++) {
+        if (list.item_at(position) % 2 != 0) list.remove(position);
+        else position++;
+    }
+}
+
+template <typename List>
+void filter_after(List& list) {
+    typename List::iterator previous = list.before_begin();
+    typename List::iterator current = list.is_empty() ? previous : list.begin();
+    while (!list.is_empty() && current != list.end()) { //end() throws once the filter has removed everything, so that is checked first
+        if (*current % 2 != 0) current = list.erase_after(previous);
+        else previous = current++;
+    }
+}
+
+template <typename List, typename Filter>
+double nanoseconds_per_element(List& list, int size, int rounds, Filter filter) {
+    double total = 0;
+    for (int r = 0; r < rounds; r++) {
+        fill(list, size);
+        auto start = std::chrono::steady_clock::now();
+        filter(list);
+        total += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+    return total / (double(size) * rounds);
+}
+
+template <typename List>
+void compare(const char *name, int size) {
+    volatile std::size_t sink = 0; //Keeps the compiler from discarding the measured calls
+    List list;
+    int const rounds = 2000000 / size + 1;
+    double positional = nanoseconds_per_element(list, size, size > 10000 ? 1 : rounds, filter_by_position<List>);
+    sink = sink + list.length();
+    double after = nanoseconds_per_element(list, size, rounds, filter_after<List>);
+    sink = sink + list.length();
+    std::cout << name << "," << size << "," << positional << "," << after << std::endl;
+}
+
+int main() {
+    std::cout << "list,size,remove_ns,erase_after_ns" << std::endl;
+    for (int size = 100; size <= 100000; size *= 10) {
+        compare<SSLL<int> >("ssll", size);
+        compare<PSLL<int> >("psll", size);
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+//Simple Singly-Linked List (SSLL) benchmark
+// - Times the SSLL operations whose cost depends on how the list is bookkept.
+//
+// by Iago Patiño López
+// Build from this directory with: g++ -std=c++11 -O2 -I .. ssll_bench.cpp -o ssll_bench
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+
+//List ADTs included below:
+#include "SSLL.h"
+
+using namespace cop3530;
+
+//This walks every node like length() used to do before the list kept its own count. It is the "before" column of the benchmark.
+
+template <typename E>
+std::size_t walk_length(SSLL<E>& list) {
+    std::size_t count = 0;
+    if (list.is_empty()) return count;
+    for (typename SSLL<E>::iterator it = list.begin(); it != list.end(); ++it)
+        count++;
+    return count;
+}
+
+//Runs op() repetitions times and returns the average nanoseconds per call
+
+template <typename Op>
+double time_per_op(int repetitions, Op op) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repetitions; i++)
+        op();
+    auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / repetitions;
+}
+
+int main() {
+    std::cout << "size,walk_length_ns,length_ns,peek_back_ns,item_at_front_ns" << std::endl;
+    volatile std::size_t sink = 0; //Keeps the compiler from discarding the measured calls
+
+    for (int size = 1000; size <= 1000000; size *= 10) {
+        SSLL<int> list;
+        for (int i = 0; i < size; i++)
+            list.push_back(i);
+
+        int const repetitions = 10000000 / size;
+        double walk = time_per_op(repetitions, [&]() { sink = sink + walk_length(list); });
+        double length = time_per_op(repetitions, [&]() { sink = sink + list.length(); });
+        double peek = time_per_op(repetitions, [&]() { sink = sink + list.peek_back(); });
+        double item = time_per_op(repetitions, [&]() { sink = sink + list.item_at(1); });
+
+        std::cout << size << "," << walk << "," << length << "," << peek << "," << item << std::endl;
+    }
+    return 0;
+}
@@ -3,20 +3,26 @@
 //
 // by Iago Patiño López
 // with content from https://www.cise.ufl.edu/~dts/ as well as "Algorithms in C++ by Robert Segewick"
+#include <cstdio>
 #include <iostream>
+#include <vector>
+#include <iterator>
 #include <valarray>
 #include <string>
 #include <sstream>
+#include <type_traits>
 #define DEBUG
 
 //List ADTs included below:
 #include "SSLL.h"
+#include "Trace.h"
 
 
 
 //Catch testing file included below:
 #define CATCH_CONFIG_MAIN
 #include "catch.h"
+#include "counting_allocator.h"
 
 using namespace cop3530;
 
@@ -26,6 +32,22 @@ bool equals_function(const int& a, const int& b) {
     return a == b;
 }
 
+//The list the shared allocator checks in counting_allocator.h run on.
+
+template <typename Allocator>
+using ssll_with = SSLL<int, Allocator>;
+
+
+//Generic code written against the static interface. The calls resolve to the concrete list at compile time.
+//It empties the list from the front, which a singly linked list does in O(1) per element.
+
+template <typename Derived>
+int drain_front_sum(static_list<Derived, int>& list) {
+    int sum = 0;
+    while (!list.is_empty())
+        sum += list.pop_front();
+    return sum;
+}
 
 TEST_CASE("Testing each method of the SSLL", "[SSLL]") {
 
@@ -269,6 +291,42 @@ TEST_CASE("Testing each method of the SSLL", "[SSLL]") {
         delete test_ssll_15;
     }
 
+    SECTION("Testing length() after every kind of operation") {
+        SSLL<int> *test_ssll_34 = new SSLL<int>;
+
+        REQUIRE(test_ssll_34->length() == 0);
+        test_ssll_34->push_back(1);
+        test_ssll_34->push_front(0);
+        test_ssll_34->insert(2, 2);
+        test_ssll_34->insert(9, 1);
+        REQUIRE(test_ssll_34->length() == 4);
+        REQUIRE(test_ssll_34->remove(3) == 2); //Removing the tail must keep the tail pointer valid
+        REQUIRE(test_ssll_34->length() == 3);
+        REQUIRE(test_ssll_34->peek_back() == 1);
+        test_ssll_34->push_back(3);
+        REQUIRE(test_ssll_34->item_at(3) == 3);
+        REQUIRE(test_ssll_34->pop_back() == 3);
+        REQUIRE(test_ssll_34->pop_front() == 0);
+        REQUIRE(test_ssll_34->length() == 2);
+
+        SSLL<int> test_ssll_35(*test_ssll_34);
+        REQUIRE(test_ssll_35.length() == 2);
+        test_ssll_34->clear();
+        REQUIRE(test_ssll_34->length() == 0);
+        REQUIRE_THROWS(test_ssll_34->peek_back());
+
+        SSLL<int> test_ssll_36(*test_ssll_34); //Copying an empty list
+        REQUIRE(test_ssll_36.length() == 0);
+        test_ssll_36 = test_ssll_35;
+        REQUIRE(test_ssll_36.length() == 2);
+        REQUIRE(test_ssll_36.pop_front() == 9);
+        REQUIRE(test_ssll_36.pop_front() == 1);
+        REQUIRE(test_ssll_36.is_empty());
+        REQUIRE_THROWS(test_ssll_36.peek_front());
+
+        delete test_ssll_34;
+    }
+
     //ITERATOR TESTING
 
     SECTION("Testing begin()") {
@@ -598,4 +656,368 @@ TEST_CASE("Testing each method of the SSLL", "[SSLL]") {
         delete test_ssll_32;
     }
 
+    SECTION("Testing the allocator") {
+        require_allocator_propagation<ssll_with>();
+
+        allocation_log nodes, first, second;
+        typedef counting_allocator<int, true> propagating;
+        typedef counting_allocator<int, false> sticky;
+        {
+            SSLL<int, propagating> test_ssll_37(propagating(1, &nodes));
+            for (int i = 0; i < 10; i++) test_ssll_37.push_back(i);
+            REQUIRE(nodes.allocations == 10); //One node per element
+            REQUIRE(nodes.last_allocation == sizeof (node<int>));
+            REQUIRE(nodes.constructions == 10);
+            test_ssll_37.pop_front();
+            REQUIRE(nodes.deallocations == 1); //And it goes back as soon as the element leaves
+        }
+        REQUIRE(nodes.bytes == 0);
+
+        typedef SSLL<int, propagating, monotonic_arena> arena_list;
+        {
+            arena_list test_ssll_38(propagating(1, &first)), test_ssll_39(propagating(2, &second));
+            for (int i = 0; i < 100; i++) test_ssll_38.push_back(i);
+            REQUIRE(first.allocations == 3); //The table of blocks, then blocks of 64 and 128 nodes
+            REQUIRE(first.bytes == long(8 * sizeof (node<int> *) + (64 + 128) * sizeof (node<int>)));
+            for (int i = 0; i < 5; i++) test_ssll_39.push_back(i);
+            long const first_allocations = first.allocations;
+
+            test_ssll_38 = test_ssll_39; //The allocator is replaced, so the blocks go back to the one that allocated them
+            REQUIRE(test_ssll_38.get_allocator().id == 2);
+            REQUIRE(first.bytes == 0);
+            REQUIRE(first.deallocations == first_allocations);
+            REQUIRE(second.allocations == 4); //And the copy is carved from blocks of its new allocator
+            REQUIRE(test_ssll_38.peek_back() == 4);
+            test_ssll_38.push_back(5);
+            REQUIRE(first.allocations == first_allocations);
+        }
+        REQUIRE(second.bytes == 0);
+
+        allocation_log third;
+        {
+            SSLL<int, sticky, monotonic_arena> test_ssll_40(sticky(3, &third)), test_ssll_41(sticky(4, &third));
+            for (int i = 0; i < 100; i++) test_ssll_40.push_back(i);
+            for (int i = 0; i < 5; i++) test_ssll_41.push_back(i);
+            long const arena_bytes = third.bytes;
+            test_ssll_40 = test_ssll_41; //A sticky allocator stays, so the arena keeps its blocks and carves the copy from them
+            REQUIRE(third.bytes == arena_bytes);
+            REQUIRE(third.deallocations == 0);
+            REQUIRE(test_ssll_40.item_at(4) == 4);
+        }
+        REQUIRE(third.bytes == 0);
+    }
+
+    SECTION("Testing the monotonic arena") {
+        allocation_log log;
+        typedef counting_allocator<int, false> sticky;
+        typedef SSLL<int, sticky, monotonic_arena> arena_list;
+        {
+            arena_list *test_ssll_43 = new arena_list(sticky(1, &log));
+            for (int i = 0; i < 10000; i++) test_ssll_43->push_back(i);
+            long const arena_bytes = log.bytes;
+            REQUIRE(arena_bytes >= long(10000 * sizeof (node<int>)));
+            test_ssll_43->clear(); //The blocks are kept for the next round
+            REQUIRE(test_ssll_43->is_empty());
+            REQUIRE(log.bytes == arena_bytes);
+            for (int i = 0; i < 10000; i++) test_ssll_43->push_front(i);
+            REQUIRE(log.bytes == arena_bytes); //And carved again instead of allocating new ones
+            REQUIRE(test_ssll_43->peek_front() == 9999);
+            REQUIRE(test_ssll_43->remove(5000) == 4999);
+            test_ssll_43->insert(-1, 5000); //Removed nodes are reused too
+            REQUIRE(test_ssll_43->item_at(5000) == -1);
+            REQUIRE(log.bytes == arena_bytes);
+
+            arena_list test_ssll_44(*test_ssll_43); //A copy gets an arena of its own
+            REQUIRE(test_ssll_44.length() == 10000);
+            REQUIRE(log.bytes > arena_bytes);
+            test_ssll_44.clear();
+            REQUIRE(test_ssll_43->peek_back() == 0);
+
+            arena_list test_ssll_45(std::move(*test_ssll_43)); //A move takes the arena along with the nodes
+            REQUIRE(test_ssll_45.length() == 10000);
+            REQUIRE(test_ssll_43->is_empty());
+            test_ssll_43->push_back(1);
+            test_ssll_45.swap(*test_ssll_43);
+            REQUIRE(test_ssll_45.length() == 1);
+            REQUIRE(test_ssll_43->item_at(9999) == 0);
+            delete test_ssll_43;
+        }
+        REQUIRE(log.bytes == 0); //The blocks go back when the list is destroyed
+
+        SSLL<std::string, std::allocator<std::string>, monotonic_arena> test_ssll_46; //Elements that are not trivially destructible are destroyed by clear()
+        for (int i = 0; i < 1000; i++) test_ssll_46.push_back(std::string(40, 'a' + i % 26));
+        test_ssll_46.clear();
+        test_ssll_46.push_back("again");
+        REQUIRE(test_ssll_46.peek_front() == "again");
+    }
+
+    SECTION("Testing the static interface and the virtual adapter") {
+        REQUIRE(is_static_list<SSLL<int> >::value);
+        SSLL<int> test_ssll_47;
+        for (int i = 0; i < 100; i++) test_ssll_47.push_back(i);
+        REQUIRE(drain_front_sum(test_ssll_47) == 4950);
+        REQUIRE(test_ssll_47.is_empty());
+
+        virtual_list<SSLL<int> > test_ssll_48;
+        List<int>& dynamic = test_ssll_48; //Only the adapter is a List<int>
+        dynamic.push_back(2);
+        dynamic.push_front(0);
+        SSLL<int>& concrete = test_ssll_48.get(); //The SSLL's own members work on the list behind the adapter
+        concrete.insert_after(concrete.begin(), 1);
+        REQUIRE(dynamic.length() == 3);
+        REQUIRE(dynamic.item_at(1) == 1);
+        concrete.erase_after(concrete.before_begin());
+        std::ostringstream stream;
+        dynamic.print(stream);
+        REQUIRE(stream.str() == "[1,2]");
+        REQUIRE(drain_front_sum(concrete) == 3);
+        REQUIRE(dynamic.is_empty());
+    }
+
+    SECTION("Testing find_if and contains on recycled arena nodes") {
+        SSLL<int, std::allocator<int>, monotonic_arena> test_ssll_49; //Nodes are reused in the reverse order they were removed, so memory order is not list order
+        for (int i = 0; i < 100; i++) test_ssll_49.push_back(i);
+        for (int i = 0; i < 50; i++) test_ssll_49.pop_front();
+        for (int i = 0; i < 50; i++) test_ssll_49.push_front(-i);
+        REQUIRE(test_ssll_49.find_if([](const int& x) { return x == 0; }) == 49); //Positions follow the links
+        REQUIRE(test_ssll_49.find_if([](const int& x) { return x > 50; }) == 51);
+        int calls = 0;
+        REQUIRE(test_ssll_49.find_if([&](const int& x) { calls++; return x == -49; }) == 0);
+        REQUIRE(calls == 1); //And the walk stops at the first match
+        REQUIRE(test_ssll_49.contains(99));
+        REQUIRE(!test_ssll_49.contains(49)); //Popped, and its node now holds another element
+        REQUIRE(test_ssll_49.contains(-7, [](const int& datum, const int& element) { return datum == element; }));
+        REQUIRE(test_ssll_49.contains(50, equals_function));
+
+        test_ssll_49.clear(); //The arena is rewound, so nodes still hold old values but none is in the list
+        REQUIRE(test_ssll_49.find_if([](const int&) { return true; }) == -1);
+        REQUIRE(!test_ssll_49.contains(0));
+        test_ssll_49.push_back(7);
+        REQUIRE(test_ssll_49.find_if([](const int& x) { return x == 7; }) == 0);
+        REQUIRE(!test_ssll_49.contains(-49));
+    }
+
+    SECTION("Testing copy_to") {
+        allocation_log log;
+        typedef counting_allocator<int, false> sticky;
+        SSLL<int, sticky, monotonic_arena> test_ssll_51(sticky(1, &log));
+        int buffer[5] = {-1, -1, -1, -1, -1};
+        REQUIRE(test_ssll_51.copy_to(buffer) == buffer); //An empty list writes nothing
+        for (int i = 0; i < 100; i++) test_ssll_51.push_back(i);
+        test_ssll_51.clear(); //The arena is rewound and carved again from its first block, so the old values sit in the nodes reused
+        for (int i = 0; i < 4; i++) test_ssll_51.push_front(i * i);
+        long const allocations = log.allocations;
+        REQUIRE(test_ssll_51.copy_to(buffer) == buffer + 4);
+        REQUIRE(buffer[0] == 9); //In list order, which is not the order the nodes were carved in
+        REQUIRE(buffer[3] == 0);
+        REQUIRE(buffer[4] == -1);
+        REQUIRE(log.allocations == allocations); //Nothing is allocated
+
+        std::vector<int> appended(1, 7);
+        static_list<SSLL<int, sticky, monotonic_arena>, int>& interface = test_ssll_51;
+        interface.copy_to(std::back_inserter(appended)); //The back_inserter sees the refilled elements only
+        REQUIRE(appended.size() == 5);
+        REQUIRE(appended[0] == 7);
+        REQUIRE(appended[1] == 9);
+        REQUIRE(appended[4] == 0);
+        test_ssll_51.erase_after(test_ssll_51.begin()); //A node left for reuse is not written either
+        appended.clear();
+        test_ssll_51.copy_to(std::back_inserter(appended));
+        REQUIRE(appended == std::vector<int>({9, 1, 0}));
+    }
+
+    SECTION("Testing insert_after, emplace_after, erase_after and splice_after") {
+        SSLL<int> test_ssll_52;
+        SSLL<int>::iterator it = test_ssll_52.insert_after(test_ssll_52.before_begin(), 2); //Works on an empty list
+        it = test_ssll_52.insert_after(it, 4);
+        test_ssll_52.insert_after(test_ssll_52.before_begin(), 0);
+        test_ssll_52.push_back(6); //The tail followed the insertions
+        REQUIRE(test_ssll_52.length() == 4);
+        REQUIRE(test_ssll_52.peek_back() == 6);
+        std::ostringstream before;
+        test_ssll_52.print(before);
+        REQUIRE(before.str() == "[0,2,4,6]");
+
+        for (int i = 7; i < 20; i++) test_ssll_52.push_back(i);
+        SSLL<int>::iterator previous = test_ssll_52.before_begin(); //test_ssll_52 filter pass: drop the odd elements in one traversal
+        REQUIRE(previous != test_ssll_52.end()); //before_begin() is a position of its own
+        REQUIRE(previous == test_ssll_52.before_begin());
+        for (SSLL<int>::iterator current = test_ssll_52.begin(); current != test_ssll_52.end();) {
+            if (*current % 2 != 0) current = test_ssll_52.erase_after(previous);
+            else previous = current++;
+        }
+        REQUIRE(test_ssll_52.length() == 10);
+        REQUIRE(test_ssll_52.peek_back() == 18);
+        REQUIRE(test_ssll_52.item_at(4) == 8);
+        REQUIRE_THROWS(test_ssll_52.erase_after(previous)); //previous is the tail
+        test_ssll_52.erase_after(test_ssll_52.before_begin());
+        REQUIRE(test_ssll_52.peek_front() == 2);
+
+        SSLL<std::string> test_ssll_54;
+        SSLL<std::string>::iterator word = test_ssll_54.emplace_after(test_ssll_54.before_begin(), 3, 'x');
+        test_ssll_54.emplace_after(word, "yz");
+        REQUIRE(test_ssll_54.peek_front() == "xxx");
+        REQUIRE(test_ssll_54.peek_back() == "yz");
+        test_ssll_54.erase_after(word);
+        test_ssll_54.erase_after(test_ssll_54.before_begin());
+        REQUIRE(test_ssll_54.is_empty());
+
+        SSLL<int> test_ssll_62; //A filter pass that removes every element: end() throws on an empty list, so emptiness is checked first
+        for (int i = 0; i < 5; i++) test_ssll_62.push_back(2 * i + 1);
+        previous = test_ssll_62.before_begin();
+        SSLL<int>::iterator current = test_ssll_62.begin();
+        while (!test_ssll_62.is_empty() && current != test_ssll_62.end()) {
+            if (*current % 2 != 0) current = test_ssll_62.erase_after(previous);
+            else previous = current++;
+        }
+        REQUIRE(test_ssll_62.is_empty());
+        REQUIRE(previous == test_ssll_62.before_begin());
+        REQUIRE_THROWS(test_ssll_62.erase_after(previous));
+        REQUIRE_THROWS(test_ssll_62.insert_after(current, 1)); //current is end(), after which nothing can go
+        REQUIRE(test_ssll_62.is_empty());
+        test_ssll_62.insert_after(previous, 1);
+        test_ssll_62.push_back(3);
+        current = test_ssll_62.erase_after(test_ssll_62.begin()); //Erasing the tail returns end()
+        REQUIRE(current == test_ssll_62.end());
+        REQUIRE_THROWS(test_ssll_62.insert_after(current, 5)); //Not the front of the list
+        REQUIRE_THROWS(test_ssll_62.insert_after(test_ssll_52.before_begin(), 5)); //Nor another list's before_begin()
+        REQUIRE(test_ssll_62.length() == 1);
+        REQUIRE(test_ssll_62.peek_front() == 1);
+
+        SSLL<int> test_ssll_53;
+        for (int i = 0; i < 3; i++) test_ssll_53.push_back(100 + i);
+        int *moved = &*test_ssll_53.begin();
+        test_ssll_52.splice_after(test_ssll_52.before_begin(), test_ssll_53); //The whole list, relinked
+        REQUIRE(test_ssll_53.is_empty());
+        REQUIRE(test_ssll_52.length() == 12);
+        REQUIRE(&*test_ssll_52.begin() == moved);
+        REQUIRE(test_ssll_52.item_at(3) == 2);
+
+        test_ssll_52.splice_after(test_ssll_52.before_begin(), test_ssll_52, ++test_ssll_52.begin()); //The third element to the front, within the same list
+        REQUIRE(test_ssll_52.peek_front() == 102);
+        REQUIRE(test_ssll_52.item_at(1) == 100);
+        REQUIRE(test_ssll_52.item_at(2) == 101);
+        test_ssll_52.splice_after(test_ssll_52.begin(), test_ssll_52, test_ssll_52.begin()); //Already in place
+        REQUIRE(test_ssll_52.peek_front() == 102);
+        REQUIRE(test_ssll_52.item_at(1) == 100);
+
+        SSLL<int>::iterator third = ++++test_ssll_52.begin();
+        test_ssll_53.splice_after(test_ssll_53.before_begin(), test_ssll_52, third, test_ssll_52.end()); //Everything after the third element
+        REQUIRE(test_ssll_52.length() == 3);
+        REQUIRE(test_ssll_52.peek_back() == 101);
+        REQUIRE(test_ssll_53.length() == 9);
+        REQUIRE(test_ssll_53.peek_front() == 2);
+        REQUIRE(test_ssll_53.peek_back() == 18);
+        test_ssll_52.push_back(7);
+        test_ssll_53.push_back(8);
+        REQUIRE(test_ssll_52.item_at(3) == 7);
+        REQUIRE(test_ssll_53.item_at(9) == 8);
+
+        SSLL<int, std::allocator<int>, monotonic_arena> test_ssll_55, test_ssll_56; //Arena nodes cannot change lists, so splicing between them is refused
+        test_ssll_55.push_back(1);
+        for (int i = 0; i < 3; i++) test_ssll_56.push_back(i);
+        REQUIRE_THROWS(test_ssll_55.splice_after(test_ssll_55.before_begin(), test_ssll_56));
+        REQUIRE_THROWS(test_ssll_56.splice_after(test_ssll_56.before_begin(), test_ssll_55, test_ssll_55.before_begin()));
+        REQUIRE_THROWS(test_ssll_55.splice_after(test_ssll_55.begin(), test_ssll_56, test_ssll_56.before_begin(), test_ssll_56.end()));
+        REQUIRE(test_ssll_55.length() == 1); //Neither list was touched
+        REQUIRE(test_ssll_55.peek_back() == 1);
+        REQUIRE(test_ssll_56.length() == 3);
+        REQUIRE(test_ssll_56.item_at(2) == 2);
+        test_ssll_56.splice_after(test_ssll_56.begin(), test_ssll_56, test_ssll_56.begin(), test_ssll_56.end()); //Within one arena the nodes can still move
+        REQUIRE(test_ssll_56.length() == 3);
+        REQUIRE(test_ssll_56.peek_back() == 2);
+
+        allocation_log log;
+        SSLL<int, counting_allocator<int, false> > test_ssll_63(counting_allocator<int, false>(1, &log)), test_ssll_64(counting_allocator<int, false>(2, &log));
+        test_ssll_63.push_back(1);
+        test_ssll_64.push_back(2);
+        REQUIRE_THROWS(test_ssll_63.splice_after(test_ssll_63.before_begin(), test_ssll_64)); //Allocator 1 could not free allocator 2's nodes
+        REQUIRE(test_ssll_63.length() == 1);
+        REQUIRE(test_ssll_64.peek_front() == 2);
+        SSLL<int, counting_allocator<int, false> > test_ssll_65(counting_allocator<int, false>(2, &log));
+        test_ssll_65.splice_after(test_ssll_65.before_begin(), test_ssll_64); //An equal allocator can
+        REQUIRE(test_ssll_64.is_empty());
+        REQUIRE(test_ssll_65.peek_front() == 2);
+    }
+
+    SECTION("Testing the trace recorder, reader and latency histogram") {
+        virtual_list<SSLL<int> > test_ssll_57;
+        test_ssll_57.push_back(1);
+        {
+            trace_writer trace("ssll_test_trace.bin", test_ssll_57.length());
+            recording_list<int> recorded(test_ssll_57, trace);
+            recorded.push_back(2);
+            recorded.insert(3, 1);
+            REQUIRE(recorded.item_at(2) == 2);
+            REQUIRE_THROWS(recorded.remove(-5)); //Recorded too, so it throws again on replay
+            REQUIRE(recorded.pop_front() == 1);
+            REQUIRE(recorded.contains(3, equals_function));
+            REQUIRE(trace.records() == 6);
+        }
+        REQUIRE(test_ssll_57.length() == 2);
+
+        trace_reader reader("ssll_test_trace.bin");
+        REQUIRE(reader.initial_length() == 1);
+        trace_op const ops[] = {trace_op::push_back, trace_op::insert, trace_op::item_at, trace_op::remove, trace_op::pop_front, trace_op::contains};
+        int const positions[] = {-1, 1, 2, -5, -1, -1};
+        trace_record record;
+        std::uint64_t previous = 0;
+        for (int i = 0; i < 6; i++) {
+            REQUIRE(reader.next(record));
+            REQUIRE(record.op == ops[i]);
+            REQUIRE(record.position == positions[i]);
+            REQUIRE(record.timestamp >= previous);
+            previous = record.timestamp;
+        }
+        REQUIRE(!reader.next(record));
+        REQUIRE(std::string(trace_op_name(trace_op::pop_front)) == "pop_front");
+        std::remove("ssll_test_trace.bin");
+        REQUIRE_THROWS(trace_reader("ssll_test_no_such_trace.bin"));
+
+        latency_histogram test_ssll_58;
+        REQUIRE(test_ssll_58.percentile(99) == 0);
+        for (std::uint64_t v = 1; v <= 1000; v++) test_ssll_58.record(v);
+        REQUIRE(test_ssll_58.count() == 1000);
+        REQUIRE(test_ssll_58.min() == 1);
+        REQUIRE(test_ssll_58.max() == 1000);
+        REQUIRE(test_ssll_58.mean() == Approx(500.5));
+        REQUIRE(test_ssll_58.percentile(50) >= 500);
+        REQUIRE(test_ssll_58.percentile(50) <= 500 + 500 / 16);
+        REQUIRE(test_ssll_58.percentile(99.9) >= 999);
+        REQUIRE(test_ssll_58.percentile(100) == 1000);
+        REQUIRE(test_ssll_58.percentile(1) == 10);
+        latency_histogram test_ssll_59;
+        test_ssll_59.record(std::uint64_t(1) << 40); //A spike, far above the rest
+        test_ssll_58.merge(test_ssll_59);
+        REQUIRE(test_ssll_58.count() == 1001);
+        REQUIRE(test_ssll_58.max() == std::uint64_t(1) << 40);
+        REQUIRE(test_ssll_58.percentile(100) == std::uint64_t(1) << 40);
+        REQUIRE(test_ssll_58.percentile(99) <= 1000);
+        test_ssll_58.clear();
+        REQUIRE(test_ssll_58.count() == 0);
+    }
+
+    SECTION("Testing the instrumentation counters") {
+        SSLL<int> test_ssll_60;
+        for (int i = 0; i < 5; i++) test_ssll_60.push_back(i);
+        test_ssll_60.item_at(3);
+        test_ssll_60.remove(2);
+        test_ssll_60.contains(-1, equals_function); //Follows every link
+        list_stats counted = test_ssll_60.stats();
+        SSLL<int, std::allocator<int>, monotonic_arena> test_ssll_61;
+        for (int i = 0; i < 100; i++) test_ssll_61.push_back(i); //A block of 64 nodes and one of 128
+        list_stats arena = test_ssll_61.stats();
+#ifdef COP3530_INSTRUMENT
+        REQUIRE(counted.node_hops == 3 + 2 + 4);
+        REQUIRE(counted.copies == 5);
+        REQUIRE(counted.allocations == 5);
+        REQUIRE(counted.frees == 1);
+        REQUIRE(arena.copies == 100);
+        REQUIRE(arena.allocations == 1 + 2); //The table of blocks and the two blocks
+#else
+        REQUIRE(counted.node_hops == 0); //Not counted at all
+        REQUIRE(arena.allocations == 0);
+#endif
+    }
+
 }
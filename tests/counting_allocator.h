@@ -0,0 +1,139 @@
+//Test fixture shared by the five lists' test files: a stateful allocator that logs what a list asks of it, and the checks every allocator-aware list must pass.
+//Include it after catch.h.
+//
+// by Iago Patiño López
+
+#ifndef COUNTING_ALLOCATOR_H
+#define COUNTING_ALLOCATOR_H
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#if __cplusplus >= 201703L
+#include <memory_resource>
+#endif
+
+//What the allocators sharing one log were asked to do. Rebound copies write to the same log, so it covers every type a list allocates.
+
+struct allocation_log {
+    long bytes; //Held right now
+    long allocations; //Calls to allocate
+    long deallocations; //Calls to deallocate
+    long constructions; //Elements constructed through the allocator
+    std::size_t last_allocation; //Bytes asked for by the latest call to allocate
+
+    allocation_log() : bytes(0), allocations(0), deallocations(0), constructions(0), last_allocation(0) {
+    }
+};
+
+//Allocators with the same id compare equal; Propagate picks whether they follow the elements on copy, move and swap.
+
+template <typename T, bool Propagate>
+class counting_allocator {
+public:
+    typedef T value_type;
+    typedef std::integral_constant<bool, Propagate> propagate_on_container_copy_assignment;
+    typedef std::integral_constant<bool, Propagate> propagate_on_container_move_assignment;
+    typedef std::integral_constant<bool, Propagate> propagate_on_container_swap;
+
+    template <typename U>
+    struct rebind {
+        typedef counting_allocator<U, Propagate> other;
+    };
+
+    counting_allocator(int id, allocation_log *log) : id(id), log(log) {
+    }
+
+    template <typename U>
+    counting_allocator(const counting_allocator<U, Propagate>& other) : id(other.id), log(other.log) {
+    }
+
+    T *allocate(std::size_t n) {
+        log->bytes += n * sizeof (T);
+        log->allocations++;
+        log->last_allocation = n * sizeof (T);
+        return static_cast<T *> (::operator new(n * sizeof (T)));
+    }
+
+    void deallocate(T *p, std::size_t n) {
+        log->bytes -= n * sizeof (T);
+        log->deallocations++;
+        ::operator delete(p);
+    }
+
+    template <typename U, typename... Args>
+    void construct(U *p, Args&&... args) {
+        ::new (static_cast<void *> (p)) U(std::forward<Args>(args)...);
+        log->constructions++;
+    }
+
+    template <typename U>
+    bool operator==(const counting_allocator<U, Propagate>& other) const {
+        return id == other.id;
+    }
+
+    template <typename U>
+    bool operator!=(const counting_allocator<U, Propagate>& other) const {
+        return id != other.id;
+    }
+
+    int id;
+    allocation_log *log;
+};
+
+//The allocator rules every list follows, whatever it allocates. ListOf<Allocator> must be a list of int taking that allocator.
+//A propagating allocator follows the elements on copy, move and swap; a sticky one stays with its list; and everything goes back in the end.
+
+template <template <typename> class ListOf>
+void require_allocator_propagation() {
+    typedef counting_allocator<int, true> propagating;
+    typedef counting_allocator<int, false> sticky;
+    allocation_log log;
+    {
+        ListOf<propagating> original(propagating(1, &log));
+        for (int i = 0; i < 100; i++) original.push_back(i);
+        REQUIRE(log.bytes > 0);
+        REQUIRE(original.get_allocator().id == 1);
+
+        ListOf<propagating> copy(original); //A copy gets the allocator of the original
+        REQUIRE(copy.get_allocator().id == 1);
+        REQUIRE(copy.item_at(99) == 99);
+
+        ListOf<propagating> assigned(propagating(2, &log));
+        assigned.push_back(7);
+        assigned = original; //A propagating allocator follows the elements on copy-assignment
+        REQUIRE(assigned.get_allocator().id == 1);
+        REQUIRE(assigned.length() == 100);
+        assigned = ListOf<propagating>(propagating(3, &log)); //And on move-assignment
+        REQUIRE(assigned.get_allocator().id == 3);
+        REQUIRE(assigned.is_empty());
+        assigned.push_back(7);
+        assigned.swap(copy); //And on swap
+        REQUIRE(assigned.get_allocator().id == 1);
+        REQUIRE(assigned.length() == 100);
+        REQUIRE(copy.get_allocator().id == 3);
+        REQUIRE(copy.peek_front() == 7);
+
+        ListOf<sticky> from(sticky(4, &log)), to(sticky(5, &log));
+        for (int i = 0; i < 10; i++) from.push_back(i);
+        to = std::move(from); //A sticky allocator stays with its list, so the elements are moved over one by one
+        REQUIRE(to.get_allocator().id == 5);
+        REQUIRE(to.length() == 10);
+        REQUIRE(to.peek_back() == 9);
+        REQUIRE(from.length() == 0);
+        from = to;
+        REQUIRE(from.get_allocator().id == 4);
+        REQUIRE(from.length() == 10);
+    }
+    REQUIRE(log.bytes == 0);
+    REQUIRE(log.allocations == log.deallocations);
+#if __cplusplus >= 201703L
+    std::pmr::monotonic_buffer_resource arena;
+    ListOf<std::pmr::polymorphic_allocator<int> > unassignable{std::pmr::polymorphic_allocator<int>(&arena)}; //Allocators that cannot be assigned work too
+    for (int i = 0; i < 100; i++) unassignable.push_back(i);
+    REQUIRE(unassignable.item_at(50) == 50);
+    REQUIRE(unassignable.get_allocator().resource() == &arena);
+#endif
+}
+
+#endif /* COUNTING_ALLOCATOR_H */